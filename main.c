@@ -41,6 +41,7 @@
 *******************************************************************************/
 #include "cybsp.h"
 #include "cy_utils.h"
+#include "xmc_scheduler.h"
 
 #if (UC_FAMILY == XMC4)
 #include "xmc42_vcm_buck_single.h"
@@ -48,12 +49,36 @@
 #include "xmc13_vcm_buck_single.h"
 #endif
 
+/*******************************************************************************
+* Global Variable
+*******************************************************************************/
+/* Background scheduler, tasks run in the main context */
+XMC_SCHED_t sched;
+
+/*******************************************************************************
+* Function Name: SysTick_Handler
+********************************************************************************
+* Summary:
+* Time base of the background scheduler.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void SysTick_Handler(void)
+{
+    XMC_SCHED_Tick(&sched);
+}
+
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
 * Summary:
 * Main function performing the initialization of the peripherals, compensator,
-* and interrupt.
+* and interrupt. Afterwards it runs the background scheduler.
 *
 * Parameters:
 *  void
@@ -73,17 +98,20 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* Starting the background scheduler. */
+    XMC_SCHED_Init(&sched);
+
     /* Initializing the compensator with the values for the required regulator
     configuration. */
 #if (UC_FAMILY == XMC4)
-    xmc42_vcm_buck_single_init();
+    xmc42_vcm_buck_single_init(&sched);
 #elif (UC_FAMILY == XMC1)
-    xmc13_vcm_buck_single_init();
+    xmc13_vcm_buck_single_init(&sched);
 #endif
 
     while (1U)
     {
-        asm("NOP");
+        XMC_SCHED_RunOnce(&sched);
     }
 
     return 1;
@@ -0,0 +1,252 @@
+/******************************************************************************
+* File Name:   xmc_3p3z_factor.h
+*
+* Description: This file provides the init-time helpers that split the 3p3z
+*              transfer function into a first-order and a second-order section
+*              and into partial fractions, and that choose the scaling of the
+*              Q15 and Q31 kernels. They are used by the alternative
+*              realizations in xmc_3p3z_realization_fixed.h and
+*              xmc_3p3z_realization_float.h and by xmc_3p3z_filter_q15.h and
+*              xmc_3p3z_filter_q31.h, and are not called from the ISR.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_3P3Z_FACTOR_H
+#define XMC_3P3Z_FACTOR_H
+
+#include <math.h>
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining a cubic in z^-1 split as
+ * (1 - r z^-1) * (1 + c1 z^-1 + c0 z^-2)
+ */
+typedef struct XMC_3P3Z_FACTOR
+{
+  float               m_R;          /**< Real root of the first-order section */
+  float               m_C1;
+  float               m_C0;
+} XMC_3P3Z_FACTOR_t;
+
+/**
+ * Structure defining the partial fractions of the 3p3z transfer function
+ * D + alpha / (1 - r z^-1) + (beta0 + beta1 z^-1) / (1 + c1 z^-1 + c0 z^-2)
+ */
+typedef struct XMC_3P3Z_MODES
+{
+  float               m_D;          /**< Direct feedthrough */
+  float               m_Alpha;      /**< Residue of the real mode */
+  float               m_Beta0;
+  float               m_Beta1;
+} XMC_3P3Z_MODES_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FactorCubic
+********************************************************************************
+* Summary:
+* This function factors 1 + p1 z^-1 + p2 z^-2 + p3 z^-3 into a first-order and
+* a second-order section. Of the real roots, the one closest to target is put
+* in the first-order section, so the integrator of the denominator (target 1)
+* and the zero nearest to it (target r) end up in the same section. One real
+* root is found by bisection, the rest by deflation.
+*
+* Parameters:
+* XMC_3P3Z_FACTOR_t* [out] ptr Pointer to the factors
+* float              [in]  p1 Coefficient of z^-1
+* float              [in]  p2 Coefficient of z^-2
+* float              [in]  p3 Coefficient of z^-3
+* float              [in]  target Preferred root of the first-order section
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FactorCubic(XMC_3P3Z_FACTOR_t* ptr,
+                                          float p1,
+                                          float p2,
+                                          float p3,
+                                          float target)
+{
+  float lo, hi, mid, r, q, disc;
+  int i;
+
+  /* All roots of z^3 + p1 z^2 + p2 z + p3 are inside the Cauchy bound */
+  hi = 1.0f + fmaxf( fmaxf( fabsf(p1) , fabsf(p2) ) , fabsf(p3) );
+  lo = -hi;
+
+  for (i = 0; i < 64; i++)
+  {
+    mid = 0.5f * (lo + hi);
+    if ((((mid + p1) * mid + p2) * mid + p3) < 0.0f) lo = mid;
+    else hi = mid;
+  }
+  r = 0.5f * (lo + hi);
+
+  /* z^2 + c1 z + c0 is the cubic divided by (z - r) */
+  ptr->m_C1 = p1 + r;
+  ptr->m_C0 = p2 + (r * ptr->m_C1);
+
+  disc = (ptr->m_C1 * ptr->m_C1) - (4.0f * ptr->m_C0);
+  if (disc >= 0.0f)
+  {
+    q = 0.5f * sqrtf(disc);
+    mid = (-0.5f * ptr->m_C1) + ((target > (-0.5f * ptr->m_C1)) ? q : -q);
+    if (fabsf(mid - target) < fabsf(r - target))
+    {
+      r = mid;
+      ptr->m_C1 = p1 + r;
+      ptr->m_C0 = p2 + (r * ptr->m_C1);
+    }
+  }
+  ptr->m_R = r;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PartialFractions
+********************************************************************************
+* Summary:
+* This function expands the 3p3z transfer function in partial fractions over
+* the factored denominator. The real mode must not coincide with a root of the
+* second-order section.
+*
+* Parameters:
+* XMC_3P3Z_MODES_t*        [out] ptr Pointer to the partial fractions
+* const XMC_3P3Z_FACTOR_t* [in]  pDen Factored denominator
+* float                    [in]  cB0..cB3 Numerator, including the k factor
+* float                    [in]  cA1..cA3 Denominator coefficients
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PartialFractions(XMC_3P3Z_MODES_t* ptr,
+                                               const XMC_3P3Z_FACTOR_t* pDen,
+                                               float cB0,
+                                               float cB1,
+                                               float cB2,
+                                               float cB3,
+                                               float cA1,
+                                               float cA2,
+                                               float cA3)
+{
+  float r = pDen->m_R;
+  float r0, r1, r2;
+
+  /* Proper remainder R(z^-1) = N - D * den, of degree 2 */
+  ptr->m_D = (cA3 != 0.0f) ? (-cB3 / cA3) : 0.0f;
+  r0 = cB0 - ptr->m_D;
+  r1 = cB1 + (ptr->m_D * cA1);
+  r2 = cB2 + (ptr->m_D * cA2);
+
+  /* Residue of the real mode: R / (1 + c1 z^-1 + c0 z^-2) at z = r */
+  ptr->m_Alpha = ((r0 * r * r) + (r1 * r) + r2) /
+                 ((r * r) + (pDen->m_C1 * r) + pDen->m_C0);
+
+  /* R - alpha * (1 + c1 z^-1 + c0 z^-2) = (beta0 + beta1 z^-1) * (1 - r z^-1) */
+  ptr->m_Beta0 = r0 - ptr->m_Alpha;
+  ptr->m_Beta1 = (r1 - (ptr->m_Alpha * pDen->m_C1)) + (r * ptr->m_Beta0);
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_ScaleShift
+********************************************************************************
+* Summary:
+* This function returns the smallest s for which a block of coefficients,
+* scaled by 2^-s, fits a fractional format: every |c| is below 2^s and the sum
+* of |c| is below 2^(s+1). With inputs below 1, the sum of products of the
+* block then stays below 2 in the scaled format, so one guard bit is enough.
+*
+* Parameters:
+* const float* [in] pCoef Coefficients
+* int          [in] count Number of coefficients
+*
+* Return:
+*  int Scale shift s
+*
+*******************************************************************************/
+__STATIC_INLINE int XMC_3P3Z_ScaleShift(const float* pCoef, int count)
+{
+  float peak = 0.0f;
+  float sum = 0.0f;
+  int s = 0;
+  int i;
+
+  for (i = 0; i < count; i++)
+  {
+    peak = fmaxf( peak , fabsf(pCoef[i]) );
+    sum += fabsf(pCoef[i]);
+  }
+
+  while ((peak >= (float)(1UL << s)) || (sum >= (float)(2UL << s)))
+  {
+    s++;
+  }
+  return s;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_OutLog2
+********************************************************************************
+* Summary:
+* This function returns the smallest n with 2^n above the maximum duty. The
+* fractional kernels scale the output so that 2^n ticks is 1.
+*
+* Parameters:
+* uint32_t [in] pwmMax Maximum duty in PWM ticks
+*
+* Return:
+*  int n
+*
+*******************************************************************************/
+__STATIC_INLINE int XMC_3P3Z_OutLog2(uint32_t pwmMax)
+{
+  int n = 0;
+
+  while ((1UL << n) <= pwmMax)
+  {
+    n++;
+  }
+  return n;
+}
+
+#endif /* #ifndef XMC_3P3Z_FACTOR_H */
@@ -55,6 +55,13 @@
 /**< Fix point from float calculation macro */
 #define FIX_FROM_FLOAT( f, q ) (int)((f) * ((unsigned)1<<(q)) )
 
+/**< Anti-windup: clamp U to +/- max, the output to [min, max] (default) */
+#define XMC_3P3Z_AW_CLAMP           (0)
+/**< Anti-windup: back-calculation of U towards the output range */
+#define XMC_3P3Z_AW_BACK_CALC       (1)
+/**< Anti-windup: U is held at the limit while the error drives further into saturation */
+#define XMC_3P3Z_AW_CONDITIONAL     (2)
+
 /******************************************************************************
  * DATA STRUCTURES
  *****************************************************************************/
@@ -71,6 +78,7 @@ typedef struct XMC_3P3Z_DATA_FIXED
   int32_t             m_KpwmMin;
   int32_t             m_KpwmMax;
   int32_t             m_KpwmMaxNeg;
+  int32_t             m_KpwmMinU;   /**< m_KpwmMin in U format */
   int32_t             m_Ref;        /**< ADC reference */
   int32_t             m_B[4];
   int32_t             m_A[4];
@@ -79,6 +87,11 @@ typedef struct XMC_3P3Z_DATA_FIXED
   int                 m_AShift;
   int                 m_BShift;
   int                 m_OShift;
+  /* Anti-windup and saturation supervision, see XMC_3P3Z_InitAntiWindupFixed */
+  int                 m_AwMode;      /**< XMC_3P3Z_AW_xxx */
+  int                 m_AwShift;     /**< Back-calculation keeps 2^-shift of the excess */
+  int32_t             m_SatFlag;     /**< +1 upper, -1 lower, 0 not saturated */
+  uint32_t            m_SatCount;    /**< Number of saturated samples */
 } XMC_3P3Z_DATA_FIXED_t;
 
 /******************************************************************************
@@ -102,8 +115,8 @@ typedef struct XMC_3P3Z_DATA_FIXED
  * float                  [in]  cA3 A3 filter coefficient
  * float                  [in]  cK k factor of the filter
  * uint16_t               [in]  ref Reference value for the VADC
- * uint16_t               [in]  pwmMin 24 bit min PWM value.
- * uint16_t               [in]  pwmMax 24 bit max PWM value.
+ * uint32_t               [in]  pwmMin 24 bit min PWM value.
+ * uint32_t               [in]  pwmMax 24 bit max PWM value.
  * uint32_t*              [out] pFeedBack pointer to ADC register.
 *
 * Return:
@@ -120,8 +133,8 @@ __STATIC_INLINE void XMC_3P3Z_InitFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
                                         float cA3,
                                         float cK,
                                         uint16_t ref,
-                                        uint16_t pwmMin,
-                                        uint16_t pwmMax,
+                                        uint32_t pwmMin,
+                                        uint32_t pwmMax,
                                         volatile uint32_t* pFeedBack)
 {
   int A_iq, B_iq, U_iq;
@@ -153,12 +166,16 @@ __STATIC_INLINE void XMC_3P3Z_InitFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
 
   /*         IQ int      iQ fract    Bit size
      A         1          14          16
-     U         8          8           17
+     U         9          7           17
      ------------------------
-     sum AnUn  9          22          32       */
+     sum AnUn  10         21          32
+
+     U keeps 7 fractional bits so that sum |An|*|Un| stays inside 32 bits up
+     to the full PWM range, for sum |An| < 1.8. The filter shifts round to
+     nearest, so the coarser U does not add a truncation bias */
   A_iq = 14;
-  U_iq = 8;
-  AU_iq = 22;
+  U_iq = 7;
+  AU_iq = 21;
   ptr->m_A[3] = FIX_FROM_FLOAT(cA3,A_iq);
   ptr->m_A[2] = FIX_FROM_FLOAT(cA2,A_iq);
   ptr->m_A[1] = FIX_FROM_FLOAT(cA1,A_iq);
@@ -167,6 +184,7 @@ __STATIC_INLINE void XMC_3P3Z_InitFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
   ptr->m_KpwmMin        = pwmMin;
   ptr->m_KpwmMax        = FIX_FROM_FLOAT((pwmMax-1),U_iq);
   ptr->m_KpwmMaxNeg     = -ptr->m_KpwmMax;
+  ptr->m_KpwmMinU       = pwmMin << U_iq;
 
   /* Initializing shifting values */
   ptr->m_AShift = AU_iq - BE_iq;
@@ -174,6 +192,97 @@ __STATIC_INLINE void XMC_3P3Z_InitFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
   ptr->m_OShift = U_iq;
 }
 
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitAntiWindupFixed
+********************************************************************************
+* Summary:
+* This API selects the anti-windup policy applied when the filter output
+* saturates. It must be called after XMC_3P3Z_InitFixed, which selects
+* XMC_3P3Z_AW_CLAMP.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FIXED_t* [in/out] ptr Pointer to the filter structure
+* int                    [in]  mode XMC_3P3Z_AW_xxx
+* int                    [in]  shift Back-calculation keeps 2^-shift of the
+*                              excess over the output range in U
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitAntiWindupFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
+                                                  int mode,
+                                                  int shift)
+{
+  ptr->m_AwMode   = mode;
+  ptr->m_AwShift  = shift;
+  ptr->m_SatFlag  = 0;
+  ptr->m_SatCount = 0;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_AntiWindupFixed
+********************************************************************************
+* Summary:
+* This function saturates the filter result to the output range, updates the
+* saturation flag and counter, and returns the value to be stored in U[0]
+* according to the anti-windup policy, which also moves U[1] and U[2]. It costs
+* a few compares per sample, and two more updates in saturated samples.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FIXED_t* [in/out] ptr Pointer to the filter structure
+* int32_t                [in]  acc Unsaturated filter result in U format
+* int32_t*               [out] pSat Saturated filter result in U format
+*
+* Return:
+*  int32_t Value to be stored in U[0]
+*
+*******************************************************************************/
+__STATIC_INLINE int32_t XMC_3P3Z_AntiWindupFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
+                                                 int32_t acc,
+                                                 int32_t* pSat)
+{
+    int32_t sat;
+    int32_t u;
+    int32_t delta;
+
+    sat = MIN( acc , ptr->m_KpwmMax );
+    sat = MAX( sat , ptr->m_KpwmMinU );
+    *pSat = sat;
+
+    if (sat == acc)
+    {
+        ptr->m_SatFlag = 0;
+        return acc;
+    }
+
+    ptr->m_SatFlag = (acc > sat) ? 1 : -1;
+    ptr->m_SatCount++;
+
+    if (ptr->m_AwMode == XMC_3P3Z_AW_CONDITIONAL)
+    {
+        /* Integrate only when the error drives out of saturation */
+        u = ((ptr->m_E[0] > 0) == (acc > sat)) ? sat : acc;
+    }
+    else
+    {
+        u = (ptr->m_AwMode == XMC_3P3Z_AW_BACK_CALC) ?
+            sat + ((acc - sat) >> ptr->m_AwShift) : acc;
+    }
+
+    /* Move U[1] and U[2], which hold the previous U[0] and U[1] at this point,
+     * by the same amount as U[0]. The A coefficients sum to one, so only the
+     * integrating part of the history changes and the zeros of the design do
+     * not kick the output when it leaves the limit. */
+    delta = u - acc;
+    ptr->m_U[1] = MAX( MIN( ptr->m_U[1] + delta , ptr->m_KpwmMax ) , ptr->m_KpwmMaxNeg );
+    ptr->m_U[2] = MAX( MIN( ptr->m_U[2] + delta , ptr->m_KpwmMax ) , ptr->m_KpwmMaxNeg );
+
+    u = MIN( u , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+    return u;
+}
+
 /*******************************************************************************
 * Function Name: XMC_3P3Z_FilterFixed
 ********************************************************************************
@@ -190,13 +299,14 @@ __STATIC_INLINE void XMC_3P3Z_InitFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
 __STATIC_INLINE void XMC_3P3Z_FilterFixed( XMC_3P3Z_DATA_FIXED_t* ptr )
 {
     int32_t acc;
+    int32_t sat;
 
     /* Filter calculations */
-    /* acc (iq9.22) = An (iq-1.19) * Un (iq(8.8)*/
+    /* acc (iq10.21) = An (iq1.14) * Un (iq9.7)*/
     acc  = ptr->m_A[3]*ptr->m_U[2]; ptr->m_U[2] = ptr->m_U[1];
     acc += ptr->m_A[2]*ptr->m_U[1]; ptr->m_U[1] = ptr->m_U[0];
     acc += ptr->m_A[1]*ptr->m_U[0];
-    acc = acc >> ptr->m_AShift;  /*iq is now iq9.19*/
+    acc = (acc + (1 << (ptr->m_AShift - 1))) >> ptr->m_AShift;  /*iq is now iq10.19*/
 
     /* acc (iq12.19) = Bn (iq1.14) * En (iq(12.0)*/
     acc += ptr->m_B[3]*ptr->m_E[2]; ptr->m_E[2] = ptr->m_E[1];
@@ -205,19 +315,139 @@ __STATIC_INLINE void XMC_3P3Z_FilterFixed( XMC_3P3Z_DATA_FIXED_t* ptr )
                      ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack);
     acc += ptr->m_B[0]*ptr->m_E[0];
 
-    /*our number is now a iq12.19, but we need to store U as a iq8.8*/
-    acc = acc >> ptr->m_BShift; /*now its a iq12.8*/
+    /*our number is now a iq12.19, but we need to store U as a iq9.7*/
+    acc = (acc + (1 << (ptr->m_BShift - 1))) >> ptr->m_BShift; /*now its a iq12.7*/
 
-    /* Max/Min truncation */
-    acc = MIN( acc , ptr->m_KpwmMax );
-    acc = MAX( acc , ptr->m_KpwmMaxNeg ); /*now its a iq8.8*/
-    ptr->m_U[0] = acc;
+    /* Max/Min truncation and anti-windup */
+    ptr->m_U[0] = XMC_3P3Z_AntiWindupFixed(ptr, acc, &sat);
 
-    acc = acc >> ptr->m_OShift; /*now its a iq8.0*/
-    if ( acc < ptr->m_KpwmMin) acc = ptr->m_KpwmMin;
+    /*Filter Output*/
+    ptr->m_pOut = (sat + (1 << (ptr->m_OShift - 1))) >> ptr->m_OShift; /*now its a iq9.0*/
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterFixedPrepare
+********************************************************************************
+* Summary:
+* This function performs the first part of XMC_3P3Z_FilterFixed: the sum of
+* the output history, which does not depend on the new sample. Together with
+* XMC_3P3Z_FilterFixedComplete, it lets a decimated loop spread the filter
+* over two control ISRs.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FIXED_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterFixedPrepare( XMC_3P3Z_DATA_FIXED_t* ptr )
+{
+    int32_t acc;
+
+    /* acc (iq10.21) = An (iq1.14) * Un (iq9.7)*/
+    acc  = ptr->m_A[3]*ptr->m_U[2]; ptr->m_U[2] = ptr->m_U[1];
+    acc += ptr->m_A[2]*ptr->m_U[1]; ptr->m_U[1] = ptr->m_U[0];
+    acc += ptr->m_A[1]*ptr->m_U[0];
+    ptr->m_Acc = (acc + (1 << (ptr->m_AShift - 1))) >> ptr->m_AShift;  /*iq is now iq10.19*/
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterFixedComplete
+********************************************************************************
+* Summary:
+* This function performs the second part of XMC_3P3Z_FilterFixed on the
+* latest sample: the sum of the error history, the anti-windup and the output.
+* It must follow XMC_3P3Z_FilterFixedPrepare.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FIXED_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterFixedComplete( XMC_3P3Z_DATA_FIXED_t* ptr )
+{
+    int32_t acc;
+    int32_t sat;
+
+    /* acc (iq12.19) = Bn (iq1.14) * En (iq(12.0)*/
+    acc  = ptr->m_Acc;
+    acc += ptr->m_B[3]*ptr->m_E[2]; ptr->m_E[2] = ptr->m_E[1];
+    acc += ptr->m_B[2]*ptr->m_E[1]; ptr->m_E[1] = ptr->m_E[0];
+    acc += ptr->m_B[1]*ptr->m_E[0]; ptr->m_E[0] =
+                     ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack);
+    acc += ptr->m_B[0]*ptr->m_E[0];
+
+    acc = (acc + (1 << (ptr->m_BShift - 1))) >> ptr->m_BShift; /*now its a iq12.7*/
+
+    /* Max/Min truncation and anti-windup */
+    ptr->m_U[0] = XMC_3P3Z_AntiWindupFixed(ptr, acc, &sat);
 
     /*Filter Output*/
-    ptr->m_pOut = acc;
+    ptr->m_pOut = (sat + (1 << (ptr->m_OShift - 1))) >> ptr->m_OShift; /*now its a iq9.0*/
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetFixed
+********************************************************************************
+* Summary:
+* This function loads the filter history with a steady state: the output
+* history with a duty value and the error history with the latest error. As
+* the filter has an integrator, the next output continues from this duty, so
+* the hand-over to the linear loop is bumpless.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FIXED_t* [in/out] ptr Pointer to the filter structure
+* int32_t                [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetFixed(XMC_3P3Z_DATA_FIXED_t* ptr, int32_t duty)
+{
+    int32_t u;
+
+    u = duty << ptr->m_OShift; /*iq9.7*/
+    u = MIN( u , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+
+    ptr->m_U[0] = u;
+    ptr->m_U[1] = u;
+    ptr->m_U[2] = u;
+    ptr->m_E[1] = ptr->m_E[0];
+    ptr->m_E[2] = ptr->m_E[0];
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_UpdateFixed
+********************************************************************************
+* Summary:
+* This function copies the coefficients, the reference and the output limits
+* from a structure filled by XMC_3P3Z_InitFixed, and keeps the history. It is
+* called from the control ISR before the filter, so a new parameter set takes
+* effect at a sample boundary.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FIXED_t*       [in/out] ptr Pointer to the filter structure
+* const XMC_3P3Z_DATA_FIXED_t* [in]  pNew Structure with the new parameters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_UpdateFixed(XMC_3P3Z_DATA_FIXED_t* ptr,
+                                          const XMC_3P3Z_DATA_FIXED_t* pNew)
+{
+    memcpy(ptr->m_B, pNew->m_B, sizeof(ptr->m_B));
+    memcpy(ptr->m_A, pNew->m_A, sizeof(ptr->m_A));
+    ptr->m_Ref        = pNew->m_Ref;
+    ptr->m_KpwmMin    = pNew->m_KpwmMin;
+    ptr->m_KpwmMax    = pNew->m_KpwmMax;
+    ptr->m_KpwmMaxNeg = pNew->m_KpwmMaxNeg;
+    ptr->m_KpwmMinU   = pNew->m_KpwmMinU;
 }
 
 #endif /* #ifndef XMC_3P3Z_FILTER_FIXED_H */
@@ -52,6 +52,13 @@
 /**< Maximum value  calculation macro */
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
 
+/**< Anti-windup: clamp U to +/- max, the output to [min, max] (default) */
+#define XMC_3P3Z_AW_CLAMP           (0)
+/**< Anti-windup: back-calculation of U towards the output range */
+#define XMC_3P3Z_AW_BACK_CALC       (1)
+/**< Anti-windup: U is held at the limit while the error drives further into saturation */
+#define XMC_3P3Z_AW_CONDITIONAL     (2)
+
 /******************************************************************************
 * DATA STRUCTURES
 ******************************************************************************/
@@ -73,6 +80,12 @@ typedef struct XMC_3P3Z_DATA_FLOAT
   float               m_K;
   float               m_Min;
   float               m_Max;
+  float               m_Acc;          /* output history sum, see XMC_3P3Z_FilterFloatPrepare */
+  /* Anti-windup and saturation supervision, see XMC_3P3Z_InitAntiWindupFloat */
+  int                 m_AwMode;       /* XMC_3P3Z_AW_xxx */
+  float               m_AwGain;       /* back-calculation tracking gain, 0..1 */
+  int32_t             m_SatFlag;      /* +1 upper, -1 lower, 0 not saturated */
+  uint32_t            m_SatCount;     /* number of saturated samples */
 } XMC_3P3Z_DATA_FLOAT_t;
 
 /*******************************************************************************
@@ -137,6 +150,97 @@ __STATIC_INLINE void XMC_3P3Z_InitFloat(XMC_3P3Z_DATA_FLOAT_t* ptr,
   ptr->m_Max        = pwmMax;
 }
 
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitAntiWindupFloat
+********************************************************************************
+* Summary:
+* This API selects the anti-windup policy applied when the filter output
+* saturates. It must be called after XMC_3P3Z_InitFloat, which selects
+* XMC_3P3Z_AW_CLAMP.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FLOAT_t* [in/out] ptr Pointer to the filter structure
+* int                    [in]  mode XMC_3P3Z_AW_xxx
+* float                  [in]  gain Back-calculation tracking gain, 1 removes
+*                              the whole excess over the output range from U
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitAntiWindupFloat(XMC_3P3Z_DATA_FLOAT_t* ptr,
+                                                  int mode,
+                                                  float gain)
+{
+  ptr->m_AwMode   = mode;
+  ptr->m_AwGain   = gain;
+  ptr->m_SatFlag  = 0;
+  ptr->m_SatCount = 0;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_AntiWindupFloat
+********************************************************************************
+* Summary:
+* This function saturates the filter result to the output range, updates the
+* saturation flag and counter, and returns the value to be stored in U[0]
+* according to the anti-windup policy, which also moves U[1] and U[2]. It costs
+* a few compares per sample, and two more updates in saturated samples.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FLOAT_t* [in/out] ptr Pointer to the filter structure
+* float                  [in]  acc Unsaturated filter result
+* float*                 [out] pSat Saturated filter result
+*
+* Return:
+*  float Value to be stored in U[0]
+*
+*******************************************************************************/
+__STATIC_INLINE float XMC_3P3Z_AntiWindupFloat(XMC_3P3Z_DATA_FLOAT_t* ptr,
+                                               float acc,
+                                               float* pSat)
+{
+  float sat;
+  float u;
+  float delta;
+
+  sat = MIN( acc , ptr->m_Max );
+  sat = MAX( sat , ptr->m_Min );
+  *pSat = sat;
+
+  if (sat == acc)
+  {
+    ptr->m_SatFlag = 0;
+    return acc;
+  }
+
+  ptr->m_SatFlag = (acc > sat) ? 1 : -1;
+  ptr->m_SatCount++;
+
+  if (ptr->m_AwMode == XMC_3P3Z_AW_CONDITIONAL)
+  {
+    /* Integrate only when the error drives out of saturation */
+    u = ((ptr->m_E[0] > 0.0f) == (acc > sat)) ? sat : acc;
+  }
+  else
+  {
+    u = (ptr->m_AwMode == XMC_3P3Z_AW_BACK_CALC) ?
+        acc - (ptr->m_AwGain * (acc - sat)) : acc;
+  }
+
+  /* Move U[1] and U[2], which hold the previous U[0] and U[1] at this point,
+   * by the same amount as U[0]. The A coefficients sum to one, so only the
+   * integrating part of the history changes and the zeros of the design do
+   * not kick the output when it leaves the limit. */
+  delta = u - acc;
+  ptr->m_U[1] += delta;
+  ptr->m_U[2] += delta;
+
+  u = MIN( u , ptr->m_Max );
+  u = MAX( u , -ptr->m_Max );
+  return u;
+}
+
 /*******************************************************************************
 * Function Name: XMC_3P3Z_InitFloat
 ********************************************************************************
@@ -153,6 +257,7 @@ __STATIC_INLINE void XMC_3P3Z_InitFloat(XMC_3P3Z_DATA_FLOAT_t* ptr,
 __STATIC_INLINE void XMC_3P3Z_FilterFloat(XMC_3P3Z_DATA_FLOAT_t* ptr )
 {
   float acc;
+  float sat;
 
   /* Filter calculations */
   acc = ptr->m_B3*ptr->m_E[2]; ptr->m_E[2] = ptr->m_E[1];
@@ -164,14 +269,132 @@ __STATIC_INLINE void XMC_3P3Z_FilterFloat(XMC_3P3Z_DATA_FLOAT_t* ptr )
   acc += ptr->m_A2*ptr->m_U[1]; ptr->m_U[1] = ptr->m_U[0];
   acc += ptr->m_A1*ptr->m_U[0];
 
-  /* Max/Min truncation */
-  acc = MIN( acc , ptr->m_Max );
-  acc = MAX( acc , -ptr->m_Max );
-  ptr->m_U[0] = acc;
-  if ( acc < ptr->m_Min) acc = ptr->m_Min;
+  /* Max/Min truncation and anti-windup */
+  ptr->m_U[0] = XMC_3P3Z_AntiWindupFloat(ptr, acc, &sat);
+
+  /*Filter Output*/
+  ptr->m_Out = (uint32_t)sat;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterFloatPrepare
+********************************************************************************
+* Summary:
+* This function performs the first part of XMC_3P3Z_FilterFloat: the sum of
+* the output history, which does not depend on the new sample. Together with
+* XMC_3P3Z_FilterFloatComplete, it lets a decimated loop spread the filter
+* over two control ISRs.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FLOAT_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterFloatPrepare(XMC_3P3Z_DATA_FLOAT_t* ptr )
+{
+  float acc;
+
+  acc  = ptr->m_A3*ptr->m_U[2]; ptr->m_U[2] = ptr->m_U[1];
+  acc += ptr->m_A2*ptr->m_U[1]; ptr->m_U[1] = ptr->m_U[0];
+  acc += ptr->m_A1*ptr->m_U[0];
+  ptr->m_Acc = acc;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterFloatComplete
+********************************************************************************
+* Summary:
+* This function performs the second part of XMC_3P3Z_FilterFloat on the
+* latest sample: the sum of the error history, the anti-windup and the output.
+* It must follow XMC_3P3Z_FilterFloatPrepare.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FLOAT_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterFloatComplete(XMC_3P3Z_DATA_FLOAT_t* ptr )
+{
+  float acc;
+  float sat;
+
+  acc  = ptr->m_Acc;
+  acc += ptr->m_B3*ptr->m_E[2]; ptr->m_E[2] = ptr->m_E[1];
+  acc += ptr->m_B2*ptr->m_E[1]; ptr->m_E[1] = ptr->m_E[0];
+  acc += ptr->m_B1*ptr->m_E[0]; ptr->m_E[0] = (float)(ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack));
+  acc += ptr->m_B0*ptr->m_E[0];
+
+  /* Max/Min truncation and anti-windup */
+  ptr->m_U[0] = XMC_3P3Z_AntiWindupFloat(ptr, acc, &sat);
 
   /*Filter Output*/
-  ptr->m_Out = (uint32_t)acc;
+  ptr->m_Out = (uint32_t)sat;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetFloat
+********************************************************************************
+* Summary:
+* This function loads the filter history with a steady state: the output
+* history with a duty value and the error history with the latest error. As
+* the filter has an integrator, the next output continues from this duty, so
+* the hand-over to the linear loop is bumpless.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FLOAT_t* [in/out] ptr Pointer to the filter structure
+* float                  [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetFloat(XMC_3P3Z_DATA_FLOAT_t* ptr, float duty)
+{
+  duty = MIN( duty , ptr->m_Max );
+  duty = MAX( duty , -ptr->m_Max );
+
+  ptr->m_U[0] = duty;
+  ptr->m_U[1] = duty;
+  ptr->m_U[2] = duty;
+  ptr->m_E[1] = ptr->m_E[0];
+  ptr->m_E[2] = ptr->m_E[0];
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_UpdateFloat
+********************************************************************************
+* Summary:
+* This function copies the coefficients, the reference and the output limits
+* from a structure filled by XMC_3P3Z_InitFloat, and keeps the history. It is
+* called from the control ISR before the filter, so a new parameter set takes
+* effect at a sample boundary.
+*
+* Parameters:
+* XMC_3P3Z_DATA_FLOAT_t*       [in/out] ptr Pointer to the filter structure
+* const XMC_3P3Z_DATA_FLOAT_t* [in]  pNew Structure with the new parameters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_UpdateFloat(XMC_3P3Z_DATA_FLOAT_t* ptr,
+                                          const XMC_3P3Z_DATA_FLOAT_t* pNew)
+{
+  ptr->m_A1  = pNew->m_A1;
+  ptr->m_A2  = pNew->m_A2;
+  ptr->m_A3  = pNew->m_A3;
+  ptr->m_B0  = pNew->m_B0;
+  ptr->m_B1  = pNew->m_B1;
+  ptr->m_B2  = pNew->m_B2;
+  ptr->m_B3  = pNew->m_B3;
+  ptr->m_K   = pNew->m_K;
+  ptr->m_Ref = pNew->m_Ref;
+  ptr->m_Min = pNew->m_Min;
+  ptr->m_Max = pNew->m_Max;
 }
 
 #endif /* #ifndef XMC_3P3Z_FILTER_H */
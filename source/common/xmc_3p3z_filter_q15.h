@@ -0,0 +1,253 @@
+/******************************************************************************
+* File Name:   xmc_3p3z_filter_q15.h
+*
+* Description: This file provides the 3 poles 3 zeros filter in Q15: 16-bit
+*              coefficients and history with 32-bit sums, the format of the
+*              Cortex-M0 16x16 multiply and of the Cortex-M4 dual multiply
+*              instructions. The error is scaled so that the ADC full scale is
+*              1, and the output so that the next power of two above the
+*              maximum duty is 1. The A and B coefficients are scaled by powers
+*              of two chosen at init, so any design fits without overflow.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_3P3Z_FILTER_Q15_H
+#define XMC_3P3Z_FILTER_Q15_H
+
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_factor.h"
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+/**< Error scale, a 12 bit ADC full scale is 1 in iq.15 */
+#define XMC_3P3Z_Q15_E_SCALE        (8)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the Q15 filter. E and U are iq.15, the A coefficients
+ * iq(15-s) and the B coefficients, including K and the scaling of E and U,
+ * iq(15-t), with s and t from XMC_3P3Z_ScaleShift.
+ */
+typedef struct XMC_3P3Z_DATA_Q15
+{
+  /**< pointer to ADC register which is used for feedback */
+  volatile uint32_t*  m_pFeedBack;
+  uint32_t            m_pOut;
+  int32_t             m_Ref;        /**< ADC reference */
+  int16_t             m_B[4];
+  int16_t             m_A[3];
+  int16_t             m_E[3];
+  int16_t             m_U[3];
+  int16_t             m_UMin;       /**< Minimum duty in U format */
+  int16_t             m_UMax;       /**< Maximum duty in U format */
+  int16_t             m_UMaxNeg;
+  int                 m_AShift;     /**< Sum of An*Un to U format, 15-s */
+  int                 m_BShift;     /**< Sum of Bn*En to U format, 15-t */
+  int                 m_OutLog2;    /**< U of 1 is 2^m_OutLog2 ticks */
+} XMC_3P3Z_DATA_Q15_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitQ15
+********************************************************************************
+* Summary:
+* This API uses the raw coefficients for the filter and fills the Q15 filter
+* structure. The parameters are the ones of XMC_3P3Z_InitFixed. The maximum
+* duty must be below 2^17 ticks.
+*
+* Parameters:
+ * XMC_3P3Z_DATA_Q15_t* [out] ptr Pointer to the filter structure
+ * float                [in]  cB0..cB3 B filter coefficients
+ * float                [in]  cA1..cA3 A filter coefficients
+ * float                [in]  cK k factor of the filter
+ * uint16_t             [in]  ref Reference value for the VADC
+ * uint32_t             [in]  pwmMin 24 bit min PWM value.
+ * uint32_t             [in]  pwmMax 24 bit max PWM value.
+ * uint32_t*            [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitQ15(XMC_3P3Z_DATA_Q15_t* ptr,
+                                      float cB0,
+                                      float cB1,
+                                      float cB2,
+                                      float cB3,
+                                      float cA1,
+                                      float cA2,
+                                      float cA3,
+                                      float cK,
+                                      uint16_t ref,
+                                      uint32_t pwmMin,
+                                      uint32_t pwmMax,
+                                      volatile uint32_t* pFeedBack)
+{
+  float a[3];
+  float b[4];
+  float scale;
+  int s, t;
+
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+  ptr->m_OutLog2    = XMC_3P3Z_OutLog2(pwmMax);
+
+  /* U = E * B * K in ticks becomes U = E * B * K * 2^12 / 2^OutLog2 in the
+     scaled formats */
+  scale = cK * 4096.0f / (float)(1UL << ptr->m_OutLog2);
+  b[0] = cB0*scale;
+  b[1] = cB1*scale;
+  b[2] = cB2*scale;
+  b[3] = cB3*scale;
+  a[0] = cA1;
+  a[1] = cA2;
+  a[2] = cA3;
+
+  /*         IQ int      iQ fract    Bit size
+     A         s+1        15-s        16
+     U         1          15          16
+     ------------------------
+     sum AnUn  s+2        30-s        32, as |sum| < 2^(s+1)
+
+     B and E in the same way with t, and both sums are shifted to iq.15 */
+  s = XMC_3P3Z_ScaleShift(a, 3);
+  t = XMC_3P3Z_ScaleShift(b, 4);
+
+  ptr->m_A[0] = FIX_FROM_FLOAT(a[0],15-s);
+  ptr->m_A[1] = FIX_FROM_FLOAT(a[1],15-s);
+  ptr->m_A[2] = FIX_FROM_FLOAT(a[2],15-s);
+  ptr->m_B[0] = FIX_FROM_FLOAT(b[0],15-t);
+  ptr->m_B[1] = FIX_FROM_FLOAT(b[1],15-t);
+  ptr->m_B[2] = FIX_FROM_FLOAT(b[2],15-t);
+  ptr->m_B[3] = FIX_FROM_FLOAT(b[3],15-t);
+  ptr->m_AShift = 15 - s;
+  ptr->m_BShift = 15 - t;
+
+  /* Initializing maximum and minimum PWM value */
+  ptr->m_UMin    = (int16_t)(((uint64_t)pwmMin << 15) >> ptr->m_OutLog2);
+  ptr->m_UMax    = (int16_t)(((uint64_t)pwmMax << 15) >> ptr->m_OutLog2);
+  ptr->m_UMaxNeg = -ptr->m_UMax;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterQ15
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering in Q15. Both sums are rounded to
+* the U format separately, and U is clamped to +/- max, as XMC_3P3Z_AW_CLAMP
+* does in XMC_3P3Z_FilterFixed.
+*
+* Parameters:
+* XMC_3P3Z_DATA_Q15_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterQ15( XMC_3P3Z_DATA_Q15_t* ptr )
+{
+    int32_t accA;
+    int32_t accB;
+    int32_t u;
+    int32_t sat;
+
+    /* accA (iq.30-s) = An (iq.15-s) * Un (iq.15) */
+    accA  = ptr->m_A[2]*ptr->m_U[2]; ptr->m_U[2] = ptr->m_U[1];
+    accA += ptr->m_A[1]*ptr->m_U[1]; ptr->m_U[1] = ptr->m_U[0];
+    accA += ptr->m_A[0]*ptr->m_U[0];
+
+    /* accB (iq.30-t) = Bn (iq.15-t) * En (iq.15) */
+    accB  = ptr->m_B[3]*ptr->m_E[2]; ptr->m_E[2] = ptr->m_E[1];
+    accB += ptr->m_B[2]*ptr->m_E[1]; ptr->m_E[1] = ptr->m_E[0];
+    accB += ptr->m_B[1]*ptr->m_E[0]; ptr->m_E[0] = (int16_t)
+                     ((ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack)) * XMC_3P3Z_Q15_E_SCALE);
+    accB += ptr->m_B[0]*ptr->m_E[0];
+
+    /* Both sums rounded to iq.15, a truncation bias would be integrated */
+    u  = (accA + (1 << (ptr->m_AShift - 1))) >> ptr->m_AShift;
+    u += (accB + (1 << (ptr->m_BShift - 1))) >> ptr->m_BShift;
+
+    /* Max/Min truncation */
+    sat = MIN( u , ptr->m_UMax );
+    sat = MAX( sat , ptr->m_UMin );
+    u   = MIN( u , ptr->m_UMax );
+    u   = MAX( u , ptr->m_UMaxNeg );
+    ptr->m_U[0] = (int16_t)u;
+
+    /*Filter Output*/
+    ptr->m_pOut = ((uint32_t)sat << ptr->m_OutLog2) >> 15;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetQ15
+********************************************************************************
+* Summary:
+* This function loads the history with the steady state for a duty value and
+* the latest error, as XMC_3P3Z_PresetFixed does.
+*
+* Parameters:
+* XMC_3P3Z_DATA_Q15_t* [in/out] ptr Pointer to the filter structure
+* int32_t              [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetQ15(XMC_3P3Z_DATA_Q15_t* ptr, int32_t duty)
+{
+  int32_t u;
+
+  u = (int32_t)(((int64_t)duty * 32768) >> ptr->m_OutLog2);
+  u = MIN( u , ptr->m_UMax );
+  u = MAX( u , ptr->m_UMaxNeg );
+
+  ptr->m_U[0] = (int16_t)u;
+  ptr->m_U[1] = (int16_t)u;
+  ptr->m_U[2] = (int16_t)u;
+  ptr->m_E[1] = ptr->m_E[0];
+  ptr->m_E[2] = ptr->m_E[0];
+}
+
+#endif /* #ifndef XMC_3P3Z_FILTER_Q15_H */
@@ -0,0 +1,575 @@
+/******************************************************************************
+* File Name:   xmc_3p3z_realization_fixed.h
+*
+* Description: This file provides alternative realizations of the 3 poles
+*              3 zeros filter using fixed values: transposed direct form II,
+*              a biquad cascaded with a first-order section, and a modal
+*              state-space form. They are built from the same coefficients as
+*              XMC_3P3Z_InitFixed and have the same transfer function.
+*
+*              The Q formats of the cascade and state-space forms are chosen
+*              for the XMC1300 design, where the compensator gain is below 1
+*              and the real pole is the integrator. Other designs must check
+*              the headroom noted at each structure.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_3P3Z_REALIZATION_FIXED_H
+#define XMC_3P3Z_REALIZATION_FIXED_H
+
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_factor.h"
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the transposed direct form II filter. B, A and U use the
+ * formats of XMC_3P3Z_DATA_FIXED_t, the state is iq12.19.
+ */
+typedef struct XMC_3P3Z_TDF2_FIXED
+{
+  /**< pointer to ADC register which is used for feedback */
+  volatile uint32_t*  m_pFeedBack;
+  uint32_t            m_pOut;
+  int32_t             m_KpwmMin;
+  int32_t             m_KpwmMax;
+  int32_t             m_KpwmMaxNeg;
+  int32_t             m_KpwmMinU;   /**< m_KpwmMin in U format */
+  int32_t             m_Ref;        /**< ADC reference */
+  int32_t             m_B[4];
+  int32_t             m_A[4];
+  int32_t             m_S[3];
+  int32_t             m_E;          /**< Latest error */
+  int                 m_AShift;
+  int                 m_BShift;
+  int                 m_OShift;
+} XMC_3P3Z_TDF2_FIXED_t;
+
+/**
+ * Structure defining the biquad cascaded with a first-order section holding
+ * the real pole closest to the integrator. The biquad runs on E in iq.4 with
+ * iq1.14 coefficients and an iq.18 state; |N|, |C| < 1 and a biquad gain
+ * below 2 keep it inside 32 bits. The first-order state is iq12.19.
+ */
+typedef struct XMC_3P3Z_CASCADE_FIXED
+{
+  /**< pointer to ADC register which is used for feedback */
+  volatile uint32_t*  m_pFeedBack;
+  uint32_t            m_pOut;
+  int32_t             m_KpwmMin;
+  int32_t             m_KpwmMax;
+  int32_t             m_KpwmMaxNeg;
+  int32_t             m_KpwmMinU;   /**< m_KpwmMin in U format */
+  int32_t             m_Ref;        /**< ADC reference */
+  int32_t             m_N1;         /**< Biquad (1 + N1 z^-1 + N2 z^-2) / (1 + C1 z^-1 + C0 z^-2) */
+  int32_t             m_N2;
+  int32_t             m_C1;
+  int32_t             m_C0;
+  int32_t             m_T[2];       /**< Biquad state */
+  int32_t             m_Gdc;        /**< Biquad DC gain */
+  int32_t             m_G;          /**< First-order section G * (1 - q z^-1) / (1 - R z^-1) */
+  int32_t             m_Gi;         /**< G * (R - q), iq.19 */
+  int32_t             m_Rm1;        /**< R - 1 */
+  int32_t             m_I;          /**< First-order section state */
+  int32_t             m_VPrev;      /**< Previous biquad output */
+  int32_t             m_E;          /**< Latest error */
+} XMC_3P3Z_CASCADE_FIXED_t;
+
+/**
+ * Structure defining the modal state-space filter: one real mode and a
+ * second-order block in parallel with a direct feedthrough. The modes are
+ * summed in iq.16; |D|, |Beta| < 4 and a real mode near 1 keep them inside
+ * 32 bits.
+ */
+typedef struct XMC_3P3Z_SS_FIXED
+{
+  /**< pointer to ADC register which is used for feedback */
+  volatile uint32_t*  m_pFeedBack;
+  uint32_t            m_pOut;
+  int32_t             m_KpwmMin;
+  int32_t             m_KpwmMax;
+  int32_t             m_KpwmMaxNeg;
+  int32_t             m_KpwmMinU;   /**< m_KpwmMin in U format */
+  int32_t             m_Ref;        /**< ADC reference */
+  int32_t             m_D;          /**< Direct feedthrough */
+  int32_t             m_Alpha;      /**< Real mode Alpha / (1 - R z^-1), iq.24 */
+  int32_t             m_Rm1;        /**< R - 1 */
+  int32_t             m_Beta0;      /**< Block (Beta0 + Beta1 z^-1) / (1 + C1 z^-1 + C0 z^-2) */
+  int32_t             m_Beta1;
+  int32_t             m_C1;
+  int32_t             m_C0;
+  int32_t             m_G2dc;       /**< Block DC gain */
+  int32_t             m_X;          /**< Real mode state */
+  int32_t             m_P[2];       /**< Block state */
+  int32_t             m_E;          /**< Latest error */
+} XMC_3P3Z_SS_FIXED_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitTdf2Fixed
+********************************************************************************
+* Summary:
+* This API uses the raw coefficients for the filter and fills the transposed
+* direct form II structure. The parameters are the ones of XMC_3P3Z_InitFixed.
+*
+* Parameters:
+ * XMC_3P3Z_TDF2_FIXED_t* [out] ptr Pointer to the filter structure
+ * float                  [in]  cB0..cB3 B filter coefficients
+ * float                  [in]  cA1..cA3 A filter coefficients
+ * float                  [in]  cK k factor of the filter
+ * uint16_t               [in]  ref Reference value for the VADC
+ * uint16_t               [in]  pwmMin 24 bit min PWM value.
+ * uint16_t               [in]  pwmMax 24 bit max PWM value.
+ * uint32_t*              [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitTdf2Fixed(XMC_3P3Z_TDF2_FIXED_t* ptr,
+                                            float cB0,
+                                            float cB1,
+                                            float cB2,
+                                            float cB3,
+                                            float cA1,
+                                            float cA2,
+                                            float cA3,
+                                            float cK,
+                                            uint16_t ref,
+                                            uint16_t pwmMin,
+                                            uint16_t pwmMax,
+                                            volatile uint32_t* pFeedBack)
+{
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+
+  /* Same formats as XMC_3P3Z_InitFixed: B iq1.19, A iq1.14, U iq9.7 and the
+     sums in iq12.19 */
+  ptr->m_B[3] = FIX_FROM_FLOAT(cB3*cK,19);
+  ptr->m_B[2] = FIX_FROM_FLOAT(cB2*cK,19);
+  ptr->m_B[1] = FIX_FROM_FLOAT(cB1*cK,19);
+  ptr->m_B[0] = FIX_FROM_FLOAT(cB0*cK,19);
+  ptr->m_A[3] = FIX_FROM_FLOAT(cA3,14);
+  ptr->m_A[2] = FIX_FROM_FLOAT(cA2,14);
+  ptr->m_A[1] = FIX_FROM_FLOAT(cA1,14);
+
+  ptr->m_KpwmMin        = pwmMin;
+  ptr->m_KpwmMax        = FIX_FROM_FLOAT((pwmMax-1),7);
+  ptr->m_KpwmMaxNeg     = -ptr->m_KpwmMax;
+  ptr->m_KpwmMinU       = pwmMin << 7;
+
+  ptr->m_AShift = 21 - 19;
+  ptr->m_BShift = 19 - 7;
+  ptr->m_OShift = 7;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterTdf2Fixed
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering in transposed direct form II.
+* There are three state words and no history moves. The state is updated with
+* the output clamped to +/- max, as XMC_3P3Z_AW_CLAMP does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_TDF2_FIXED_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterTdf2Fixed( XMC_3P3Z_TDF2_FIXED_t* ptr )
+{
+    int32_t e;
+    int32_t u;
+
+    e = ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack);
+    ptr->m_E = e;
+
+    /* u (iq9.7) = (B0 (iq1.19) * E (iq12.0) + S0 (iq12.19)) >> 12, rounded
+       because a truncation bias is integrated into a steady-state error */
+    u = (ptr->m_B[0]*e + ptr->m_S[0] + (1 << (ptr->m_BShift - 1))) >> ptr->m_BShift;
+    u = MIN( u , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+
+    /* An (iq1.14) * u (iq9.7) is iq10.21, shifted to iq10.19 */
+    ptr->m_S[0] = ptr->m_B[1]*e + ((ptr->m_A[1]*u) >> ptr->m_AShift) + ptr->m_S[1];
+    ptr->m_S[1] = ptr->m_B[2]*e + ((ptr->m_A[2]*u) >> ptr->m_AShift) + ptr->m_S[2];
+    ptr->m_S[2] = ptr->m_B[3]*e + ((ptr->m_A[3]*u) >> ptr->m_AShift);
+
+    /*Filter Output*/
+    ptr->m_pOut = MAX( u , ptr->m_KpwmMinU ) >> ptr->m_OShift;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetTdf2Fixed
+********************************************************************************
+* Summary:
+* This function loads the state with the steady state for a duty value and the
+* latest error, as XMC_3P3Z_PresetFixed does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_TDF2_FIXED_t* [in/out] ptr Pointer to the filter structure
+* int32_t                [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetTdf2Fixed(XMC_3P3Z_TDF2_FIXED_t* ptr, int32_t duty)
+{
+    int32_t e = ptr->m_E;
+    int32_t u;
+
+    u = duty << ptr->m_OShift; /*iq9.7*/
+    u = MIN( u , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+
+    ptr->m_S[2] = ptr->m_B[3]*e + ((ptr->m_A[3]*u) >> ptr->m_AShift);
+    ptr->m_S[1] = ptr->m_B[2]*e + ((ptr->m_A[2]*u) >> ptr->m_AShift) + ptr->m_S[2];
+    ptr->m_S[0] = ptr->m_B[1]*e + ((ptr->m_A[1]*u) >> ptr->m_AShift) + ptr->m_S[1];
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitCascadeFixed
+********************************************************************************
+* Summary:
+* This API factors the filter into a biquad followed by a first-order section
+* and fills the cascade structure. The real pole closest to 1 and the zero
+* closest to it go to the first-order section, the remaining poles and zeros
+* to the biquad. The parameters are the ones of XMC_3P3Z_InitFixed; cB0 must
+* not be 0.
+*
+* Parameters:
+ * XMC_3P3Z_CASCADE_FIXED_t* [out] ptr Pointer to the filter structure
+ * float                     [in]  cB0..cB3 B filter coefficients
+ * float                     [in]  cA1..cA3 A filter coefficients
+ * float                     [in]  cK k factor of the filter
+ * uint16_t                  [in]  ref Reference value for the VADC
+ * uint16_t                  [in]  pwmMin 24 bit min PWM value.
+ * uint16_t                  [in]  pwmMax 24 bit max PWM value.
+ * uint32_t*                 [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitCascadeFixed(XMC_3P3Z_CASCADE_FIXED_t* ptr,
+                                               float cB0,
+                                               float cB1,
+                                               float cB2,
+                                               float cB3,
+                                               float cA1,
+                                               float cA2,
+                                               float cA3,
+                                               float cK,
+                                               uint16_t ref,
+                                               uint16_t pwmMin,
+                                               uint16_t pwmMax,
+                                               volatile uint32_t* pFeedBack)
+{
+  XMC_3P3Z_FACTOR_t den;
+  XMC_3P3Z_FACTOR_t num;
+
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+
+  XMC_3P3Z_FactorCubic(&den, -cA1, -cA2, -cA3, 1.0f);
+  XMC_3P3Z_FactorCubic(&num, cB1/cB0, cB2/cB0, cB3/cB0, den.m_R);
+
+  /*          IQ int      iQ fract    Bit size
+     N, C      1          14          16
+     E, V      13         4           17
+     ------------------------
+     T         14         18          32       */
+  ptr->m_N1  = FIX_FROM_FLOAT(num.m_C1,14);
+  ptr->m_N2  = FIX_FROM_FLOAT(num.m_C0,14);
+  ptr->m_C1  = FIX_FROM_FLOAT(den.m_C1,14);
+  ptr->m_C0  = FIX_FROM_FLOAT(den.m_C0,14);
+  ptr->m_Gdc = FIX_FROM_FLOAT((1.0f + num.m_C1 + num.m_C0) /
+                              (1.0f + den.m_C1 + den.m_C0),14);
+
+  /*          IQ int      iQ fract    Bit size
+     G, R-1    1          14          16
+     Gi        -8         19          11
+     I         12         19          32       */
+  ptr->m_G   = FIX_FROM_FLOAT(cB0*cK,14);
+  ptr->m_Gi  = FIX_FROM_FLOAT(cB0*cK*(den.m_R - num.m_R),19);
+  ptr->m_Rm1 = FIX_FROM_FLOAT(den.m_R - 1.0f,14);
+
+  ptr->m_KpwmMin        = pwmMin;
+  ptr->m_KpwmMax        = FIX_FROM_FLOAT((pwmMax-1),7);
+  ptr->m_KpwmMaxNeg     = -ptr->m_KpwmMax;
+  ptr->m_KpwmMinU       = pwmMin << 7;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterCascadeFixed
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering as a biquad in transposed direct
+* form II followed by the first-order section, written as
+* G * v + I with I = R * I + G * (R - q) * v[n-1]. The first-order state is
+* corrected so the output it produces is clamped to +/- max.
+*
+* Parameters:
+* XMC_3P3Z_CASCADE_FIXED_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterCascadeFixed( XMC_3P3Z_CASCADE_FIXED_t* ptr )
+{
+    int32_t e;
+    int32_t v;
+    int32_t acc;
+    int32_t u;
+
+    e = ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack);
+    ptr->m_E = e;
+    e = e << 4; /*iq12.4*/
+
+    /* Biquad, v (iq.4) rounded from iq.18 */
+    v = ((e << 14) + ptr->m_T[0] + (1 << 13)) >> 14;
+    ptr->m_T[0] = ptr->m_N1*e - ptr->m_C1*v + ptr->m_T[1];
+    ptr->m_T[1] = ptr->m_N2*e - ptr->m_C0*v;
+
+    /* First-order section: (R-1) (iq1.14) * I (iq.7) is iq.21, Gi (iq.19) * v
+       (iq.4) is iq.23, both shifted to iq.19 */
+    ptr->m_I += ((ptr->m_Rm1*(ptr->m_I >> 12)) >> 2) + ((ptr->m_Gi*ptr->m_VPrev) >> 4);
+    ptr->m_VPrev = v;
+
+    /* G (iq1.14) * v (iq.4) is iq.18 */
+    acc = (((ptr->m_G*v) << 1) + ptr->m_I) >> 12; /*iq9.7*/
+    u = MIN( acc , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+    ptr->m_I += (u - acc) << 12;
+
+    /*Filter Output*/
+    ptr->m_pOut = MAX( u , ptr->m_KpwmMinU ) >> 7;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetCascadeFixed
+********************************************************************************
+* Summary:
+* This function loads the state with the steady state for a duty value and the
+* latest error, as XMC_3P3Z_PresetFixed does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_CASCADE_FIXED_t* [in/out] ptr Pointer to the filter structure
+* int32_t                   [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetCascadeFixed(XMC_3P3Z_CASCADE_FIXED_t* ptr, int32_t duty)
+{
+    int32_t e = ptr->m_E << 4;
+    int32_t v = (ptr->m_Gdc*e) >> 14;
+    int32_t u;
+
+    u = duty << 7; /*iq9.7*/
+    u = MIN( u , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+
+    ptr->m_T[1] = ptr->m_N2*e - ptr->m_C0*v;
+    ptr->m_T[0] = ptr->m_N1*e - ptr->m_C1*v + ptr->m_T[1];
+    ptr->m_VPrev = v;
+    ptr->m_I = (u << 12) - ((ptr->m_G*v) << 1);
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitStateSpaceFixed
+********************************************************************************
+* Summary:
+* This API expands the filter in partial fractions and fills the modal
+* state-space structure. The real pole closest to 1 becomes the real mode. The
+* parameters are the ones of XMC_3P3Z_InitFixed.
+*
+* Parameters:
+ * XMC_3P3Z_SS_FIXED_t* [out] ptr Pointer to the filter structure
+ * float                [in]  cB0..cB3 B filter coefficients
+ * float                [in]  cA1..cA3 A filter coefficients
+ * float                [in]  cK k factor of the filter
+ * uint16_t             [in]  ref Reference value for the VADC
+ * uint16_t             [in]  pwmMin 24 bit min PWM value.
+ * uint16_t             [in]  pwmMax 24 bit max PWM value.
+ * uint32_t*            [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitStateSpaceFixed(XMC_3P3Z_SS_FIXED_t* ptr,
+                                                  float cB0,
+                                                  float cB1,
+                                                  float cB2,
+                                                  float cB3,
+                                                  float cA1,
+                                                  float cA2,
+                                                  float cA3,
+                                                  float cK,
+                                                  uint16_t ref,
+                                                  uint16_t pwmMin,
+                                                  uint16_t pwmMax,
+                                                  volatile uint32_t* pFeedBack)
+{
+  XMC_3P3Z_FACTOR_t den;
+  XMC_3P3Z_MODES_t modes;
+
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+
+  XMC_3P3Z_FactorCubic(&den, -cA1, -cA2, -cA3, 1.0f);
+  XMC_3P3Z_PartialFractions(&modes, &den,
+                            cB0*cK, cB1*cK, cB2*cK, cB3*cK, cA1, cA2, cA3);
+
+  /*          IQ int      iQ fract    Bit size
+     D, Beta   3          14          18
+     C, R-1    1          14          16
+     Alpha     -6         24          19
+     E         12         0           13
+     ------------------------
+     X, P, sum 15         16          32       */
+  ptr->m_D     = FIX_FROM_FLOAT(modes.m_D,14);
+  ptr->m_Alpha = FIX_FROM_FLOAT(modes.m_Alpha,24);
+  ptr->m_Rm1   = FIX_FROM_FLOAT(den.m_R - 1.0f,14);
+  ptr->m_Beta0 = FIX_FROM_FLOAT(modes.m_Beta0,14);
+  ptr->m_Beta1 = FIX_FROM_FLOAT(modes.m_Beta1,14);
+  ptr->m_C1    = FIX_FROM_FLOAT(den.m_C1,14);
+  ptr->m_C0    = FIX_FROM_FLOAT(den.m_C0,14);
+  ptr->m_G2dc  = FIX_FROM_FLOAT((modes.m_Beta0 + modes.m_Beta1) /
+                                (1.0f + den.m_C1 + den.m_C0),14);
+
+  ptr->m_KpwmMin        = pwmMin;
+  ptr->m_KpwmMax        = FIX_FROM_FLOAT((pwmMax-1),7);
+  ptr->m_KpwmMaxNeg     = -ptr->m_KpwmMax;
+  ptr->m_KpwmMinU       = pwmMin << 7;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterStateSpaceFixed
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering in modal state-space form: the
+* real mode, the second-order block in transposed direct form II and the
+* direct feedthrough are summed. The block feeds back its output in iq.4. The
+* real mode state is corrected so the output it produces is clamped to
+* +/- max.
+*
+* Parameters:
+* XMC_3P3Z_SS_FIXED_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterStateSpaceFixed( XMC_3P3Z_SS_FIXED_t* ptr )
+{
+    int32_t e;
+    int32_t y2;
+    int32_t y2q;
+    int32_t acc;
+    int32_t u;
+
+    e = ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack);
+    ptr->m_E = e;
+
+    /* Real mode: (R-1) (iq1.14) * X (iq.4) is iq.18, Alpha (iq.24) * E is
+       iq.24, both shifted to iq.16 */
+    ptr->m_X += ((ptr->m_Rm1*(ptr->m_X >> 12)) >> 2) + ((ptr->m_Alpha*e) >> 8);
+
+    /* Second-order block, Beta (iq.14) * E is iq.14, C (iq1.14) * y2 (iq.4)
+       is iq.18 */
+    y2  = ((ptr->m_Beta0*e) << 2) + ptr->m_P[0];
+    y2q = y2 >> 12;
+    ptr->m_P[0] = ((ptr->m_Beta1*e) << 2) - ((ptr->m_C1*y2q) >> 2) + ptr->m_P[1];
+    ptr->m_P[1] = -((ptr->m_C0*y2q) >> 2);
+
+    acc = (((ptr->m_D*e) << 2) + ptr->m_X + y2) >> 9; /*iq9.7*/
+    u = MIN( acc , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+    ptr->m_X += (u - acc) << 9;
+
+    /*Filter Output*/
+    ptr->m_pOut = MAX( u , ptr->m_KpwmMinU ) >> 7;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetStateSpaceFixed
+********************************************************************************
+* Summary:
+* This function loads the state with the steady state for a duty value and the
+* latest error, as XMC_3P3Z_PresetFixed does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_SS_FIXED_t* [in/out] ptr Pointer to the filter structure
+* int32_t              [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetStateSpaceFixed(XMC_3P3Z_SS_FIXED_t* ptr, int32_t duty)
+{
+    int32_t e = ptr->m_E;
+    int32_t y2 = (ptr->m_G2dc*e) << 2;
+    int32_t u;
+
+    u = duty << 7; /*iq9.7*/
+    u = MIN( u , ptr->m_KpwmMax );
+    u = MAX( u , ptr->m_KpwmMaxNeg );
+
+    ptr->m_P[1] = -((ptr->m_C0*(y2 >> 12)) >> 2);
+    ptr->m_P[0] = ((ptr->m_Beta1*e) << 2) - ((ptr->m_C1*(y2 >> 12)) >> 2) + ptr->m_P[1];
+    ptr->m_X = (u << 9) - ((ptr->m_D*e) << 2) - y2;
+}
+
+#endif /* #ifndef XMC_3P3Z_REALIZATION_FIXED_H */
@@ -0,0 +1,496 @@
+/******************************************************************************
+* File Name:   xmc_3p3z_realization_float.h
+*
+* Description: This file provides alternative realizations of the 3 poles
+*              3 zeros filter using float values: transposed direct form II,
+*              a biquad cascaded with a first-order section, and a modal
+*              state-space form. They are built from the same coefficients as
+*              XMC_3P3Z_InitFloat and have the same transfer function.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_3P3Z_REALIZATION_FLOAT_H
+#define XMC_3P3Z_REALIZATION_FLOAT_H
+
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_3p3z_factor.h"
+
+/******************************************************************************
+* DATA STRUCTURES
+******************************************************************************/
+/* Structure defining the transposed direct form II filter */
+typedef struct XMC_3P3Z_TDF2_FLOAT
+{
+  volatile uint32_t*  m_pFeedBack;    /* pointer to ADC register which is used for feedback */
+  uint32_t            m_Out;          /* 24 bit integer (16 bit low resolution + 8 bit high resolution) */
+  uint16_t            m_Ref;          /* ADC reference */
+  float               m_B[4];         /* B0..B3, including the k factor */
+  float               m_A[4];         /* A1..A3 in m_A[1..3] */
+  float               m_S[3];         /* state */
+  float               m_E;            /* latest error */
+  float               m_Min;
+  float               m_Max;
+} XMC_3P3Z_TDF2_FLOAT_t;
+
+/* Structure defining the biquad cascaded with a first-order section holding
+ * the real pole closest to the integrator */
+typedef struct XMC_3P3Z_CASCADE_FLOAT
+{
+  volatile uint32_t*  m_pFeedBack;    /* pointer to ADC register which is used for feedback */
+  uint32_t            m_Out;          /* 24 bit integer (16 bit low resolution + 8 bit high resolution) */
+  uint16_t            m_Ref;          /* ADC reference */
+  float               m_N1;           /* biquad (1 + N1 z^-1 + N2 z^-2) / (1 + C1 z^-1 + C0 z^-2) */
+  float               m_N2;
+  float               m_C1;
+  float               m_C0;
+  float               m_T[2];         /* biquad state */
+  float               m_Gdc;          /* biquad DC gain */
+  float               m_G;            /* first-order section G * (1 - q z^-1) / (1 - R z^-1) */
+  float               m_Gi;           /* G * (R - q) */
+  float               m_R;
+  float               m_I;            /* first-order section state */
+  float               m_VPrev;        /* previous biquad output */
+  float               m_E;            /* latest error */
+  float               m_Min;
+  float               m_Max;
+} XMC_3P3Z_CASCADE_FLOAT_t;
+
+/* Structure defining the modal state-space filter: one real mode and a
+ * second-order block in parallel with a direct feedthrough */
+typedef struct XMC_3P3Z_SS_FLOAT
+{
+  volatile uint32_t*  m_pFeedBack;    /* pointer to ADC register which is used for feedback */
+  uint32_t            m_Out;          /* 24 bit integer (16 bit low resolution + 8 bit high resolution) */
+  uint16_t            m_Ref;          /* ADC reference */
+  float               m_D;            /* direct feedthrough */
+  float               m_Alpha;        /* real mode Alpha / (1 - R z^-1) */
+  float               m_R;
+  float               m_Beta0;        /* block (Beta0 + Beta1 z^-1) / (1 + C1 z^-1 + C0 z^-2) */
+  float               m_Beta1;
+  float               m_C1;
+  float               m_C0;
+  float               m_G2dc;         /* block DC gain */
+  float               m_X;            /* real mode state */
+  float               m_P[2];         /* block state */
+  float               m_E;            /* latest error */
+  float               m_Min;
+  float               m_Max;
+} XMC_3P3Z_SS_FLOAT_t;
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitTdf2Float
+********************************************************************************
+* Summary:
+* This API uses the raw coefficients for the filter and fills the transposed
+* direct form II structure. The parameters are the ones of XMC_3P3Z_InitFloat.
+*
+* Parameters:
+* XMC_3P3Z_TDF2_FLOAT_t* [out] ptr Pointer to the filter structure
+* float                  [in]  cB0..cB3 B filter coefficients
+* float                  [in]  cA1..cA3 A filter coefficients
+* float                  [in]  cK k factor of the filter
+* uint16_t               [in]  ref Reference value for the VADC
+* float                  [in]  pwmMin 24 bit min PWM value.
+* float                  [in]  pwmMax 24 bit max PWM value.
+* volatile uint32_t*     [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitTdf2Float(XMC_3P3Z_TDF2_FLOAT_t* ptr,
+                                            float cB0,
+                                            float cB1,
+                                            float cB2,
+                                            float cB3,
+                                            float cA1,
+                                            float cA2,
+                                            float cA3,
+                                            float cK,
+                                            uint16_t ref,
+                                            float pwmMin,
+                                            float pwmMax,
+                                            volatile uint32_t* pFeedBack )
+{
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+
+  ptr->m_B[0]       = cB0*cK;
+  ptr->m_B[1]       = cB1*cK;
+  ptr->m_B[2]       = cB2*cK;
+  ptr->m_B[3]       = cB3*cK;
+  ptr->m_A[1]       = cA1;
+  ptr->m_A[2]       = cA2;
+  ptr->m_A[3]       = cA3;
+
+  ptr->m_Min        = pwmMin;
+  ptr->m_Max        = pwmMax;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterTdf2Float
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering in transposed direct form II.
+* There are three state words and no history moves. The state is updated with
+* the output clamped to +/- max, as XMC_3P3Z_AW_CLAMP does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_TDF2_FLOAT_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterTdf2Float(XMC_3P3Z_TDF2_FLOAT_t* ptr)
+{
+  float e;
+  float acc;
+  float u;
+
+  e = (float)(ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack));
+  ptr->m_E = e;
+
+  acc = ptr->m_B[0]*e + ptr->m_S[0];
+  u = MIN( acc , ptr->m_Max );
+  u = MAX( u , -ptr->m_Max );
+
+  ptr->m_S[0] = ptr->m_B[1]*e + ptr->m_A[1]*u + ptr->m_S[1];
+  ptr->m_S[1] = ptr->m_B[2]*e + ptr->m_A[2]*u + ptr->m_S[2];
+  ptr->m_S[2] = ptr->m_B[3]*e + ptr->m_A[3]*u;
+
+  /*Filter Output*/
+  ptr->m_Out = (uint32_t)MAX( u , ptr->m_Min );
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetTdf2Float
+********************************************************************************
+* Summary:
+* This function loads the state with the steady state for a duty value and the
+* latest error, as XMC_3P3Z_PresetFloat does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_TDF2_FLOAT_t* [in/out] ptr Pointer to the filter structure
+* float                  [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetTdf2Float(XMC_3P3Z_TDF2_FLOAT_t* ptr, float duty)
+{
+  float e = ptr->m_E;
+
+  duty = MIN( duty , ptr->m_Max );
+  duty = MAX( duty , -ptr->m_Max );
+
+  ptr->m_S[2] = ptr->m_B[3]*e + ptr->m_A[3]*duty;
+  ptr->m_S[1] = ptr->m_B[2]*e + ptr->m_A[2]*duty + ptr->m_S[2];
+  ptr->m_S[0] = ptr->m_B[1]*e + ptr->m_A[1]*duty + ptr->m_S[1];
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitCascadeFloat
+********************************************************************************
+* Summary:
+* This API factors the filter into a biquad followed by a first-order section
+* and fills the cascade structure. The real pole closest to 1 and the zero
+* closest to it go to the first-order section, the remaining poles and zeros
+* to the biquad. The parameters are the ones of XMC_3P3Z_InitFloat; cB0 must
+* not be 0.
+*
+* Parameters:
+* XMC_3P3Z_CASCADE_FLOAT_t* [out] ptr Pointer to the filter structure
+* float                     [in]  cB0..cB3 B filter coefficients
+* float                     [in]  cA1..cA3 A filter coefficients
+* float                     [in]  cK k factor of the filter
+* uint16_t                  [in]  ref Reference value for the VADC
+* float                     [in]  pwmMin 24 bit min PWM value.
+* float                     [in]  pwmMax 24 bit max PWM value.
+* volatile uint32_t*        [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitCascadeFloat(XMC_3P3Z_CASCADE_FLOAT_t* ptr,
+                                               float cB0,
+                                               float cB1,
+                                               float cB2,
+                                               float cB3,
+                                               float cA1,
+                                               float cA2,
+                                               float cA3,
+                                               float cK,
+                                               uint16_t ref,
+                                               float pwmMin,
+                                               float pwmMax,
+                                               volatile uint32_t* pFeedBack )
+{
+  XMC_3P3Z_FACTOR_t den;
+  XMC_3P3Z_FACTOR_t num;
+
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+
+  XMC_3P3Z_FactorCubic(&den, -cA1, -cA2, -cA3, 1.0f);
+  XMC_3P3Z_FactorCubic(&num, cB1/cB0, cB2/cB0, cB3/cB0, den.m_R);
+
+  ptr->m_N1         = num.m_C1;
+  ptr->m_N2         = num.m_C0;
+  ptr->m_C1         = den.m_C1;
+  ptr->m_C0         = den.m_C0;
+  ptr->m_Gdc        = (1.0f + num.m_C1 + num.m_C0) / (1.0f + den.m_C1 + den.m_C0);
+
+  ptr->m_G          = cB0*cK;
+  ptr->m_Gi         = ptr->m_G * (den.m_R - num.m_R);
+  ptr->m_R          = den.m_R;
+
+  ptr->m_Min        = pwmMin;
+  ptr->m_Max        = pwmMax;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterCascadeFloat
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering as a biquad in transposed direct
+* form II followed by the first-order section, written as
+* G * v + I with I = R * I + G * (R - q) * v[n-1]. The first-order state is
+* corrected so the output it produces is clamped to +/- max.
+*
+* Parameters:
+* XMC_3P3Z_CASCADE_FLOAT_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterCascadeFloat(XMC_3P3Z_CASCADE_FLOAT_t* ptr)
+{
+  float e;
+  float v;
+  float acc;
+  float u;
+
+  e = (float)(ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack));
+  ptr->m_E = e;
+
+  /* Biquad */
+  v = e + ptr->m_T[0];
+  ptr->m_T[0] = ptr->m_N1*e - ptr->m_C1*v + ptr->m_T[1];
+  ptr->m_T[1] = ptr->m_N2*e - ptr->m_C0*v;
+
+  /* First-order section */
+  ptr->m_I = ptr->m_R*ptr->m_I + ptr->m_Gi*ptr->m_VPrev;
+  ptr->m_VPrev = v;
+
+  acc = ptr->m_G*v + ptr->m_I;
+  u = MIN( acc , ptr->m_Max );
+  u = MAX( u , -ptr->m_Max );
+  ptr->m_I += u - acc;
+
+  /*Filter Output*/
+  ptr->m_Out = (uint32_t)MAX( u , ptr->m_Min );
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetCascadeFloat
+********************************************************************************
+* Summary:
+* This function loads the state with the steady state for a duty value and the
+* latest error, as XMC_3P3Z_PresetFloat does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_CASCADE_FLOAT_t* [in/out] ptr Pointer to the filter structure
+* float                     [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetCascadeFloat(XMC_3P3Z_CASCADE_FLOAT_t* ptr, float duty)
+{
+  float e = ptr->m_E;
+  float v = ptr->m_Gdc*e;
+
+  duty = MIN( duty , ptr->m_Max );
+  duty = MAX( duty , -ptr->m_Max );
+
+  ptr->m_T[1] = ptr->m_N2*e - ptr->m_C0*v;
+  ptr->m_T[0] = ptr->m_N1*e - ptr->m_C1*v + ptr->m_T[1];
+  ptr->m_VPrev = v;
+  ptr->m_I = duty - ptr->m_G*v;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_InitStateSpaceFloat
+********************************************************************************
+* Summary:
+* This API expands the filter in partial fractions and fills the modal
+* state-space structure. The real pole closest to 1 becomes the real mode. The
+* parameters are the ones of XMC_3P3Z_InitFloat.
+*
+* Parameters:
+* XMC_3P3Z_SS_FLOAT_t* [out] ptr Pointer to the filter structure
+* float                [in]  cB0..cB3 B filter coefficients
+* float                [in]  cA1..cA3 A filter coefficients
+* float                [in]  cK k factor of the filter
+* uint16_t             [in]  ref Reference value for the VADC
+* float                [in]  pwmMin 24 bit min PWM value.
+* float                [in]  pwmMax 24 bit max PWM value.
+* volatile uint32_t*   [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_InitStateSpaceFloat(XMC_3P3Z_SS_FLOAT_t* ptr,
+                                                  float cB0,
+                                                  float cB1,
+                                                  float cB2,
+                                                  float cB3,
+                                                  float cA1,
+                                                  float cA2,
+                                                  float cA3,
+                                                  float cK,
+                                                  uint16_t ref,
+                                                  float pwmMin,
+                                                  float pwmMax,
+                                                  volatile uint32_t* pFeedBack )
+{
+  XMC_3P3Z_FACTOR_t den;
+  XMC_3P3Z_MODES_t modes;
+
+  memset( ptr, 0, sizeof(*ptr));
+
+  ptr->m_pFeedBack  = pFeedBack;
+  ptr->m_Ref        = ref;
+
+  XMC_3P3Z_FactorCubic(&den, -cA1, -cA2, -cA3, 1.0f);
+  XMC_3P3Z_PartialFractions(&modes, &den,
+                            cB0*cK, cB1*cK, cB2*cK, cB3*cK, cA1, cA2, cA3);
+
+  ptr->m_D          = modes.m_D;
+  ptr->m_Alpha      = modes.m_Alpha;
+  ptr->m_R          = den.m_R;
+  ptr->m_Beta0      = modes.m_Beta0;
+  ptr->m_Beta1      = modes.m_Beta1;
+  ptr->m_C1         = den.m_C1;
+  ptr->m_C0         = den.m_C0;
+  ptr->m_G2dc       = (modes.m_Beta0 + modes.m_Beta1) / (1.0f + den.m_C1 + den.m_C0);
+
+  ptr->m_Min        = pwmMin;
+  ptr->m_Max        = pwmMax;
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_FilterStateSpaceFloat
+********************************************************************************
+* Summary:
+* This function performs the 3p3z filtering in modal state-space form: the
+* real mode, the second-order block in transposed direct form II and the
+* direct feedthrough are summed. The real mode state is corrected so the
+* output it produces is clamped to +/- max.
+*
+* Parameters:
+* XMC_3P3Z_SS_FLOAT_t* [in/out] ptr Pointer to the filter structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_FilterStateSpaceFloat(XMC_3P3Z_SS_FLOAT_t* ptr)
+{
+  float e;
+  float y2;
+  float acc;
+  float u;
+
+  e = (float)(ptr->m_Ref-((uint16_t)*ptr->m_pFeedBack));
+  ptr->m_E = e;
+
+  /* Real mode */
+  ptr->m_X = ptr->m_R*ptr->m_X + ptr->m_Alpha*e;
+
+  /* Second-order block */
+  y2 = ptr->m_Beta0*e + ptr->m_P[0];
+  ptr->m_P[0] = ptr->m_Beta1*e - ptr->m_C1*y2 + ptr->m_P[1];
+  ptr->m_P[1] = -ptr->m_C0*y2;
+
+  acc = ptr->m_D*e + ptr->m_X + y2;
+  u = MIN( acc , ptr->m_Max );
+  u = MAX( u , -ptr->m_Max );
+  ptr->m_X += u - acc;
+
+  /*Filter Output*/
+  ptr->m_Out = (uint32_t)MAX( u , ptr->m_Min );
+}
+
+/*******************************************************************************
+* Function Name: XMC_3P3Z_PresetStateSpaceFloat
+********************************************************************************
+* Summary:
+* This function loads the state with the steady state for a duty value and the
+* latest error, as XMC_3P3Z_PresetFloat does in direct form I.
+*
+* Parameters:
+* XMC_3P3Z_SS_FLOAT_t* [in/out] ptr Pointer to the filter structure
+* float                [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_3P3Z_PresetStateSpaceFloat(XMC_3P3Z_SS_FLOAT_t* ptr, float duty)
+{
+  float e = ptr->m_E;
+  float y2 = ptr->m_G2dc*e;
+
+  duty = MIN( duty , ptr->m_Max );
+  duty = MAX( duty , -ptr->m_Max );
+
+  ptr->m_P[1] = -ptr->m_C0*y2;
+  ptr->m_P[0] = ptr->m_Beta1*e - ptr->m_C1*y2 + ptr->m_P[1];
+  ptr->m_X = duty - ptr->m_D*e - y2;
+}
+
+#endif /* #ifndef XMC_3P3Z_REALIZATION_FLOAT_H */
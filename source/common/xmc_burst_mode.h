@@ -0,0 +1,273 @@
+/******************************************************************************
+* File Name:   xmc_burst_mode.h
+*
+* Description: This file provides the light-load burst mode. When the
+*              compensator output stays near the minimum duty, the converter
+*              switches to hysteretic bursts of fixed-duty pulses and the
+*              compensator is frozen. PWM pulses are skipped while the output
+*              voltage is inside the band. When the load rises again, the
+*              linear loop is resumed with its history preset, so there is no
+*              bump.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_BURST_MODE_H
+#define XMC_BURST_MODE_H
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Action requested from the control ISR for the current sample
+ */
+typedef enum XMC_BURST_ACTION
+{
+  XMC_BURST_RUN_FILTER = 0,   /**< Linear mode, run the compensator */
+  XMC_BURST_RESUME,           /**< Preset the compensator, then run it */
+  XMC_BURST_APPLY_DUTY        /**< Burst mode, apply m_Duty and m_Passive, skip the compensator */
+} XMC_BURST_ACTION_t;
+
+/**
+ * Structure defining the burst mode configuration, state and counters
+ */
+typedef struct XMC_BURST
+{
+  uint32_t            m_EnterDuty;    /**< Light load if the duty is at or below */
+  uint32_t            m_EnterSamples; /**< Consecutive light-load samples to enter */
+  uint32_t            m_BurstDuty;    /**< Duty of the burst pulses */
+  uint32_t            m_BurstPulses;  /**< Pulses per burst */
+  uint32_t            m_SkipDuty;     /**< Duty written for a skipped pulse, with the outputs passive */
+  uint32_t            m_StartLevel;   /**< Burst starts below this ADC value */
+  uint32_t            m_ExitLevel;    /**< Linear loop resumes below this ADC value */
+  uint32_t            m_Window;       /**< Samples per window of the pulse count */
+  uint32_t            m_MaxPulses;    /**< Linear loop resumes above this many pulses per window */
+  bool                m_Active;
+  uint32_t            m_LowCount;
+  uint32_t            m_PulsesLeft;
+  uint32_t            m_WindowLeft;
+  uint32_t            m_WindowPulses;
+  uint32_t            m_ResumeDuty;   /**< Compensator output when burst mode was entered */
+  uint32_t            m_Duty;         /**< Duty to apply in burst mode */
+  bool                m_Passive;      /**< Both outputs at the passive level */
+  /* Counters for the supervision */
+  uint32_t            m_Entries;
+  uint32_t            m_Bursts;
+  uint32_t            m_SkippedPulses;  /**< Switching events saved */
+  uint32_t            m_FrozenSamples;  /**< Compensator executions saved */
+} XMC_BURST_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_BURST_Init
+********************************************************************************
+* Summary:
+* This API fills the burst mode structure. Burst mode is disabled if
+* enterSamples is 0.
+*
+* Parameters:
+* XMC_BURST_t* [out] ptr Pointer to the burst mode structure
+* uint32_t     [in]  enterDuty Light load if the compensator output is at or below
+* uint32_t     [in]  enterSamples Consecutive light-load samples to enter
+* uint32_t     [in]  burstDuty Duty of the burst pulses
+* uint32_t     [in]  burstPulses Pulses per burst
+* uint32_t     [in]  skipDuty Duty written for a skipped pulse, while the
+*                    outputs are at the passive level
+* uint32_t     [in]  ref ADC reference of the output voltage
+* uint32_t     [in]  startBand Burst starts when Vout is this far below ref
+* uint32_t     [in]  exitBand Linear loop resumes when Vout is this far below ref
+* uint32_t     [in]  window Samples per window of the pulse count
+* uint32_t     [in]  maxPulses Linear loop resumes after a window with more
+*                    pulses, where the linear loop is more efficient
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_BURST_Init(XMC_BURST_t* ptr,
+                                    uint32_t enterDuty,
+                                    uint32_t enterSamples,
+                                    uint32_t burstDuty,
+                                    uint32_t burstPulses,
+                                    uint32_t skipDuty,
+                                    uint32_t ref,
+                                    uint32_t startBand,
+                                    uint32_t exitBand,
+                                    uint32_t window,
+                                    uint32_t maxPulses)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_EnterDuty    = enterDuty;
+  ptr->m_EnterSamples = enterSamples;
+  ptr->m_BurstDuty    = burstDuty;
+  ptr->m_BurstPulses  = burstPulses;
+  ptr->m_SkipDuty     = skipDuty;
+  ptr->m_StartLevel   = ref - startBand;
+  ptr->m_ExitLevel    = ref - exitBand;
+  ptr->m_Window       = window;
+  ptr->m_MaxPulses    = maxPulses;
+}
+
+/*******************************************************************************
+* Function Name: XMC_BURST_Leave
+********************************************************************************
+* Summary:
+* This function leaves burst mode with the outputs active, for the resume of
+* the linear loop or a restart after a fault. The counters are kept.
+*
+* Parameters:
+* XMC_BURST_t* [in/out] ptr Pointer to the burst mode structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_BURST_Leave(XMC_BURST_t* ptr)
+{
+  ptr->m_Active   = false;
+  ptr->m_Passive  = false;
+  ptr->m_LowCount = 0;
+}
+
+/*******************************************************************************
+* Function Name: XMC_BURST_Update
+********************************************************************************
+* Summary:
+* This function runs the burst mode state machine for one sample in burst
+* mode. A burst of m_BurstPulses pulses starts when Vout drops below the start
+* level; in between, pulses are skipped. The linear loop is resumed when Vout
+* drops below the exit level or a window of m_Window samples has more than
+* m_MaxPulses pulses: the load is then too high for burst mode to save energy.
+* m_Passive is set for a skipped pulse: on a synchronous stage, the ISR must
+* then hold both outputs at the passive level, otherwise the low-side switch
+* conducts for the whole period and nothing is saved.
+*
+* Parameters:
+* XMC_BURST_t* [in/out] ptr Pointer to the burst mode structure
+* uint32_t     [in]  vout Output voltage sample in ADC counts
+*
+* Return:
+*  XMC_BURST_ACTION_t Action for the control ISR
+*
+*******************************************************************************/
+__STATIC_INLINE XMC_BURST_ACTION_t XMC_BURST_Update(XMC_BURST_t* ptr, uint32_t vout)
+{
+  bool tooMany = false;
+
+  if (!ptr->m_Active)
+  {
+    return XMC_BURST_RUN_FILTER;
+  }
+
+  /* The share of pulses grows with the load, the window is reloaded when the
+   * count has been checked */
+  if (ptr->m_WindowLeft == 0)
+  {
+    tooMany = (ptr->m_WindowPulses > ptr->m_MaxPulses);
+    ptr->m_WindowLeft   = ptr->m_Window;
+    ptr->m_WindowPulses = 0;
+  }
+  ptr->m_WindowLeft--;
+
+  if ((vout < ptr->m_ExitLevel) || tooMany)
+  {
+    XMC_BURST_Leave(ptr);
+    return XMC_BURST_RESUME;
+  }
+
+  if ((ptr->m_PulsesLeft == 0) && (vout < ptr->m_StartLevel))
+  {
+    ptr->m_PulsesLeft = ptr->m_BurstPulses;
+    ptr->m_Bursts++;
+  }
+
+  if (ptr->m_PulsesLeft != 0)
+  {
+    ptr->m_PulsesLeft--;
+    ptr->m_WindowPulses++;
+    ptr->m_Duty    = ptr->m_BurstDuty;
+    ptr->m_Passive = false;
+  }
+  else
+  {
+    ptr->m_SkippedPulses++;
+    ptr->m_Duty    = ptr->m_SkipDuty;
+    ptr->m_Passive = true;
+  }
+
+  ptr->m_FrozenSamples++;
+  return XMC_BURST_APPLY_DUTY;
+}
+
+/*******************************************************************************
+* Function Name: XMC_BURST_Observe
+********************************************************************************
+* Summary:
+* This function checks the compensator output in linear mode and enters burst
+* mode after m_EnterSamples consecutive samples at or below m_EnterDuty.
+*
+* Parameters:
+* XMC_BURST_t* [in/out] ptr Pointer to the burst mode structure
+* uint32_t     [in]  duty Compensator output of this sample
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_BURST_Observe(XMC_BURST_t* ptr, uint32_t duty)
+{
+  if (duty > ptr->m_EnterDuty)
+  {
+    ptr->m_LowCount = 0;
+    return;
+  }
+
+  if (++ptr->m_LowCount >= ptr->m_EnterSamples)
+  {
+    ptr->m_Active     = (ptr->m_EnterSamples != 0);
+    ptr->m_PulsesLeft   = 0;
+    ptr->m_WindowLeft   = ptr->m_Window;
+    ptr->m_WindowPulses = 0;
+    ptr->m_ResumeDuty = duty;
+    ptr->m_Entries   += ptr->m_Active ? 1U : 0U;
+  }
+}
+
+#endif /* #ifndef XMC_BURST_MODE_H */
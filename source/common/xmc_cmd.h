@@ -0,0 +1,684 @@
+/******************************************************************************
+* File Name:   xmc_cmd.h
+*
+* Description: This file provides the binary command protocol used to tune
+*              the compensator at runtime. It reads and writes the compensator
+*              parameters, switches the reference and dumps the regulator
+*              state. The code has no peripheral dependencies and is shared by
+*              the firmware and the host tools.
+*
+*              Frame: SYNC LEN CMD PAYLOAD[LEN] CRC
+*              SYNC is 0xA5, LEN the payload length and CRC a CRC-8 (poly 0x07)
+*              over LEN, CMD and PAYLOAD. A response has the command with bit 7
+*              set and the status as the first payload byte. Multi-byte values
+*              are little endian, parameters are IEEE-754 floats.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_CMD_H
+#define XMC_CMD_H
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#define XMC_CMD_SYNC                (0xA5U)
+#define XMC_CMD_VERSION             (1U)
+#define XMC_CMD_MAX_PAYLOAD         (48U)
+/**< SYNC, LEN, CMD and CRC around the payload */
+#define XMC_CMD_MAX_FRAME           (XMC_CMD_MAX_PAYLOAD + 4U)
+/**< Set in the command of a response */
+#define XMC_CMD_RESPONSE            (0x80U)
+
+/* Commands */
+#define XMC_CMD_PING                (0x01U) /**< -> version, kit, parameter count */
+#define XMC_CMD_GET                 (0x02U) /**< id -> id, value */
+#define XMC_CMD_SET                 (0x03U) /**< id, value; stages the value */
+#define XMC_CMD_APPLY               (0x04U) /**< hands the staged set to the control ISR */
+#define XMC_CMD_SET_REF             (0x05U) /**< uint16 reference; applies it to the live set */
+#define XMC_CMD_DUMP                (0x06U) /**< -> XMC_CMD_STATE_t */
+#define XMC_CMD_TRACE               (0x07U) /**< -> next trace bytes; offset -> header bytes */
+
+/* Bits of XMC_CMD_STATE_t m_Flags */
+#define XMC_CMD_FLAG_PENDING        (0x01U) /**< Update not yet taken by the ISR */
+#define XMC_CMD_FLAG_CURRENT_MODE   (0x02U) /**< Parameters are the outer voltage loop */
+#define XMC_CMD_FLAG_PREDICTOR      (0x04U)
+#define XMC_CMD_FLAG_FEEDFORWARD    (0x08U)
+#define XMC_CMD_FLAG_BURST          (0x10U)
+#define XMC_CMD_FLAG_FAULT          (0x20U) /**< PWM shut down by the protection */
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Status returned as the first byte of every response
+ */
+typedef enum XMC_CMD_STATUS
+{
+  XMC_CMD_OK = 0,
+  XMC_CMD_ERR_CMD,            /**< Unknown command */
+  XMC_CMD_ERR_LEN,            /**< Wrong payload length */
+  XMC_CMD_ERR_ID,             /**< Unknown parameter */
+  XMC_CMD_ERR_VALUE,          /**< Value out of range */
+  XMC_CMD_BUSY                /**< Previous update not yet taken by the ISR */
+} XMC_CMD_STATUS_t;
+
+/**
+ * Compensator parameters. The coefficients are the ones of XMC_3P3Z_InitFixed
+ * and XMC_3P3Z_InitFloat, the reference is in ADC counts and the output
+ * limits in duty ticks (in current mode, in current reference units).
+ */
+typedef enum XMC_CMD_PARAM
+{
+  XMC_CMD_PARAM_B0 = 0,
+  XMC_CMD_PARAM_B1,
+  XMC_CMD_PARAM_B2,
+  XMC_CMD_PARAM_B3,
+  XMC_CMD_PARAM_A1,
+  XMC_CMD_PARAM_A2,
+  XMC_CMD_PARAM_A3,
+  XMC_CMD_PARAM_K,
+  XMC_CMD_PARAM_REF,
+  XMC_CMD_PARAM_OUT_MIN,
+  XMC_CMD_PARAM_OUT_MAX,
+  XMC_CMD_PARAM_COUNT
+} XMC_CMD_PARAM_t;
+
+/**
+ * Structure defining a decoded frame
+ */
+typedef struct XMC_CMD_FRAME
+{
+  uint8_t             m_Cmd;
+  uint8_t             m_Len;
+  uint8_t             m_Payload[XMC_CMD_MAX_PAYLOAD];
+} XMC_CMD_FRAME_t;
+
+/**
+ * Structure defining the frame parser state
+ */
+typedef struct XMC_CMD_PARSER
+{
+  XMC_CMD_FRAME_t     m_Frame;
+  uint32_t            m_State;
+  uint32_t            m_Pos;
+  uint8_t             m_Crc;
+  uint32_t            m_Frames;     /**< Valid frames received */
+  uint32_t            m_Errors;     /**< Frames dropped for length or CRC */
+} XMC_CMD_PARSER_t;
+
+/**
+ * Regulator state returned by XMC_CMD_DUMP. The fields are sampled from the
+ * main context while the ISR runs, so they are not one coherent snapshot.
+ */
+typedef struct XMC_CMD_STATE
+{
+  uint32_t            m_Vout;       /**< Latest output voltage sample */
+  uint32_t            m_Ref;        /**< Reference in use */
+  uint32_t            m_Out;        /**< Latest compensator output */
+  uint32_t            m_SatCount;   /**< Saturated samples */
+  uint32_t            m_Applied;    /**< Updates taken by the ISR */
+  uint32_t            m_StatsSeq;   /**< Regulation statistics window number */
+  float               m_MeanV;      /**< Vout mean of the last window */
+  float               m_RippleRms;  /**< Vout RMS ripple of the last window */
+  uint32_t            m_Idle;       /**< Background idle in 0.01 % */
+  uint32_t            m_Flags;      /**< XMC_CMD_FLAG_xxx */
+} XMC_CMD_STATE_t;
+
+/**< Size of XMC_CMD_STATE_t on the wire */
+#define XMC_CMD_STATE_SIZE          (40U)
+
+/**
+ * Hands a complete staged parameter set to the control loop
+ */
+typedef XMC_CMD_STATUS_t (*XMC_CMD_APPLY_FN_t)(const float* pParam);
+
+/**
+ * Fills the regulator state for XMC_CMD_DUMP
+ */
+typedef void (*XMC_CMD_DUMP_FN_t)(XMC_CMD_STATE_t* pState);
+
+/**
+ * Reads trace bytes for XMC_CMD_TRACE: the header from offset, or the next
+ * bytes of the stream
+ */
+typedef uint32_t (*XMC_CMD_TRACE_FN_t)(bool header, uint32_t offset, uint8_t* pBuf, uint32_t max);
+
+/**
+ * Structure defining the command server of the target
+ */
+typedef struct XMC_CMD_SERVER
+{
+  XMC_CMD_PARSER_t    m_Parser;
+  float               m_Param[XMC_CMD_PARAM_COUNT];  /**< Staged parameters */
+  float               m_Live[XMC_CMD_PARAM_COUNT];   /**< Parameters in the control loop */
+  uint8_t             m_Kit;        /**< UC_FAMILY of the target */
+  XMC_CMD_APPLY_FN_t  m_Apply;
+  XMC_CMD_DUMP_FN_t   m_Dump;
+  XMC_CMD_TRACE_FN_t  m_Trace;      /**< NULL without a trace */
+} XMC_CMD_SERVER_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_CMD_Crc8
+********************************************************************************
+* Summary:
+* This function adds one byte to a CRC-8 with the polynomial 0x07.
+*
+* Parameters:
+* uint8_t [in] crc CRC so far, 0 at the start
+* uint8_t [in] data Byte to add
+*
+* Return:
+*  uint8_t Updated CRC
+*
+*******************************************************************************/
+__STATIC_INLINE uint8_t XMC_CMD_Crc8(uint8_t crc, uint8_t data)
+{
+  uint32_t i;
+
+  crc ^= data;
+  for (i = 0U; i < 8U; i++)
+  {
+    crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+  }
+
+  return crc;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_PutU32
+********************************************************************************
+* Summary:
+* This function writes a 32-bit value little endian.
+*
+* Parameters:
+* uint8_t* [out] pBuf Destination
+* uint32_t [in]  value Value to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_PutU32(uint8_t* pBuf, uint32_t value)
+{
+  pBuf[0] = (uint8_t)value;
+  pBuf[1] = (uint8_t)(value >> 8);
+  pBuf[2] = (uint8_t)(value >> 16);
+  pBuf[3] = (uint8_t)(value >> 24);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_GetU32
+********************************************************************************
+* Summary:
+* This function reads a 32-bit little endian value.
+*
+* Parameters:
+* const uint8_t* [in] pBuf Source
+*
+* Return:
+*  uint32_t Value read
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_CMD_GetU32(const uint8_t* pBuf)
+{
+  return (uint32_t)pBuf[0] | ((uint32_t)pBuf[1] << 8) |
+         ((uint32_t)pBuf[2] << 16) | ((uint32_t)pBuf[3] << 24);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_PutFloat
+********************************************************************************
+* Summary:
+* This function writes a float as its IEEE-754 bits, little endian.
+*
+* Parameters:
+* uint8_t* [out] pBuf Destination
+* float    [in]  value Value to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_PutFloat(uint8_t* pBuf, float value)
+{
+  uint32_t bits;
+
+  memcpy(&bits, &value, sizeof(bits));
+  XMC_CMD_PutU32(pBuf, bits);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_GetFloat
+********************************************************************************
+* Summary:
+* This function reads a float written by XMC_CMD_PutFloat.
+*
+* Parameters:
+* const uint8_t* [in] pBuf Source
+*
+* Return:
+*  float Value read
+*
+*******************************************************************************/
+__STATIC_INLINE float XMC_CMD_GetFloat(const uint8_t* pBuf)
+{
+  uint32_t bits = XMC_CMD_GetU32(pBuf);
+  float value;
+
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_PutState
+********************************************************************************
+* Summary:
+* This function serializes the regulator state, XMC_CMD_STATE_SIZE bytes.
+*
+* Parameters:
+* uint8_t*               [out] pBuf Destination
+* const XMC_CMD_STATE_t* [in]  pState State to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_PutState(uint8_t* pBuf, const XMC_CMD_STATE_t* pState)
+{
+  XMC_CMD_PutU32(&pBuf[0],  pState->m_Vout);
+  XMC_CMD_PutU32(&pBuf[4],  pState->m_Ref);
+  XMC_CMD_PutU32(&pBuf[8],  pState->m_Out);
+  XMC_CMD_PutU32(&pBuf[12], pState->m_SatCount);
+  XMC_CMD_PutU32(&pBuf[16], pState->m_Applied);
+  XMC_CMD_PutU32(&pBuf[20], pState->m_StatsSeq);
+  XMC_CMD_PutFloat(&pBuf[24], pState->m_MeanV);
+  XMC_CMD_PutFloat(&pBuf[28], pState->m_RippleRms);
+  XMC_CMD_PutU32(&pBuf[32], pState->m_Idle);
+  XMC_CMD_PutU32(&pBuf[36], pState->m_Flags);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_GetState
+********************************************************************************
+* Summary:
+* This function reads a regulator state written by XMC_CMD_PutState.
+*
+* Parameters:
+* const uint8_t*   [in]  pBuf Source
+* XMC_CMD_STATE_t* [out] pState State read
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_GetState(const uint8_t* pBuf, XMC_CMD_STATE_t* pState)
+{
+  pState->m_Vout      = XMC_CMD_GetU32(&pBuf[0]);
+  pState->m_Ref       = XMC_CMD_GetU32(&pBuf[4]);
+  pState->m_Out       = XMC_CMD_GetU32(&pBuf[8]);
+  pState->m_SatCount  = XMC_CMD_GetU32(&pBuf[12]);
+  pState->m_Applied   = XMC_CMD_GetU32(&pBuf[16]);
+  pState->m_StatsSeq  = XMC_CMD_GetU32(&pBuf[20]);
+  pState->m_MeanV     = XMC_CMD_GetFloat(&pBuf[24]);
+  pState->m_RippleRms = XMC_CMD_GetFloat(&pBuf[28]);
+  pState->m_Idle      = XMC_CMD_GetU32(&pBuf[32]);
+  pState->m_Flags     = XMC_CMD_GetU32(&pBuf[36]);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_Encode
+********************************************************************************
+* Summary:
+* This function builds a frame.
+*
+* Parameters:
+* uint8_t*       [out] pBuf Destination, at least XMC_CMD_MAX_FRAME bytes
+* uint8_t        [in]  cmd Command
+* const uint8_t* [in]  pPayload Payload, may be NULL if len is 0
+* uint32_t       [in]  len Payload length, at most XMC_CMD_MAX_PAYLOAD
+*
+* Return:
+*  uint32_t Frame length
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_CMD_Encode(uint8_t* pBuf, uint8_t cmd,
+                                        const uint8_t* pPayload, uint32_t len)
+{
+  uint32_t i;
+  uint8_t crc;
+
+  pBuf[0] = XMC_CMD_SYNC;
+  pBuf[1] = (uint8_t)len;
+  pBuf[2] = cmd;
+  crc = XMC_CMD_Crc8(0U, pBuf[1]);
+  crc = XMC_CMD_Crc8(crc, cmd);
+  for (i = 0U; i < len; i++)
+  {
+    pBuf[3U + i] = pPayload[i];
+    crc = XMC_CMD_Crc8(crc, pPayload[i]);
+  }
+  pBuf[3U + len] = crc;
+
+  return len + 4U;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_ParserInit
+********************************************************************************
+* Summary:
+* This API resets the frame parser.
+*
+* Parameters:
+* XMC_CMD_PARSER_t* [out] ptr Pointer to the parser structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_ParserInit(XMC_CMD_PARSER_t* ptr)
+{
+  memset(ptr, 0, sizeof(*ptr));
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_ParserFeed
+********************************************************************************
+* Summary:
+* This function adds one received byte to the parser. A frame with a wrong
+* length or CRC is dropped and the parser waits for the next SYNC byte.
+*
+* Parameters:
+* XMC_CMD_PARSER_t* [in/out] ptr Pointer to the parser structure
+* uint8_t           [in]  data Received byte
+*
+* Return:
+*  bool true if a valid frame is complete in m_Frame
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_CMD_ParserFeed(XMC_CMD_PARSER_t* ptr, uint8_t data)
+{
+  XMC_CMD_FRAME_t* frame = &ptr->m_Frame;
+
+  switch (ptr->m_State)
+  {
+    case 0U: /* SYNC */
+      if (data == XMC_CMD_SYNC)
+      {
+        ptr->m_State = 1U;
+      }
+      break;
+
+    case 1U: /* LEN */
+      if (data > XMC_CMD_MAX_PAYLOAD)
+      {
+        ptr->m_Errors++;
+        ptr->m_State = 0U;
+        break;
+      }
+      frame->m_Len = data;
+      ptr->m_Crc   = XMC_CMD_Crc8(0U, data);
+      ptr->m_State = 2U;
+      break;
+
+    case 2U: /* CMD */
+      frame->m_Cmd = data;
+      ptr->m_Crc   = XMC_CMD_Crc8(ptr->m_Crc, data);
+      ptr->m_Pos   = 0U;
+      ptr->m_State = (frame->m_Len != 0U) ? 3U : 4U;
+      break;
+
+    case 3U: /* PAYLOAD */
+      frame->m_Payload[ptr->m_Pos++] = data;
+      ptr->m_Crc = XMC_CMD_Crc8(ptr->m_Crc, data);
+      if (ptr->m_Pos == frame->m_Len)
+      {
+        ptr->m_State = 4U;
+      }
+      break;
+
+    default: /* CRC */
+      ptr->m_State = 0U;
+      if (data != ptr->m_Crc)
+      {
+        ptr->m_Errors++;
+        break;
+      }
+      ptr->m_Frames++;
+      return true;
+  }
+
+  return false;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_ServerInit
+********************************************************************************
+* Summary:
+* This API fills the command server. The staged and the live parameters are
+* set to the values the compensator was initialized with.
+*
+* Parameters:
+* XMC_CMD_SERVER_t*  [out] ptr Pointer to the server structure
+* uint8_t            [in]  kit UC_FAMILY of the target
+* const float*       [in]  pParam XMC_CMD_PARAM_COUNT initial parameters
+* XMC_CMD_APPLY_FN_t [in]  apply Hands a parameter set to the control loop
+* XMC_CMD_DUMP_FN_t  [in]  dump Fills the regulator state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_ServerInit(XMC_CMD_SERVER_t* ptr,
+                                        uint8_t kit,
+                                        const float* pParam,
+                                        XMC_CMD_APPLY_FN_t apply,
+                                        XMC_CMD_DUMP_FN_t dump)
+{
+  memset(ptr, 0, sizeof(*ptr));
+  XMC_CMD_ParserInit(&ptr->m_Parser);
+
+  memcpy(ptr->m_Param, pParam, sizeof(ptr->m_Param));
+  memcpy(ptr->m_Live, pParam, sizeof(ptr->m_Live));
+  ptr->m_Kit   = kit;
+  ptr->m_Apply = apply;
+  ptr->m_Dump  = dump;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_ServerSetTrace
+********************************************************************************
+* Summary:
+* This API enables XMC_CMD_TRACE with the reader of the trace.
+*
+* Parameters:
+* XMC_CMD_SERVER_t*  [in/out] ptr Pointer to the server structure
+* XMC_CMD_TRACE_FN_t [in]  trace Reads the trace bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_ServerSetTrace(XMC_CMD_SERVER_t* ptr, XMC_CMD_TRACE_FN_t trace)
+{
+  ptr->m_Trace = trace;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_Handle
+********************************************************************************
+* Summary:
+* This function executes a request and builds the response frame. It runs in
+* the main context.
+*
+* Parameters:
+* XMC_CMD_SERVER_t*      [in/out] ptr Pointer to the server structure
+* const XMC_CMD_FRAME_t* [in]  pReq Request
+* uint8_t*               [out] pBuf Response frame, at least XMC_CMD_MAX_FRAME
+*                              bytes
+*
+* Return:
+*  uint32_t Response frame length
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_CMD_Handle(XMC_CMD_SERVER_t* ptr,
+                                        const XMC_CMD_FRAME_t* pReq,
+                                        uint8_t* pBuf)
+{
+  uint8_t resp[XMC_CMD_MAX_PAYLOAD];
+  uint32_t len = 1U;
+  uint32_t id;
+  float value;
+  float live[XMC_CMD_PARAM_COUNT];
+  XMC_CMD_STATE_t state;
+  XMC_CMD_STATUS_t status = XMC_CMD_OK;
+
+  switch (pReq->m_Cmd)
+  {
+    case XMC_CMD_PING:
+      resp[1] = XMC_CMD_VERSION;
+      resp[2] = ptr->m_Kit;
+      resp[3] = XMC_CMD_PARAM_COUNT;
+      len = 4U;
+      break;
+
+    case XMC_CMD_GET:
+      if (pReq->m_Len != 1U)
+      {
+        status = XMC_CMD_ERR_LEN;
+        break;
+      }
+      id = pReq->m_Payload[0];
+      if (id >= XMC_CMD_PARAM_COUNT)
+      {
+        status = XMC_CMD_ERR_ID;
+        break;
+      }
+      resp[1] = (uint8_t)id;
+      XMC_CMD_PutFloat(&resp[2], ptr->m_Param[id]);
+      len = 6U;
+      break;
+
+    case XMC_CMD_SET:
+      if (pReq->m_Len != 5U)
+      {
+        status = XMC_CMD_ERR_LEN;
+        break;
+      }
+      id    = pReq->m_Payload[0];
+      value = XMC_CMD_GetFloat(&pReq->m_Payload[1]);
+      if (id >= XMC_CMD_PARAM_COUNT)
+      {
+        status = XMC_CMD_ERR_ID;
+      }
+      else if (!(value == value) || (value > 1.0e9f) || (value < -1.0e9f))
+      {
+        /* NaN or infinite */
+        status = XMC_CMD_ERR_VALUE;
+      }
+      else
+      {
+        ptr->m_Param[id] = value;
+      }
+      break;
+
+    case XMC_CMD_APPLY:
+      status = ptr->m_Apply(ptr->m_Param);
+      if (status == XMC_CMD_OK)
+      {
+        memcpy(ptr->m_Live, ptr->m_Param, sizeof(ptr->m_Live));
+      }
+      break;
+
+    case XMC_CMD_SET_REF:
+      if (pReq->m_Len != 2U)
+      {
+        status = XMC_CMD_ERR_LEN;
+        break;
+      }
+      /* Only the reference changes; the other staged values wait for APPLY.
+       * The staged reference follows, so the next APPLY keeps it. */
+      value = (float)((uint32_t)pReq->m_Payload[0] | ((uint32_t)pReq->m_Payload[1] << 8));
+      memcpy(live, ptr->m_Live, sizeof(live));
+      live[XMC_CMD_PARAM_REF] = value;
+      status = ptr->m_Apply(live);
+      if (status == XMC_CMD_OK)
+      {
+        ptr->m_Live[XMC_CMD_PARAM_REF]  = value;
+        ptr->m_Param[XMC_CMD_PARAM_REF] = value;
+      }
+      break;
+
+    case XMC_CMD_DUMP:
+      ptr->m_Dump(&state);
+      XMC_CMD_PutState(&resp[1], &state);
+      len = 1U + XMC_CMD_STATE_SIZE;
+      break;
+
+    case XMC_CMD_TRACE:
+      if (ptr->m_Trace == NULL)
+      {
+        status = XMC_CMD_ERR_CMD;
+        break;
+      }
+      if (pReq->m_Len > 1U)
+      {
+        status = XMC_CMD_ERR_LEN;
+        break;
+      }
+      len = 1U + ptr->m_Trace(pReq->m_Len != 0U, pReq->m_Payload[0], &resp[1],
+                              XMC_CMD_MAX_PAYLOAD - 1U);
+      break;
+
+    default:
+      status = XMC_CMD_ERR_CMD;
+      break;
+  }
+
+  if (status != XMC_CMD_OK)
+  {
+    len = 1U;
+  }
+  resp[0] = (uint8_t)status;
+
+  return XMC_CMD_Encode(pBuf, (uint8_t)(pReq->m_Cmd | XMC_CMD_RESPONSE), resp, len);
+}
+
+#endif /* #ifndef XMC_CMD_H */
@@ -0,0 +1,305 @@
+/******************************************************************************
+* File Name:   xmc_cmd_uart.h
+*
+* Description: This file provides the interrupt-driven USIC UART link of the
+*              command channel. The receive and transmit interrupts only move
+*              single bytes between the USIC and two ring buffers; the frames
+*              are parsed and handled in the main context. Both interrupts run
+*              at a lower priority than the control ISR.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_CMD_UART_H
+#define XMC_CMD_UART_H
+
+#include "xmc_uart.h"
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+/**< Ring buffer sizes, powers of two larger than XMC_CMD_MAX_FRAME */
+#define XMC_CMD_UART_RX_SIZE        (64U)
+#define XMC_CMD_UART_TX_SIZE        (64U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the UART link and its ring buffers
+ */
+typedef struct XMC_CMD_UART
+{
+  XMC_USIC_CH_t*      m_Channel;
+  IRQn_Type           m_TxIrq;
+  uint8_t             m_Rx[XMC_CMD_UART_RX_SIZE];
+  volatile uint32_t   m_RxHead;     /**< Written by the receive ISR */
+  volatile uint32_t   m_RxTail;
+  uint8_t             m_Tx[XMC_CMD_UART_TX_SIZE];
+  volatile uint32_t   m_TxHead;
+  volatile uint32_t   m_TxTail;     /**< Written by the transmit ISR */
+  volatile bool       m_TxBusy;
+  uint32_t            m_RxOverruns; /**< Bytes dropped, ring buffer full */
+} XMC_CMD_UART_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_CMD_UART_Init
+********************************************************************************
+* Summary:
+* This API configures the USIC channel as a 8N1 UART and enables the receive
+* and transmit buffer interrupts. The pins must be configured by the caller.
+*
+* Parameters:
+* XMC_CMD_UART_t* [out] ptr Pointer to the link structure
+* XMC_USIC_CH_t*  [in]  channel USIC channel
+* uint32_t        [in]  baudrate Baud rate
+* uint8_t         [in]  rxSource DX0 input of the RX pin, USICx_Cy_DX0_Pz_w
+* uint32_t        [in]  rxSr Service request of the receive events
+* uint32_t        [in]  txSr Service request of the transmit buffer event
+* IRQn_Type       [in]  rxIrq Interrupt of rxSr
+* IRQn_Type       [in]  txIrq Interrupt of txSr
+* uint32_t        [in]  priority Priority of both interrupts, lower than the
+*                       control ISR
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_UART_Init(XMC_CMD_UART_t* ptr,
+                                       XMC_USIC_CH_t* channel,
+                                       uint32_t baudrate,
+                                       uint8_t rxSource,
+                                       uint32_t rxSr,
+                                       uint32_t txSr,
+                                       IRQn_Type rxIrq,
+                                       IRQn_Type txIrq,
+                                       uint32_t priority)
+{
+  XMC_UART_CH_CONFIG_t config;
+
+  memset(ptr, 0, sizeof(*ptr));
+  ptr->m_Channel = channel;
+  ptr->m_TxIrq   = txIrq;
+
+  memset(&config, 0, sizeof(config));
+  config.baudrate  = baudrate;
+  config.data_bits = 8U;
+  config.stop_bits = 1U;
+  XMC_UART_CH_Init(channel, &config);
+  XMC_UART_CH_SetInputSource(channel, XMC_UART_CH_INPUT_RXD, rxSource);
+
+  XMC_UART_CH_SetInterruptNodePointer(channel,
+                                      XMC_UART_CH_INTERRUPT_NODE_POINTER_RECEIVE,
+                                      rxSr);
+  XMC_UART_CH_SetInterruptNodePointer(channel,
+                                      XMC_UART_CH_INTERRUPT_NODE_POINTER_ALTERNATE_RECEIVE,
+                                      rxSr);
+  XMC_UART_CH_SetInterruptNodePointer(channel,
+                                      XMC_UART_CH_INTERRUPT_NODE_POINTER_TRANSMIT_BUFFER,
+                                      txSr);
+  XMC_UART_CH_EnableEvent(channel, (uint32_t)XMC_UART_CH_EVENT_STANDARD_RECEIVE |
+                                   (uint32_t)XMC_UART_CH_EVENT_ALTERNATIVE_RECEIVE);
+
+  NVIC_SetPriority(rxIrq, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), priority, 0));
+  NVIC_SetPriority(txIrq, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), priority, 0));
+  NVIC_EnableIRQ(rxIrq);
+  NVIC_EnableIRQ(txIrq);
+
+  XMC_UART_CH_Start(channel);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_UART_RxIsr
+********************************************************************************
+* Summary:
+* This function stores one received byte. It is called from the receive ISR.
+*
+* Parameters:
+* XMC_CMD_UART_t* [in/out] ptr Pointer to the link structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_UART_RxIsr(XMC_CMD_UART_t* ptr)
+{
+  uint32_t next;
+  uint8_t data;
+
+  XMC_UART_CH_ClearStatusFlag(ptr->m_Channel,
+                              (uint32_t)XMC_UART_CH_STATUS_FLAG_RECEIVE_INDICATION |
+                              (uint32_t)XMC_UART_CH_STATUS_FLAG_ALTERNATIVE_RECEIVE_INDICATION);
+  data = (uint8_t)XMC_UART_CH_GetReceivedData(ptr->m_Channel);
+
+  next = (ptr->m_RxHead + 1U) & (XMC_CMD_UART_RX_SIZE - 1U);
+  if (next == ptr->m_RxTail)
+  {
+    ptr->m_RxOverruns++;
+    return;
+  }
+  /* The ring data is not volatile, so the barrier keeps the byte before the
+   * head index that publishes it */
+  ptr->m_Rx[ptr->m_RxHead] = data;
+  __DMB();
+  ptr->m_RxHead = next;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_UART_TxIsr
+********************************************************************************
+* Summary:
+* This function sends the next queued byte, or stops the transmit buffer event
+* when the queue is empty. It is called from the transmit ISR.
+*
+* Parameters:
+* XMC_CMD_UART_t* [in/out] ptr Pointer to the link structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_CMD_UART_TxIsr(XMC_CMD_UART_t* ptr)
+{
+  uint32_t tail = ptr->m_TxTail;
+
+  if (tail == ptr->m_TxHead)
+  {
+    XMC_UART_CH_DisableEvent(ptr->m_Channel, (uint32_t)XMC_UART_CH_EVENT_TRANSMIT_BUFFER);
+    ptr->m_TxBusy = false;
+    return;
+  }
+
+  /* The byte is read after the head index and before its slot is freed */
+  __DMB();
+  XMC_UART_CH_Transmit(ptr->m_Channel, ptr->m_Tx[tail]);
+  __DMB();
+  ptr->m_TxTail = (tail + 1U) & (XMC_CMD_UART_TX_SIZE - 1U);
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_UART_Read
+********************************************************************************
+* Summary:
+* This function takes one byte from the receive buffer. It is called from the
+* main context.
+*
+* Parameters:
+* XMC_CMD_UART_t* [in/out] ptr Pointer to the link structure
+* uint8_t*        [out] pData Byte read
+*
+* Return:
+*  bool true if a byte was read
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_CMD_UART_Read(XMC_CMD_UART_t* ptr, uint8_t* pData)
+{
+  uint32_t tail = ptr->m_RxTail;
+
+  if (tail == ptr->m_RxHead)
+  {
+    return false;
+  }
+
+  /* The byte is read after the head index and before its slot is freed */
+  __DMB();
+  *pData = ptr->m_Rx[tail];
+  __DMB();
+  ptr->m_RxTail = (tail + 1U) & (XMC_CMD_UART_RX_SIZE - 1U);
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_CMD_UART_Write
+********************************************************************************
+* Summary:
+* This function queues a frame for transmission and starts the transmitter if
+* it is idle. The frame is queued whole or not at all, so the host never sees
+* a truncated frame. It is called from the main context; only the transmit
+* interrupt is masked while the transmitter is started.
+*
+* Parameters:
+* XMC_CMD_UART_t* [in/out] ptr Pointer to the link structure
+* const uint8_t*  [in]  pData Bytes to send
+* uint32_t        [in]  len Number of bytes, below XMC_CMD_UART_TX_SIZE
+*
+* Return:
+*  bool true if the frame was queued, false if the ring has no room for it
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_CMD_UART_Write(XMC_CMD_UART_t* ptr, const uint8_t* pData, uint32_t len)
+{
+  uint32_t i;
+  uint32_t head = ptr->m_TxHead;
+  uint32_t tail;
+
+  /* One slot stays free to tell a full ring from an empty one */
+  tail = ptr->m_TxTail;
+  if (len > ((tail - head - 1U) & (XMC_CMD_UART_TX_SIZE - 1U)))
+  {
+    return false;
+  }
+
+  /* The frame is written after the tail index frees its slots, and published
+   * by the head index once it is complete */
+  __DMB();
+  for (i = 0U; i < len; i++)
+  {
+    ptr->m_Tx[head] = pData[i];
+    head = (head + 1U) & (XMC_CMD_UART_TX_SIZE - 1U);
+  }
+  __DMB();
+  ptr->m_TxHead = head;
+
+  NVIC_DisableIRQ(ptr->m_TxIrq);
+  tail = ptr->m_TxTail;
+  if (!ptr->m_TxBusy && (tail != ptr->m_TxHead))
+  {
+    /* The transmit buffer event only follows a transfer, send the first byte */
+    ptr->m_TxBusy = true;
+    XMC_UART_CH_EnableEvent(ptr->m_Channel, (uint32_t)XMC_UART_CH_EVENT_TRANSMIT_BUFFER);
+    XMC_UART_CH_Transmit(ptr->m_Channel, ptr->m_Tx[tail]);
+    ptr->m_TxTail = (tail + 1U) & (XMC_CMD_UART_TX_SIZE - 1U);
+  }
+  NVIC_EnableIRQ(ptr->m_TxIrq);
+
+  return true;
+}
+
+#endif /* #ifndef XMC_CMD_UART_H */
@@ -0,0 +1,231 @@
+/******************************************************************************
+* File Name:   xmc_compensator.h
+*
+* Description: This file provides the common interface of the voltage loop
+*              compensator. The backend is chosen at compile time with
+*              XMC_COMP_BACKEND: floating point, the Q19/Q14 fixed point
+*              kernel, Q15 or Q31 with 64-bit sums. The interface functions
+*              are inline wrappers of the kernel of the backend, so there is
+*              no dispatch at run time.
+*
+*              Every backend structure has m_pFeedBack and m_Ref. The
+*              anti-windup modes, the split filter and the parameter update
+*              are only available in the float and Q19/Q14 kernels and are
+*              called directly.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_COMPENSATOR_H
+#define XMC_COMPENSATOR_H
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#define XMC_COMP_FLOAT              (0)   /**< xmc_3p3z_filter_float.h */
+#define XMC_COMP_FIXED              (1)   /**< xmc_3p3z_filter_fixed.h, B Q19, A Q14 */
+#define XMC_COMP_Q15                (2)   /**< xmc_3p3z_filter_q15.h */
+#define XMC_COMP_Q31                (3)   /**< xmc_3p3z_filter_q31.h */
+
+/* The default backend is the one the code examples are tuned with. Another
+ * one is selected in the Makefile, for example DEFINES+=XMC_COMP_BACKEND=2 */
+#ifndef XMC_COMP_BACKEND
+#if (UC_FAMILY == XMC4)
+#define XMC_COMP_BACKEND            (XMC_COMP_FLOAT)
+#else
+#define XMC_COMP_BACKEND            (XMC_COMP_FIXED)
+#endif
+#endif
+
+/* The B x E sum of the XMC4200 design, with K of about 100, overflows the
+ * +/-4096 range of the Q19 accumulator of the fixed kernel */
+#if (UC_FAMILY == XMC4) && (XMC_COMP_BACKEND == XMC_COMP_FIXED)
+#error "XMC_COMP_FIXED overflows with the XMC4200 design, select XMC_COMP_FLOAT or XMC_COMP_Q31"
+#endif
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+#if (XMC_COMP_BACKEND == XMC_COMP_FLOAT)
+#include "xmc_3p3z_filter_float.h"
+typedef XMC_3P3Z_DATA_FLOAT_t XMC_COMP_t;
+#elif (XMC_COMP_BACKEND == XMC_COMP_FIXED)
+#include "xmc_3p3z_filter_fixed.h"
+typedef XMC_3P3Z_DATA_FIXED_t XMC_COMP_t;
+#elif (XMC_COMP_BACKEND == XMC_COMP_Q15)
+#include "xmc_3p3z_filter_q15.h"
+typedef XMC_3P3Z_DATA_Q15_t XMC_COMP_t;
+#elif (XMC_COMP_BACKEND == XMC_COMP_Q31)
+#include "xmc_3p3z_filter_q31.h"
+typedef XMC_3P3Z_DATA_Q31_t XMC_COMP_t;
+#else
+#error "XMC_COMP_BACKEND must be one of XMC_COMP_FLOAT, XMC_COMP_FIXED, XMC_COMP_Q15 or XMC_COMP_Q31"
+#endif
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_COMP_Init
+********************************************************************************
+* Summary:
+* This API fills the compensator structure of the selected backend. The
+* parameters are the ones of XMC_3P3Z_InitFixed.
+*
+* Parameters:
+ * XMC_COMP_t*        [out] ptr Pointer to the compensator structure
+ * float              [in]  cB0..cB3 B filter coefficients
+ * float              [in]  cA1..cA3 A filter coefficients
+ * float              [in]  cK k factor of the filter
+ * uint16_t           [in]  ref Reference value for the VADC
+ * uint32_t           [in]  pwmMin 24 bit min PWM value.
+ * uint32_t           [in]  pwmMax 24 bit max PWM value.
+ * volatile uint32_t* [out] pFeedBack pointer to ADC register.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_COMP_Init(XMC_COMP_t* ptr,
+                                   float cB0,
+                                   float cB1,
+                                   float cB2,
+                                   float cB3,
+                                   float cA1,
+                                   float cA2,
+                                   float cA3,
+                                   float cK,
+                                   uint16_t ref,
+                                   uint32_t pwmMin,
+                                   uint32_t pwmMax,
+                                   volatile uint32_t* pFeedBack)
+{
+#if (XMC_COMP_BACKEND == XMC_COMP_FLOAT)
+  XMC_3P3Z_InitFloat(ptr, cB0, cB1, cB2, cB3, cA1, cA2, cA3, cK, ref,
+                     (float)pwmMin, (float)pwmMax, pFeedBack);
+#elif (XMC_COMP_BACKEND == XMC_COMP_FIXED)
+  XMC_3P3Z_InitFixed(ptr, cB0, cB1, cB2, cB3, cA1, cA2, cA3, cK, ref,
+                     pwmMin, pwmMax, pFeedBack);
+#elif (XMC_COMP_BACKEND == XMC_COMP_Q15)
+  XMC_3P3Z_InitQ15(ptr, cB0, cB1, cB2, cB3, cA1, cA2, cA3, cK, ref,
+                   pwmMin, pwmMax, pFeedBack);
+#else
+  XMC_3P3Z_InitQ31(ptr, cB0, cB1, cB2, cB3, cA1, cA2, cA3, cK, ref,
+                   pwmMin, pwmMax, pFeedBack);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: XMC_COMP_Run
+********************************************************************************
+* Summary:
+* This function runs the compensator on the latest sample.
+*
+* Parameters:
+* XMC_COMP_t* [in/out] ptr Pointer to the compensator structure
+*
+* Return:
+*  uint32_t Duty in PWM ticks
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_COMP_Run(XMC_COMP_t* ptr)
+{
+#if (XMC_COMP_BACKEND == XMC_COMP_FLOAT)
+  XMC_3P3Z_FilterFloat(ptr);
+  return ptr->m_Out;
+#elif (XMC_COMP_BACKEND == XMC_COMP_FIXED)
+  XMC_3P3Z_FilterFixed(ptr);
+  return ptr->m_pOut;
+#elif (XMC_COMP_BACKEND == XMC_COMP_Q15)
+  XMC_3P3Z_FilterQ15(ptr);
+  return ptr->m_pOut;
+#else
+  XMC_3P3Z_FilterQ31(ptr);
+  return ptr->m_pOut;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: XMC_COMP_Out
+********************************************************************************
+* Summary:
+* This function returns the latest output of the compensator.
+*
+* Parameters:
+* const XMC_COMP_t* [in] ptr Pointer to the compensator structure
+*
+* Return:
+*  uint32_t Duty in PWM ticks
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_COMP_Out(const XMC_COMP_t* ptr)
+{
+#if (XMC_COMP_BACKEND == XMC_COMP_FLOAT)
+  return ptr->m_Out;
+#else
+  return ptr->m_pOut;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: XMC_COMP_Preset
+********************************************************************************
+* Summary:
+* This function loads the history with the steady state for a duty value, so
+* the next output continues from it.
+*
+* Parameters:
+* XMC_COMP_t* [in/out] ptr Pointer to the compensator structure
+* int32_t     [in]  duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_COMP_Preset(XMC_COMP_t* ptr, int32_t duty)
+{
+#if (XMC_COMP_BACKEND == XMC_COMP_FLOAT)
+  XMC_3P3Z_PresetFloat(ptr, (float)duty);
+#elif (XMC_COMP_BACKEND == XMC_COMP_FIXED)
+  XMC_3P3Z_PresetFixed(ptr, duty);
+#elif (XMC_COMP_BACKEND == XMC_COMP_Q15)
+  XMC_3P3Z_PresetQ15(ptr, duty);
+#else
+  XMC_3P3Z_PresetQ31(ptr, duty);
+#endif
+}
+
+#endif /* #ifndef XMC_COMPENSATOR_H */
@@ -0,0 +1,448 @@
+/******************************************************************************
+* File Name:   xmc_deadtime.h
+*
+* Description: This file provides the adaptive dead time. At a fixed output
+*              voltage, the settled duty rises with the losses in the power
+*              path, so a background task perturbs the falling edge dead
+*              time and keeps the setting with the lowest average duty. The control ISR only
+*              adds the duty to power-of-two windows, as xmc_reg_stats.h
+*              does, and writes the registers when a new setting is pending.
+*
+*              Each trial is measured baseline-trial-baseline, so a slow drift
+*              of the load or the input voltage cancels out and a faster
+*              change is detected and discarded. The dead time never leaves
+*              the guard band given at init.
+*
+*              The rising edge dead time is not optimized. It shortens the
+*              high-side on-time, which the loop compensates one for one, so
+*              the lowest duty is at the shortest rising dead time even where
+*              that loses the soft switching at light load.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_DEADTIME_H
+#define XMC_DEADTIME_H
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#ifndef MIN
+/**< Minimum value  calculation macro */
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+/**< Maximum value  calculation macro */
+#define MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+
+/**< Largest supported window, 2^14 samples of a 17 bit duty fit in 32 bits */
+#define XMC_DT_MAX_LOG2_WINDOW      (14U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the duty accumulators of one window
+ */
+typedef struct XMC_DT_WINDOW
+{
+  uint32_t            m_Sum;
+  uint32_t            m_Min;
+  uint32_t            m_Max;
+} XMC_DT_WINDOW_t;
+
+/**
+ * Step of the baseline-trial-baseline measurement
+ */
+typedef enum XMC_DT_PHASE
+{
+  XMC_DT_BASE = 0,            /**< Measuring the baseline */
+  XMC_DT_TRIAL,               /**< Measuring the trial setting */
+  XMC_DT_CHECK                /**< Measuring the baseline again */
+} XMC_DT_PHASE_t;
+
+/**
+ * Structure defining the adaptive dead time. Index 0 of m_Out is the rising
+ * edge, index 1 the falling edge, in register ticks.
+ */
+typedef struct XMC_DT
+{
+  /* Window accumulated by the ISR and handed over as in xmc_reg_stats.h */
+  XMC_DT_WINDOW_t     m_Acc;
+  uint32_t            m_Count;
+  uint32_t            m_Log2N;
+  XMC_DT_WINDOW_t     m_Slot[2];
+  volatile uint32_t   m_Seq;
+  /* Settings */
+  uint32_t            m_DtMin;        /**< Guard band */
+  uint32_t            m_DtMax;
+  uint32_t            m_Step;
+  uint32_t            m_Settle;       /**< Windows skipped after a change */
+  uint32_t            m_Hold;         /**< Windows skipped after convergence */
+  uint32_t            m_MaxSpread;    /**< Duty max - min in a steady window */
+  uint32_t            m_MaxDrift;     /**< Sum change between the baselines */
+  uint32_t            m_MinGain;      /**< Sum decrease to keep a trial */
+  /* Optimizer state */
+  uint32_t            m_Value;        /**< Baseline falling edge dead time */
+  int32_t             m_Dir;          /**< Next trial direction, +1 or -1 */
+  XMC_DT_PHASE_t      m_Phase;
+  uint32_t            m_Skip;
+  uint32_t            m_ReadSeq;
+  uint32_t            m_Base;         /**< Sum of the first baseline window */
+  uint32_t            m_Trial;        /**< Sum of the trial window */
+  uint32_t            m_TrialValue;
+  uint32_t            m_Fails;        /**< Trials rejected in a row */
+  /* Dead times handed to the ISR */
+  uint32_t            m_Out[2];
+  volatile uint32_t   m_Pending;
+  /* Counters for the supervision */
+  uint32_t            m_Trials;
+  uint32_t            m_Accepted;
+  uint32_t            m_Discarded;    /**< Trials lost to a load change or a transient */
+  uint32_t            m_Converged;    /**< Rounds ended without improvement */
+} XMC_DT_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_DT_Init
+********************************************************************************
+* Summary:
+* This API fills the adaptive dead time structure. The start values are
+* clamped to the guard band and handed to the ISR. The rising edge dead time
+* stays at its start value.
+*
+* Parameters:
+* XMC_DT_t* [out] ptr Pointer to the adaptive dead time structure
+* uint32_t  [in]  log2Window Duty samples per window, as a power of two
+* uint32_t  [in]  rise Dead time of the rising edge
+* uint32_t  [in]  fall Start dead time of the falling edge
+* uint32_t  [in]  dtMin Smallest dead time, above the cross-conduction limit
+* uint32_t  [in]  dtMax Largest dead time
+* uint32_t  [in]  step Change of a trial
+* uint32_t  [in]  settleWindows Windows skipped after a change, at least 1
+* uint32_t  [in]  holdWindows Windows skipped when no trial improves
+* uint32_t  [in]  maxSpread A window is not steady if the duty moves by more
+* float     [in]  maxDrift Trial discarded if the baseline mean duty moves by
+*                 more, in duty ticks
+* float     [in]  minGain Trial kept if the mean duty decreases by more, in
+*                 duty ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_DT_Init(XMC_DT_t* ptr,
+                                 uint32_t log2Window,
+                                 uint32_t rise,
+                                 uint32_t fall,
+                                 uint32_t dtMin,
+                                 uint32_t dtMax,
+                                 uint32_t step,
+                                 uint32_t settleWindows,
+                                 uint32_t holdWindows,
+                                 uint32_t maxSpread,
+                                 float maxDrift,
+                                 float minGain)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_Log2N     = (log2Window < XMC_DT_MAX_LOG2_WINDOW) ?
+                     log2Window : XMC_DT_MAX_LOG2_WINDOW;
+  ptr->m_Acc.m_Min = UINT32_MAX;
+  ptr->m_DtMin     = dtMin;
+  ptr->m_DtMax     = dtMax;
+  ptr->m_Step      = step;
+  ptr->m_Settle    = (settleWindows != 0U) ? settleWindows : 1U;
+  ptr->m_Hold      = holdWindows;
+  ptr->m_MaxSpread = maxSpread;
+  ptr->m_MaxDrift  = (uint32_t)(maxDrift * (float)(1UL << ptr->m_Log2N));
+  ptr->m_MinGain   = (uint32_t)(minGain * (float)(1UL << ptr->m_Log2N));
+  ptr->m_Value     = MIN(MAX(fall, dtMin), dtMax);
+  ptr->m_Dir       = -1;
+  ptr->m_Skip      = ptr->m_Settle;
+  ptr->m_Out[0]    = MIN(MAX(rise, dtMin), dtMax);
+  ptr->m_Out[1]    = ptr->m_Value;
+  ptr->m_Pending   = 1U;
+}
+
+/*******************************************************************************
+* Function Name: XMC_DT_Update
+********************************************************************************
+* Summary:
+* This function adds the duty written to the PWM to the current window. It is
+* called by the control ISR once per sample.
+*
+* Parameters:
+* XMC_DT_t* [in/out] ptr Pointer to the adaptive dead time structure
+* uint32_t  [in]  duty Duty of this sample
+*
+* Return:
+*  bool true when a window is finished, the background task can run
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_DT_Update(XMC_DT_t* ptr, uint32_t duty)
+{
+  XMC_DT_WINDOW_t* acc = &ptr->m_Acc;
+
+  acc->m_Sum += duty;
+  if (duty < acc->m_Min) acc->m_Min = duty;
+  if (duty > acc->m_Max) acc->m_Max = duty;
+
+  if (++ptr->m_Count < (1UL << ptr->m_Log2N))
+  {
+    return false;
+  }
+
+  /* Publish into the slot the reader is not pointed at, with the copy
+   * complete before m_Seq moves */
+  ptr->m_Slot[(ptr->m_Seq + 1U) & 1U] = *acc;
+  __DMB();
+  ptr->m_Seq++;
+
+  ptr->m_Count = 0;
+  acc->m_Sum   = 0;
+  acc->m_Min   = UINT32_MAX;
+  acc->m_Max   = 0;
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_DT_Apply
+********************************************************************************
+* Summary:
+* This function hands a falling edge dead time to the ISR and skips the
+* windows in which the loop settles.
+*
+* Parameters:
+* XMC_DT_t* [in/out] ptr Pointer to the adaptive dead time structure
+* uint32_t  [in]  value Falling edge dead time
+* uint32_t  [in]  skip Windows to skip
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_DT_Apply(XMC_DT_t* ptr, uint32_t value, uint32_t skip)
+{
+  ptr->m_Out[1] = value;
+  /* m_Out is not volatile, so the barrier keeps the store ahead of the flag
+   * the ISR polls */
+  __DMB();
+  ptr->m_Pending = 1U;
+  ptr->m_Skip    = skip;
+}
+
+/*******************************************************************************
+* Function Name: XMC_DT_Try
+********************************************************************************
+* Summary:
+* This function starts a trial from a baseline window. At the guard band, the
+* direction is reversed and the trial counts as rejected.
+*
+* Parameters:
+* XMC_DT_t* [in/out] ptr Pointer to the adaptive dead time structure
+* uint32_t  [in]  base Duty sum of the baseline window
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_DT_Try(XMC_DT_t* ptr, uint32_t base)
+{
+  uint32_t value = ptr->m_Value;
+
+  if (ptr->m_Dir > 0)
+  {
+    value = ((ptr->m_DtMax - value) > ptr->m_Step) ? (value + ptr->m_Step) : ptr->m_DtMax;
+  }
+  else
+  {
+    value = ((value - ptr->m_DtMin) > ptr->m_Step) ? (value - ptr->m_Step) : ptr->m_DtMin;
+  }
+
+  if (value == ptr->m_Value)
+  {
+    ptr->m_Dir = -ptr->m_Dir;
+    ptr->m_Fails++;
+    return;
+  }
+
+  ptr->m_Base       = base;
+  ptr->m_TrialValue = value;
+  ptr->m_Phase      = XMC_DT_TRIAL;
+  ptr->m_Trials++;
+  XMC_DT_Apply(ptr, value, ptr->m_Settle);
+}
+
+/*******************************************************************************
+* Function Name: XMC_DT_Converge
+********************************************************************************
+* Summary:
+* This function holds the dead time for a while once no trial in either
+* direction improves.
+*
+* Parameters:
+* XMC_DT_t* [in/out] ptr Pointer to the adaptive dead time structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_DT_Converge(XMC_DT_t* ptr)
+{
+  /* Both directions rejected */
+  if (ptr->m_Fails >= 2U)
+  {
+    ptr->m_Fails = 0;
+    ptr->m_Skip  = ptr->m_Hold;
+    ptr->m_Converged++;
+  }
+}
+
+/*******************************************************************************
+* Function Name: XMC_DT_Step
+********************************************************************************
+* Summary:
+* This function runs the optimizer on the latest finished window. It is
+* called by a background task after XMC_DT_Update returned true. A window
+* with a transient, or while the loop is not in steady regulation, ends the
+* trial and restores the baseline.
+*
+* Parameters:
+* XMC_DT_t* [in/out] ptr Pointer to the adaptive dead time structure
+* bool      [in]  steady false during a fault, burst mode or any other state
+*                 in which the duty is not set by the linear loop
+*
+* Return:
+*  bool true if new dead times are pending for the ISR
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_DT_Step(XMC_DT_t* ptr, bool steady)
+{
+  XMC_DT_WINDOW_t win;
+  uint32_t seq;
+  uint32_t drift;
+
+  /* The window is copied between the two m_Seq loads */
+  do
+  {
+    seq = ptr->m_Seq;
+    __DMB();
+    win = ptr->m_Slot[seq & 1U];
+    __DMB();
+  } while (seq != ptr->m_Seq);
+
+  if (seq == ptr->m_ReadSeq)
+  {
+    return false;
+  }
+  ptr->m_ReadSeq = seq;
+
+  if (!steady || ((win.m_Max - win.m_Min) > ptr->m_MaxSpread))
+  {
+    if (ptr->m_Phase != XMC_DT_BASE)
+    {
+      ptr->m_Discarded++;
+      ptr->m_Phase = XMC_DT_BASE;
+      XMC_DT_Apply(ptr, ptr->m_Value, ptr->m_Settle);
+      return true;
+    }
+    ptr->m_Skip = ptr->m_Settle;
+    return false;
+  }
+
+  if (ptr->m_Skip != 0U)
+  {
+    ptr->m_Skip--;
+    return false;
+  }
+
+  switch (ptr->m_Phase)
+  {
+    case XMC_DT_TRIAL:
+      ptr->m_Trial = win.m_Sum;
+      ptr->m_Phase = XMC_DT_CHECK;
+      XMC_DT_Apply(ptr, ptr->m_Value, ptr->m_Settle);
+      break;
+
+    case XMC_DT_CHECK:
+      ptr->m_Phase = XMC_DT_BASE;
+      drift = (win.m_Sum > ptr->m_Base) ? (win.m_Sum - ptr->m_Base) : (ptr->m_Base - win.m_Sum);
+      if (drift > ptr->m_MaxDrift)
+      {
+        /* The load or the input moved, this window is the next baseline */
+        ptr->m_Discarded++;
+        XMC_DT_Try(ptr, win.m_Sum);
+        break;
+      }
+
+      /* Trial below the mean of the two baselines by at least m_MinGain */
+      if ((2ULL * ptr->m_Trial) + (2ULL * ptr->m_MinGain) <
+          ((uint64_t)ptr->m_Base + win.m_Sum))
+      {
+        ptr->m_Value = ptr->m_TrialValue;
+        ptr->m_Fails = 0;
+        ptr->m_Accepted++;
+        XMC_DT_Apply(ptr, ptr->m_Value, ptr->m_Settle);
+        break;
+      }
+
+      ptr->m_Dir = -ptr->m_Dir;
+      ptr->m_Fails++;
+      XMC_DT_Converge(ptr);
+      if (ptr->m_Skip == 0U)
+      {
+        XMC_DT_Try(ptr, win.m_Sum);
+      }
+      break;
+
+    default:
+      XMC_DT_Try(ptr, win.m_Sum);
+      if (ptr->m_Phase == XMC_DT_BASE)
+      {
+        XMC_DT_Converge(ptr);
+      }
+      break;
+  }
+
+  return (ptr->m_Pending != 0U);
+}
+
+#endif /* #ifndef XMC_DEADTIME_H */
@@ -0,0 +1,165 @@
+/******************************************************************************
+* File Name:   xmc_feedforward.h
+*
+* Description: This file provides the input voltage feedforward. The duty from
+*              the compensator is scaled by Vnom/Vin, so the product of duty
+*              and input voltage, and with it the loop gain, does not change
+*              with the input voltage. A line step is corrected in the next PWM
+*              period instead of after it appears on the output voltage.
+*
+*              The reciprocal is read from a table built at initialization and
+*              interpolated linearly, so the ISR needs two multiplications and
+*              no division.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_FEEDFORWARD_H
+#define XMC_FEEDFORWARD_H
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#ifndef MIN
+/**< Minimum value  calculation macro */
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+/**< Fractional bits of the gain */
+#define XMC_FF_SHIFT              (14U)
+/**< The table has an entry every 2^XMC_FF_INDEX_SHIFT ADC counts */
+#define XMC_FF_INDEX_SHIFT        (5U)
+/**< Number of table entries for a 12-bit ADC, including the end point */
+#define XMC_FF_TABLE_SIZE         ((4096U >> XMC_FF_INDEX_SHIFT) + 1U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the feedforward table and limits
+ */
+typedef struct XMC_FF
+{
+  uint32_t            m_PwmMax;     /**< Largest duty */
+  uint32_t            m_Gain;       /**< Last gain applied, Q14 */
+  uint16_t            m_Table[XMC_FF_TABLE_SIZE];  /**< Vnom/Vin in Q14 */
+} XMC_FF_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_FF_Init
+********************************************************************************
+* Summary:
+* This API builds the reciprocal table. The gain is limited to maxGain, which
+* also applies while the input voltage is still low at startup, and so that
+* the scaled duty fits in 32 bits.
+*
+* Parameters:
+* XMC_FF_t* [out] ptr Pointer to the feedforward structure
+* uint32_t  [in]  vinNom Vin sample at the input voltage the compensator is
+*                 tuned for, at most 4095
+* float     [in]  maxGain Largest gain
+* uint32_t  [in]  pwmMax Largest duty
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_FF_Init(XMC_FF_t* ptr, uint32_t vinNom, float maxGain, uint32_t pwmMax)
+{
+  uint32_t i;
+  uint32_t gain;
+  uint32_t limit;
+
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_PwmMax = pwmMax;
+  ptr->m_Gain   = 1UL << XMC_FF_SHIFT;
+
+  limit = (uint32_t)(maxGain * (1UL << XMC_FF_SHIFT));
+  limit = MIN(limit, UINT16_MAX);
+  limit = MIN(limit, UINT32_MAX / (pwmMax + 1U));
+
+  ptr->m_Table[0] = (uint16_t)limit;
+  for (i = 1U; i < XMC_FF_TABLE_SIZE; i++)
+  {
+    gain = (vinNom << XMC_FF_SHIFT) / (i << XMC_FF_INDEX_SHIFT);
+    ptr->m_Table[i] = (uint16_t)MIN(gain, limit);
+  }
+}
+
+/*******************************************************************************
+* Function Name: XMC_FF_Scale
+********************************************************************************
+* Summary:
+* This function scales the duty by Vnom/Vin and limits it to the largest duty.
+* It is called from the control ISR after the compensator.
+*
+* Parameters:
+* XMC_FF_t* [in/out] ptr Pointer to the feedforward structure
+* uint32_t  [in]  duty Duty from the compensator
+* uint32_t  [in]  vin Input voltage sample in ADC counts
+*
+* Return:
+*  uint32_t Duty to write to the PWM
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_FF_Scale(XMC_FF_t* ptr, uint32_t duty, uint32_t vin)
+{
+  uint32_t idx;
+  uint32_t frac;
+  int32_t  g0;
+  int32_t  g1;
+  uint32_t gain;
+
+  vin  = MIN(vin, 4095U);
+  idx  = vin >> XMC_FF_INDEX_SHIFT;
+  frac = vin & ((1U << XMC_FF_INDEX_SHIFT) - 1U);
+  g0   = ptr->m_Table[idx];
+  g1   = ptr->m_Table[idx + 1U];
+
+  /* The table decreases, the interpolation step is negative */
+  gain = (uint32_t)(g0 + (((g1 - g0) * (int32_t)frac) >> XMC_FF_INDEX_SHIFT));
+  ptr->m_Gain = gain;
+
+  duty = (duty * gain) >> XMC_FF_SHIFT;
+
+  return MIN(duty, ptr->m_PwmMax);
+}
+
+#endif /* #ifndef XMC_FEEDFORWARD_H */
@@ -0,0 +1,195 @@
+/******************************************************************************
+* File Name:   xmc_predictor_fixed.h
+*
+* Description: This file provides the one-step-ahead predictor of the output
+*              voltage using fixed-point values. The duty computed from a
+*              sample only takes effect at the next shadow transfer, so the
+*              loop carries about one sample of delay. The predictor estimates
+*              the output voltage at that moment from the sample, the previous
+*              samples and the duties already applied, using an ARX model of
+*              the power stage in incremental form. The compensator then
+*              regulates the predicted value instead of the sample.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_PREDICTOR_FIXED_H
+#define XMC_PREDICTOR_FIXED_H
+
+#include <math.h>
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#ifndef MIN
+/**< Minimum value  calculation macro */
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+/**< Maximum value  calculation macro */
+#define MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+/**< Fractional bits of the predictor coefficients */
+#define XMC_PRED_SHIFT            (14)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the predictor model and history
+ *
+ * The model is y[n+1] - y[n] = A1*(y[n] - y[n-1]) + A2*(y[n-1] - y[n-2]) +
+ *                              B1*(u[n] - u[n-1]) + B2*(u[n-1] - u[n-2])
+ * with y the output voltage in ADC counts and u the applied duty in ticks.
+ * Constant terms such as the load current cancel in this form.
+ */
+typedef struct XMC_PRED_DATA_FIXED
+{
+  uint32_t            m_Out;        /**< Predicted sample, used as filter feedback */
+  int32_t             m_Max;        /**< Largest ADC value */
+  int32_t             m_A[2];       /**< Q14 */
+  int32_t             m_B[2];       /**< Q14, ADC counts per duty tick */
+  int32_t             m_Y[2];       /**< y[n-1], y[n-2] */
+  int32_t             m_U[3];       /**< u[n], u[n-1], u[n-2] */
+} XMC_PRED_DATA_FIXED_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_PRED_InitFixed
+********************************************************************************
+* Summary:
+* This API converts the model coefficients and fills the predictor structure.
+* The history is set to the given sample and duty, so the first prediction
+* equals the first sample.
+*
+* Parameters:
+* XMC_PRED_DATA_FIXED_t* [out] ptr Pointer to the predictor structure
+* float                  [in]  cA1 A1 model coefficient
+* float                  [in]  cA2 A2 model coefficient
+* float                  [in]  cB1 B1 model coefficient, ADC counts per tick
+* float                  [in]  cB2 B2 model coefficient, ADC counts per tick
+* uint32_t               [in]  y Initial sample
+* uint32_t               [in]  duty Initial duty
+* uint32_t               [in]  max Largest ADC value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PRED_InitFixed(XMC_PRED_DATA_FIXED_t* ptr,
+                                        float cA1,
+                                        float cA2,
+                                        float cB1,
+                                        float cB2,
+                                        uint32_t y,
+                                        uint32_t duty,
+                                        uint32_t max)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_A[0] = (int32_t)lroundf(cA1 * (1 << XMC_PRED_SHIFT));
+  ptr->m_A[1] = (int32_t)lroundf(cA2 * (1 << XMC_PRED_SHIFT));
+  ptr->m_B[0] = (int32_t)lroundf(cB1 * (1 << XMC_PRED_SHIFT));
+  ptr->m_B[1] = (int32_t)lroundf(cB2 * (1 << XMC_PRED_SHIFT));
+  ptr->m_Max  = (int32_t)max;
+
+  ptr->m_Out  = y;
+  ptr->m_Y[0] = ptr->m_Y[1] = (int32_t)y;
+  ptr->m_U[0] = ptr->m_U[1] = ptr->m_U[2] = (int32_t)duty;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PRED_PredictFixed
+********************************************************************************
+* Summary:
+* This function predicts the sample at the next shadow transfer and stores it
+* in m_Out. It is called from the control ISR before the compensator and
+* needs four multiplications.
+*
+* Parameters:
+* XMC_PRED_DATA_FIXED_t* [in/out] ptr Pointer to the predictor structure
+* uint32_t               [in]  y Latest sample in ADC counts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PRED_PredictFixed(XMC_PRED_DATA_FIXED_t* ptr, uint32_t y)
+{
+  int32_t acc;
+  int32_t yp;
+
+  acc  = ptr->m_A[0] * ((int32_t)y - ptr->m_Y[0]);
+  acc += ptr->m_A[1] * (ptr->m_Y[0] - ptr->m_Y[1]);
+  acc += ptr->m_B[0] * (ptr->m_U[0] - ptr->m_U[1]);
+  acc += ptr->m_B[1] * (ptr->m_U[1] - ptr->m_U[2]);
+
+  ptr->m_Y[1] = ptr->m_Y[0];
+  ptr->m_Y[0] = (int32_t)y;
+
+  yp = (int32_t)y + ((acc + (1 << (XMC_PRED_SHIFT - 1))) >> XMC_PRED_SHIFT);
+  yp = MAX(yp, 0);
+  yp = MIN(yp, ptr->m_Max);
+  ptr->m_Out = (uint32_t)yp;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PRED_ApplyFixed
+********************************************************************************
+* Summary:
+* This function records the duty written to the shadow register, which is
+* applied from the next PWM period. It must be called every ISR with the duty
+* actually written, also when the compensator did not compute it.
+*
+* Parameters:
+* XMC_PRED_DATA_FIXED_t* [in/out] ptr Pointer to the predictor structure
+* uint32_t               [in]  duty Duty written in this ISR
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PRED_ApplyFixed(XMC_PRED_DATA_FIXED_t* ptr, uint32_t duty)
+{
+  ptr->m_U[2] = ptr->m_U[1];
+  ptr->m_U[1] = ptr->m_U[0];
+  ptr->m_U[0] = (int32_t)duty;
+}
+
+#endif /* #ifndef XMC_PREDICTOR_FIXED_H */
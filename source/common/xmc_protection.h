@@ -0,0 +1,347 @@
+/******************************************************************************
+* File Name:   xmc_protection.h
+*
+* Description: This file provides the software protection layer of the
+*              converter. The control ISR checks every sample for overvoltage,
+*              overcurrent and a stuck ADC, and the duty for a value out of
+*              range. The checks have no loop and take the same time on every
+*              sample. A trip is latched until a background task restarts the
+*              converter after a delay; after too many restarts the fault
+*              stays latched until reset.
+*
+*              The shutdown itself is done by the PWM trap, which also serves
+*              the hardware comparators, see the control ISR files.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_PROTECTION_H
+#define XMC_PROTECTION_H
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+/* Bits of m_Fault */
+#define XMC_PROT_FAULT_OV           (0x01U) /**< Output overvoltage */
+#define XMC_PROT_FAULT_OC           (0x02U) /**< Inductor overcurrent */
+#define XMC_PROT_FAULT_STUCK        (0x04U) /**< ADC result frozen while the duty moves */
+#define XMC_PROT_FAULT_DUTY         (0x08U) /**< Duty out of range */
+#define XMC_PROT_FAULT_TRAP         (0x10U) /**< PWM trap input */
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Decision of the supervision task
+ */
+typedef enum XMC_PROT_ACTION
+{
+  XMC_PROT_RUN = 0,           /**< No fault */
+  XMC_PROT_WAIT,              /**< Fault latched, restart delay running */
+  XMC_PROT_RESTART,           /**< Restart the converter now */
+  XMC_PROT_LOCKED             /**< Restarts exhausted, fault stays latched */
+} XMC_PROT_ACTION_t;
+
+/**
+ * Structure defining the protection limits, state and counters
+ */
+typedef struct XMC_PROT
+{
+  uint32_t            m_OvLevel;      /**< Trip if Vout is above, in ADC counts */
+  uint32_t            m_OcLevel;      /**< Trip if the current is above, in ADC counts */
+  uint32_t            m_StuckDuty;    /**< Trip if the duty moves by this much... */
+  uint32_t            m_StuckSamples; /**< ...and Vout stays the same for this many samples */
+  uint32_t            m_DutyMax;      /**< Trip if the duty is above */
+  uint32_t            m_RestartDelay; /**< Supervision periods before a restart */
+  uint32_t            m_MaxRestarts;  /**< Restarts before the fault stays latched */
+  uint32_t            m_StablePeriods;/**< Supervision periods without fault that clear m_Restarts */
+  /* Written by the ISR */
+  uint32_t            m_Last;         /**< Previous Vout sample */
+  uint32_t            m_StuckCount;
+  uint32_t            m_Duty;         /**< Duty of the previous sample */
+  uint32_t            m_DutyMove;     /**< Duty moved since Vout last changed */
+  volatile uint32_t   m_Fault;        /**< Latched XMC_PROT_FAULT_xxx, 0 when running */
+  volatile uint32_t   m_Active;       /**< Limits exceeded by the latest sample while latched */
+  /* Written by the supervision task */
+  uint32_t            m_WaitCount;
+  uint32_t            m_StableCount;
+  uint32_t            m_Restarts;     /**< Restarts since the last stable run */
+  bool                m_Locked;
+  /* Counters for the supervision */
+  uint32_t            m_Trips;
+  uint32_t            m_LastFault;    /**< Cause of the latest trip */
+} XMC_PROT_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_PROT_Init
+********************************************************************************
+* Summary:
+* This API fills the protection structure. A check is disabled by a limit
+* that cannot be reached, for example ocLevel 0xFFFF without a current sense.
+*
+* Parameters:
+* XMC_PROT_t* [out] ptr Pointer to the protection structure
+* uint32_t    [in]  ovLevel Trip if Vout is above, in ADC counts
+* uint32_t    [in]  ocLevel Trip if the current is above, in ADC counts
+* uint32_t    [in]  stuckDuty Trip if the duty moves by this much in total...
+* uint32_t    [in]  stuckSamples ...and Vout then keeps the same value for
+*                   this many samples
+* uint32_t    [in]  dutyMax Trip if the duty is above
+* uint32_t    [in]  restartDelay Supervision periods before a restart
+* uint32_t    [in]  maxRestarts Restarts before the fault stays latched,
+*                   0 latches the first fault
+* uint32_t    [in]  stablePeriods Supervision periods without fault after
+*                   which the restarts are counted from 0 again
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PROT_Init(XMC_PROT_t* ptr,
+                                   uint32_t ovLevel,
+                                   uint32_t ocLevel,
+                                   uint32_t stuckDuty,
+                                   uint32_t stuckSamples,
+                                   uint32_t dutyMax,
+                                   uint32_t restartDelay,
+                                   uint32_t maxRestarts,
+                                   uint32_t stablePeriods)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_OvLevel       = ovLevel;
+  ptr->m_OcLevel       = ocLevel;
+  ptr->m_StuckSamples  = stuckSamples;
+  ptr->m_StuckDuty     = stuckDuty;
+  ptr->m_DutyMax       = dutyMax;
+  ptr->m_RestartDelay  = restartDelay;
+  ptr->m_MaxRestarts   = maxRestarts;
+  ptr->m_StablePeriods = stablePeriods;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PROT_CheckSample
+********************************************************************************
+* Summary:
+* This function checks the samples of one ISR against the limits. It is called
+* from the control ISR before the compensator. The ADC is taken as stuck when
+* the duty has moved by m_StuckDuty without any change of the Vout sample, and
+* Vout then keeps the same value for m_StuckSamples more samples. Such a duty
+* change moves the output of the power stage by many ADC counts within a few
+* PWM periods.
+*
+* Parameters:
+* XMC_PROT_t* [in/out] ptr Pointer to the protection structure
+* uint32_t    [in]  vout Output voltage sample in ADC counts
+* uint32_t    [in]  il Inductor current sample in ADC counts, 0 if not sensed
+*
+* Return:
+*  uint32_t XMC_PROT_FAULT_xxx bits, 0 if all limits are kept
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_PROT_CheckSample(XMC_PROT_t* ptr, uint32_t vout, uint32_t il)
+{
+  uint32_t fault = 0U;
+
+  if (vout != ptr->m_Last)
+  {
+    ptr->m_StuckCount = 0U;
+    ptr->m_DutyMove   = 0U;
+  }
+  else if (ptr->m_DutyMove >= ptr->m_StuckDuty)
+  {
+    ptr->m_StuckCount++;
+  }
+  ptr->m_Last = vout;
+
+  if (vout > ptr->m_OvLevel) fault |= XMC_PROT_FAULT_OV;
+  if (il > ptr->m_OcLevel) fault |= XMC_PROT_FAULT_OC;
+  if (ptr->m_StuckCount >= ptr->m_StuckSamples) fault |= XMC_PROT_FAULT_STUCK;
+
+  return fault;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PROT_CheckDuty
+********************************************************************************
+* Summary:
+* This function checks the duty computed by the control ISR before it is
+* written to the PWM, and adds its change to the stuck ADC detection.
+*
+* Parameters:
+* XMC_PROT_t* [in/out] ptr Pointer to the protection structure
+* uint32_t    [in] duty Duty of the next PWM cycle
+*
+* Return:
+*  uint32_t XMC_PROT_FAULT_DUTY if the duty is out of range, else 0
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_PROT_CheckDuty(XMC_PROT_t* ptr, uint32_t duty)
+{
+  ptr->m_DutyMove += (duty > ptr->m_Duty) ? (duty - ptr->m_Duty) : (ptr->m_Duty - duty);
+  ptr->m_Duty      = duty;
+
+  return (duty > ptr->m_DutyMax) ? XMC_PROT_FAULT_DUTY : 0U;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PROT_Trip
+********************************************************************************
+* Summary:
+* This function latches a fault. It is called from the control ISR after the
+* PWM outputs are shut down. From then on, the ISR must not run the
+* compensator, so the supervision task can reset it before the restart.
+*
+* Parameters:
+* XMC_PROT_t* [in/out] ptr Pointer to the protection structure
+* uint32_t    [in]  fault XMC_PROT_FAULT_xxx bits
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PROT_Trip(XMC_PROT_t* ptr, uint32_t fault)
+{
+  ptr->m_LastFault  = fault;
+  ptr->m_Trips++;
+  ptr->m_Active     = fault & (XMC_PROT_FAULT_OV | XMC_PROT_FAULT_OC);
+  ptr->m_Fault      = fault;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PROT_Observe
+********************************************************************************
+* Summary:
+* This function checks the voltage and current limits while a fault is
+* latched. It is called from the control ISR instead of XMC_PROT_CheckSample,
+* so the supervision task does not restart into an overvoltage or an
+* overcurrent.
+*
+* Parameters:
+* XMC_PROT_t* [in/out] ptr Pointer to the protection structure
+* uint32_t    [in]  vout Output voltage sample in ADC counts
+* uint32_t    [in]  il Inductor current sample in ADC counts, 0 if not sensed
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PROT_Observe(XMC_PROT_t* ptr, uint32_t vout, uint32_t il)
+{
+  ptr->m_Active = ((vout > ptr->m_OvLevel) ? XMC_PROT_FAULT_OV : 0U) |
+                  ((il > ptr->m_OcLevel) ? XMC_PROT_FAULT_OC : 0U);
+  ptr->m_Last   = vout;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PROT_Supervise
+********************************************************************************
+* Summary:
+* This function runs the restart policy. It is called periodically from the
+* main context. A latched fault is restarted after m_RestartDelay periods, once
+* the voltage and current are back inside the limits. After m_MaxRestarts
+* restarts without a stable run of m_StablePeriods in between, the fault stays
+* latched.
+*
+* Parameters:
+* XMC_PROT_t* [in/out] ptr Pointer to the protection structure
+*
+* Return:
+*  XMC_PROT_ACTION_t XMC_PROT_RESTART when the caller must reset the control
+*  state and call XMC_PROT_Release
+*
+*******************************************************************************/
+__STATIC_INLINE XMC_PROT_ACTION_t XMC_PROT_Supervise(XMC_PROT_t* ptr)
+{
+  if (ptr->m_Fault == 0U)
+  {
+    ptr->m_WaitCount = 0U;
+    if ((ptr->m_Restarts != 0U) && (++ptr->m_StableCount >= ptr->m_StablePeriods))
+    {
+      ptr->m_Restarts = 0U;
+    }
+    return XMC_PROT_RUN;
+  }
+
+  ptr->m_StableCount = 0U;
+  if (ptr->m_Restarts >= ptr->m_MaxRestarts)
+  {
+    ptr->m_Locked = true;
+    return XMC_PROT_LOCKED;
+  }
+
+  if (ptr->m_WaitCount < ptr->m_RestartDelay)
+  {
+    ptr->m_WaitCount++;
+  }
+  if ((ptr->m_WaitCount < ptr->m_RestartDelay) || (ptr->m_Active != 0U))
+  {
+    return XMC_PROT_WAIT;
+  }
+
+  ptr->m_WaitCount = 0U;
+  ptr->m_Restarts++;
+  return XMC_PROT_RESTART;
+}
+
+/*******************************************************************************
+* Function Name: XMC_PROT_Release
+********************************************************************************
+* Summary:
+* This function clears the latched fault, after the supervision task has reset
+* the control state and the PWM trap. The control ISR runs the compensator
+* again from the next sample.
+*
+* Parameters:
+* XMC_PROT_t* [in/out] ptr Pointer to the protection structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_PROT_Release(XMC_PROT_t* ptr)
+{
+  ptr->m_StuckCount = 0U;
+  ptr->m_DutyMove   = 0U;
+  ptr->m_Duty       = 0U;
+  ptr->m_Fault      = 0U;
+}
+
+#endif /* #ifndef XMC_PROTECTION_H */
@@ -0,0 +1,264 @@
+/******************************************************************************
+* File Name:   xmc_reg_stats.h
+*
+* Description: This file provides incremental regulation statistics computed
+*              in-line by the control ISR: output voltage mean, RMS ripple,
+*              peak-to-peak, and error mean and variance over windows of
+*              2^n samples.
+*
+*              The ISR only adds to power-of-two window accumulators, with no
+*              division. A finished window is handed over to the main context
+*              through two slots and a sequence counter, without locking.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_REG_STATS_H
+#define XMC_REG_STATS_H
+
+#include <math.h>
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+/**< Largest supported window, 2^12 samples keeps all sums inside 64 bits */
+#define XMC_STATS_MAX_LOG2_WINDOW   (12U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the accumulators of one window
+ */
+typedef struct XMC_STATS_WINDOW
+{
+  uint32_t            m_SumV;       /**< Sum of Vout samples */
+  uint64_t            m_SumV2;      /**< Sum of squared Vout samples */
+  uint32_t            m_MinV;
+  uint32_t            m_MaxV;
+  int32_t             m_SumE;       /**< Sum of error samples */
+  uint64_t            m_SumE2;      /**< Sum of squared error samples */
+} XMC_STATS_WINDOW_t;
+
+/**
+ * Structure defining the statistics state shared by the ISR and main context
+ */
+typedef struct XMC_STATS
+{
+  XMC_STATS_WINDOW_t  m_Acc;        /**< Window being accumulated by the ISR */
+  uint32_t            m_Count;
+  uint32_t            m_Log2N;      /**< Window length is 2^m_Log2N samples */
+  XMC_STATS_WINDOW_t  m_Slot[2];    /**< Finished windows */
+  volatile uint32_t   m_Seq;        /**< Finished windows, m_Slot[m_Seq & 1] is the latest */
+} XMC_STATS_t;
+
+/**
+ * Structure defining the statistics of a finished window, in ADC counts
+ */
+typedef struct XMC_STATS_RESULT
+{
+  uint32_t            m_Seq;        /**< Window number, 0 if none finished yet */
+  float               m_MeanV;
+  float               m_RippleRms;  /**< Standard deviation of Vout */
+  uint32_t            m_PeakPeak;
+  float               m_MeanE;
+  float               m_VarE;
+} XMC_STATS_RESULT_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_STATS_Reset
+********************************************************************************
+* Summary:
+* This function clears the accumulators for a new window.
+*
+* Parameters:
+* XMC_STATS_WINDOW_t* [out] pWin Pointer to the window accumulators
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_STATS_Reset(XMC_STATS_WINDOW_t* pWin)
+{
+  memset(pWin, 0, sizeof(*pWin));
+  pWin->m_MinV = UINT32_MAX;
+}
+
+/*******************************************************************************
+* Function Name: XMC_STATS_Init
+********************************************************************************
+* Summary:
+* This API resets the statistics and sets the window length.
+*
+* Parameters:
+* XMC_STATS_t* [out] ptr Pointer to the statistics structure
+* uint32_t     [in]  log2Window Window length as a power of two, at most
+*                    XMC_STATS_MAX_LOG2_WINDOW
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_STATS_Init(XMC_STATS_t* ptr, uint32_t log2Window)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_Log2N = (log2Window < XMC_STATS_MAX_LOG2_WINDOW) ?
+                 log2Window : XMC_STATS_MAX_LOG2_WINDOW;
+  XMC_STATS_Reset(&ptr->m_Acc);
+}
+
+/*******************************************************************************
+* Function Name: XMC_STATS_Update
+********************************************************************************
+* Summary:
+* This function adds one sample to the current window. It is called from the
+* control ISR and uses only additions, two multiplications and two compares,
+* plus a copy of the accumulators once per window.
+*
+* Parameters:
+* XMC_STATS_t* [in/out] ptr Pointer to the statistics structure
+* uint32_t     [in]  vout Output voltage sample in ADC counts
+* int32_t      [in]  err Regulation error in ADC counts
+*
+* Return:
+*  bool true if this sample finished a window
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_STATS_Update(XMC_STATS_t* ptr, uint32_t vout, int32_t err)
+{
+  XMC_STATS_WINDOW_t* acc = &ptr->m_Acc;
+
+  acc->m_SumV  += vout;
+  acc->m_SumV2 += vout * vout;
+  acc->m_SumE  += err;
+  acc->m_SumE2 += (uint32_t)(err * err);
+  if (vout < acc->m_MinV) acc->m_MinV = vout;
+  if (vout > acc->m_MaxV) acc->m_MaxV = vout;
+
+  if (++ptr->m_Count < (1UL << ptr->m_Log2N))
+  {
+    return false;
+  }
+
+  /* Publish into the slot the reader is not pointed at. m_Slot is not
+   * volatile, so the barrier keeps the copy before the m_Seq store */
+  ptr->m_Slot[(ptr->m_Seq + 1U) & 1U] = *acc;
+  __DMB();
+  ptr->m_Seq++;
+
+  ptr->m_Count = 0;
+  XMC_STATS_Reset(acc);
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_STATS_Variance
+********************************************************************************
+* Summary:
+* This function computes a population variance from a sum and a sum of squares
+* over 2^log2N samples. The numerator is formed exactly in 64 bits to avoid
+* cancellation in float.
+*
+* Parameters:
+* int64_t  [in] sum Sum of the samples
+* uint64_t [in] sum2 Sum of the squared samples
+* uint32_t [in] log2N Window length as a power of two
+*
+* Return:
+*  float Variance
+*
+*******************************************************************************/
+__STATIC_INLINE float XMC_STATS_Variance(int64_t sum, uint64_t sum2, uint32_t log2N)
+{
+  uint64_t num;
+
+  /* n*sum2 - sum^2 >= 0 by Cauchy-Schwarz */
+  num = (sum2 << log2N) - (uint64_t)(sum * sum);
+
+  return (float)num / (float)(1ULL << (2U * log2N));
+}
+
+/*******************************************************************************
+* Function Name: XMC_STATS_Read
+********************************************************************************
+* Summary:
+* This function computes the statistics of the latest finished window. It is
+* called from the main context. The copy is retried if the ISR published a new
+* window meanwhile.
+*
+* Parameters:
+* XMC_STATS_t*        [in]  ptr Pointer to the statistics structure
+* XMC_STATS_RESULT_t* [out] pRes Pointer to the result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_STATS_Read(XMC_STATS_t* ptr, XMC_STATS_RESULT_t* pRes)
+{
+  XMC_STATS_WINDOW_t win;
+  uint32_t seq;
+  uint32_t log2N = ptr->m_Log2N;
+  float n = (float)(1UL << log2N);
+
+  /* The barriers keep the copy between the two m_Seq loads */
+  do
+  {
+    seq = ptr->m_Seq;
+    __DMB();
+    win = ptr->m_Slot[seq & 1U];
+    __DMB();
+  } while (seq != ptr->m_Seq);
+
+  pRes->m_Seq = seq;
+  if (seq == 0U)
+  {
+    return;
+  }
+
+  pRes->m_MeanV     = (float)win.m_SumV / n;
+  pRes->m_RippleRms = sqrtf(XMC_STATS_Variance(win.m_SumV, win.m_SumV2, log2N));
+  pRes->m_PeakPeak  = win.m_MaxV - win.m_MinV;
+  pRes->m_MeanE     = (float)win.m_SumE / n;
+  pRes->m_VarE      = XMC_STATS_Variance(win.m_SumE, win.m_SumE2, log2N);
+}
+
+#endif /* #ifndef XMC_REG_STATS_H */
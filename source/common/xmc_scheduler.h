@@ -0,0 +1,389 @@
+/******************************************************************************
+* File Name:   xmc_scheduler.h
+*
+* Description: This file provides a cooperative run-to-completion scheduler
+*              for the background (main) context. Tasks are either periodic,
+*              driven by the SysTick time base, or event-driven, posted from
+*              an ISR. The core sleeps with WFI when no task is ready.
+*
+*              The control ISR always preempts the background tasks, so the
+*              scheduler never adds jitter to the regulator. Every task has
+*              a cycle budget; the scheduler records the runtime of each task
+*              and the idle percentage of the background context.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_SCHEDULER_H
+#define XMC_SCHEDULER_H
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#ifndef MIN
+/**< Minimum value  calculation macro */
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+/**< Maximum value  calculation macro */
+#define MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+/**< Maximum number of background tasks */
+#define XMC_SCHED_MAX_TASKS         (8U)
+/**< Frequency of the SysTick time base in Hz */
+#define XMC_SCHED_TICK_HZ           (1000U)
+/**< Length of the statistics window in ticks */
+#define XMC_SCHED_STATS_WINDOW      (1000U)
+/**< Period value of an event-driven task */
+#define XMC_SCHED_EVENT_ONLY        (0U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Background task function. Must run to completion within its budget.
+ */
+typedef void (*XMC_SCHED_TASK_FN_t)(void);
+
+/**
+ * Structure defining a background task and its runtime statistics
+ */
+typedef struct XMC_SCHED_TASK
+{
+  XMC_SCHED_TASK_FN_t m_Fn;
+  uint32_t            m_Period;     /**< Period in ticks, 0 for event-only */
+  uint32_t            m_Next;       /**< Tick of the next periodic release */
+  uint32_t            m_Budget;     /**< Allowed runtime in CPU cycles */
+  volatile uint8_t    m_Event;      /**< Set by XMC_SCHED_Post */
+  uint32_t            m_Runs;
+  uint32_t            m_Overruns;   /**< Runs exceeding m_Budget */
+  uint32_t            m_LastCycles;
+  uint32_t            m_MaxCycles;
+  uint32_t            m_WinCycles;  /**< Runtime in the current window */
+  uint32_t            m_Load;       /**< Load of last window in 0.01 % */
+} XMC_SCHED_TASK_t;
+
+/**
+ * Structure defining the scheduler state
+ */
+typedef struct XMC_SCHED
+{
+  XMC_SCHED_TASK_t    m_Task[XMC_SCHED_MAX_TASKS];
+  uint32_t            m_NumTasks;
+  volatile uint32_t   m_Tick;       /**< Incremented by XMC_SCHED_Tick */
+  volatile uint8_t    m_Wake;       /**< Set by a tick or a post, cleared by XMC_SCHED_RunOnce */
+  uint32_t            m_Reload;     /**< SysTick cycles per tick */
+  uint32_t            m_WinStart;   /**< Cycle stamp of window start */
+  uint32_t            m_WinTick;    /**< Tick of window start */
+  uint32_t            m_WinBusy;    /**< Task cycles in the current window */
+  uint32_t            m_Idle;       /**< Idle of last window in 0.01 % */
+} XMC_SCHED_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_Init
+********************************************************************************
+* Summary:
+* This API resets the scheduler and starts the SysTick time base. The SysTick
+* interrupt is given the lowest priority so it never delays the control ISR.
+*
+* Parameters:
+* XMC_SCHED_t* [out] ptr Pointer to the scheduler structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_SCHED_Init(XMC_SCHED_t* ptr)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_Reload = SystemCoreClock / XMC_SCHED_TICK_HZ;
+  ptr->m_Idle   = 10000U;
+
+  (void)SysTick_Config(ptr->m_Reload);
+  NVIC_SetPriority(SysTick_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_Tick
+********************************************************************************
+* Summary:
+* This function advances the time base. Call it from SysTick_Handler.
+*
+* Parameters:
+* XMC_SCHED_t* [in/out] ptr Pointer to the scheduler structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_SCHED_Tick(XMC_SCHED_t* ptr)
+{
+  ptr->m_Tick++;
+  ptr->m_Wake = 1U;
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_Cycles
+********************************************************************************
+* Summary:
+* This function returns a free running CPU cycle stamp built from the tick
+* counter and the SysTick down counter. Only differences are meaningful.
+*
+* Parameters:
+* XMC_SCHED_t* [in] ptr Pointer to the scheduler structure
+*
+* Return:
+*  uint32_t Cycle stamp
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_SCHED_Cycles(XMC_SCHED_t* ptr)
+{
+  uint32_t tick;
+  uint32_t val;
+
+  /* Re-read if the tick advanced while sampling the down counter */
+  do
+  {
+    tick = ptr->m_Tick;
+    val  = SysTick->VAL;
+  } while (tick != ptr->m_Tick);
+
+  return (tick * ptr->m_Reload) + (ptr->m_Reload - 1U - val);
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_AddTask
+********************************************************************************
+* Summary:
+* This API registers a background task. Tasks are served in the order they
+* are added, so the most urgent task should be added first.
+*
+* Parameters:
+* XMC_SCHED_t*        [in/out] ptr Pointer to the scheduler structure
+* XMC_SCHED_TASK_FN_t [in]  fn Task function
+* uint32_t            [in]  period Period in ticks or XMC_SCHED_EVENT_ONLY
+* uint32_t            [in]  budget Allowed runtime in CPU cycles
+*
+* Return:
+*  int Task id to be used with XMC_SCHED_Post, -1 if the table is full
+*
+*******************************************************************************/
+__STATIC_INLINE int XMC_SCHED_AddTask(XMC_SCHED_t* ptr,
+                                      XMC_SCHED_TASK_FN_t fn,
+                                      uint32_t period,
+                                      uint32_t budget)
+{
+  XMC_SCHED_TASK_t* task;
+
+  if (ptr->m_NumTasks >= XMC_SCHED_MAX_TASKS)
+  {
+    return -1;
+  }
+
+  task = &ptr->m_Task[ptr->m_NumTasks];
+  task->m_Fn     = fn;
+  task->m_Period = period;
+  task->m_Next   = ptr->m_Tick + period;
+  task->m_Budget = budget;
+
+  return (int)ptr->m_NumTasks++;
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_Post
+********************************************************************************
+* Summary:
+* This function releases a task once. It is two byte stores and is safe to
+* call from any ISR.
+*
+* Parameters:
+* XMC_SCHED_t* [in/out] ptr Pointer to the scheduler structure
+* int          [in]  id Task id returned by XMC_SCHED_AddTask
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_SCHED_Post(XMC_SCHED_t* ptr, int id)
+{
+  ptr->m_Task[id].m_Event = 1U;
+  ptr->m_Wake = 1U;
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_IsReady
+********************************************************************************
+* Summary:
+* This function checks whether a task is released by an event or its period.
+*
+* Parameters:
+* XMC_SCHED_t*      [in] ptr Pointer to the scheduler structure
+* XMC_SCHED_TASK_t* [in] task Pointer to the task
+*
+* Return:
+*  bool true if the task must run
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_SCHED_IsReady(XMC_SCHED_t* ptr, XMC_SCHED_TASK_t* task)
+{
+  if (task->m_Event != 0U)
+  {
+    return true;
+  }
+
+  return (task->m_Period != XMC_SCHED_EVENT_ONLY) &&
+         ((int32_t)(ptr->m_Tick - task->m_Next) >= 0);
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_UpdateStats
+********************************************************************************
+* Summary:
+* This function closes the statistics window once it has elapsed and computes
+* the per task load and the idle percentage, both in 0.01 % units.
+*
+* Parameters:
+* XMC_SCHED_t* [in/out] ptr Pointer to the scheduler structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_SCHED_UpdateStats(XMC_SCHED_t* ptr)
+{
+  uint32_t now;
+  uint32_t total;
+  uint32_t i;
+
+  if ((ptr->m_Tick - ptr->m_WinTick) < XMC_SCHED_STATS_WINDOW)
+  {
+    return;
+  }
+
+  now   = XMC_SCHED_Cycles(ptr);
+  total = (now - ptr->m_WinStart) / 10000U;
+  if (total == 0U)
+  {
+    total = 1U;
+  }
+
+  for (i = 0U; i < ptr->m_NumTasks; i++)
+  {
+    ptr->m_Task[i].m_Load      = ptr->m_Task[i].m_WinCycles / total;
+    ptr->m_Task[i].m_WinCycles = 0U;
+  }
+
+  ptr->m_Idle     = 10000U - MIN(ptr->m_WinBusy / total, 10000U);
+  ptr->m_WinBusy  = 0U;
+  ptr->m_WinStart = now;
+  ptr->m_WinTick  = ptr->m_Tick;
+}
+
+/*******************************************************************************
+* Function Name: XMC_SCHED_RunOnce
+********************************************************************************
+* Summary:
+* This function runs every ready task once, in registration order, and then
+* sleeps until the next interrupt if nothing else became ready. A tick or a
+* post after the scan started sets m_Wake, so only the test of m_Wake and the
+* WFI are done with interrupts masked, and a wake-up event can not be lost
+* between them.
+*
+* Parameters:
+* XMC_SCHED_t* [in/out] ptr Pointer to the scheduler structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_SCHED_RunOnce(XMC_SCHED_t* ptr)
+{
+  XMC_SCHED_TASK_t* task;
+  uint32_t start;
+  uint32_t cycles;
+  uint32_t i;
+
+  /* Cleared before the scan: a release the scan can miss sets it again */
+  ptr->m_Wake = 0U;
+
+  for (i = 0U; i < ptr->m_NumTasks; i++)
+  {
+    task = &ptr->m_Task[i];
+    if (!XMC_SCHED_IsReady(ptr, task))
+    {
+      continue;
+    }
+
+    /* Consume the release before running, so a post during the run is kept */
+    task->m_Event = 0U;
+    if (task->m_Period != XMC_SCHED_EVENT_ONLY)
+    {
+      task->m_Next = ptr->m_Tick + task->m_Period;
+    }
+
+    start = XMC_SCHED_Cycles(ptr);
+    task->m_Fn();
+    cycles = XMC_SCHED_Cycles(ptr) - start;
+
+    task->m_Runs++;
+    task->m_LastCycles = cycles;
+    task->m_MaxCycles  = MAX(task->m_MaxCycles, cycles);
+    task->m_WinCycles += cycles;
+    ptr->m_WinBusy    += cycles;
+    if (cycles > task->m_Budget)
+    {
+      task->m_Overruns++;
+    }
+  }
+
+  XMC_SCHED_UpdateStats(ptr);
+
+  __disable_irq();
+  if (ptr->m_Wake == 0U)
+  {
+    /* WFI with PRIMASK set is intended: a pending interrupt still wakes the
+       core, and it is taken right after __enable_irq() */
+    __WFI();
+  }
+  __enable_irq();
+}
+
+#endif /* #ifndef XMC_SCHEDULER_H */
@@ -0,0 +1,897 @@
+/******************************************************************************
+* File Name:   xmc_trace.h
+*
+* Description: This file provides the trace format of the control loop: a
+*              stream of delta-encoded records of the ADC sample and the duty
+*              of each recorded control period, with events, after a 72-byte
+*              header that describes the loop. The control ISR records into a
+*              ring buffer with a few cycles per sample. The stream is read
+*              out in the main context, for example over the command channel.
+*              The decoder runs on the host on memory-mapped files. Periodic
+*              sync records let it start anywhere in the stream and recover
+*              after lost data.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_TRACE_H
+#define XMC_TRACE_H
+
+#include "xmc_cmd.h"
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#define XMC_TRACE_VERSION           (1U)
+#define XMC_TRACE_HEADER_SIZE       (72U)
+
+/* Stream format. Varints are 7 bits per byte, low group first, with bit 7 set
+ * in all bytes but the last; zz is the zigzag mapping of a signed value to a
+ * varint.
+ *
+ *   0x00..0x7F Short sample: bits 6..4 ADC delta -4..3, bits 3..0 duty delta -8..7
+ *   0x80       Sample: zz ADC delta, zz duty delta
+ *   0x81       Event: id, varint periods since the last sample, zz value
+ *   0x82       Sync: 0x5A, varint time, varint ADC, varint duty, check byte
+ *   0x83       Parameters: XMC_CMD_PARAM_COUNT floats
+ *
+ * A sample is one decimation step after the previous one. A sync is a sample
+ * with absolute values and the time in control periods, modulo 2^32. It is
+ * written first, every sync interval and after lost records. The check byte
+ * is the inverted XOR of the sync bytes before it. The records of a control
+ * period come in the order sample, events, parameters. */
+#define XMC_TRACE_TAG_SAMPLE        (0x80U)
+#define XMC_TRACE_TAG_EVENT         (0x81U)
+#define XMC_TRACE_TAG_SYNC          (0x82U)
+#define XMC_TRACE_TAG_PARAM         (0x83U)
+#define XMC_TRACE_SYNC_MARK         (0x5AU)
+/**< Longest sample, event or sync record */
+#define XMC_TRACE_RECORD_MAX        (16U)
+#define XMC_TRACE_PARAM_SIZE        (1U + (4U * XMC_CMD_PARAM_COUNT))
+
+/* Bits of XMC_TRACE_HEADER_t m_Flags, the features of the recording target.
+ * With the first three, the recorded duty is not the compensator output. */
+#define XMC_TRACE_FLAG_CURRENT_MODE     (0x01U)
+#define XMC_TRACE_FLAG_PREDICTOR        (0x02U)
+#define XMC_TRACE_FLAG_FEEDFORWARD      (0x04U)
+#define XMC_TRACE_FLAG_BURST            (0x10U)
+#define XMC_TRACE_FLAG_PROTECTION       (0x20U)
+#define XMC_TRACE_FLAG_NOT_REPLAYABLE   (0x07U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Events. They belong to the control period of the preceding sample when
+ * their period count is 0.
+ */
+typedef enum XMC_TRACE_EVENT
+{
+  XMC_TRACE_EV_FAULT = 1,     /**< PWM shut down, value XMC_PROT_FAULT_xxx. The
+                                   compensator ran in this period only for
+                                   XMC_PROT_FAULT_DUTY alone */
+  XMC_TRACE_EV_RESTART,       /**< Compensator preset with value before this period */
+  XMC_TRACE_EV_BURST_ENTER,   /**< Compensator frozen from the next period */
+  XMC_TRACE_EV_BURST_EXIT,    /**< Compensator preset with value before this period */
+  XMC_TRACE_EV_TUNE,          /**< Parameters record follows, taken before this
+                                   period, value is the update count */
+  XMC_TRACE_EV_DROP           /**< Records lost before the next sync */
+} XMC_TRACE_EVENT_t;
+
+/**
+ * Loop description stored in the header
+ */
+typedef struct XMC_TRACE_HEADER
+{
+  uint8_t             m_Kit;        /**< UC_FAMILY of the target */
+  uint8_t             m_Backend;    /**< XMC_COMP_BACKEND of the voltage loop */
+  uint8_t             m_Flags;      /**< XMC_TRACE_FLAG_xxx */
+  uint8_t             m_AwMode;     /**< Anti-windup of the voltage loop */
+  uint8_t             m_AwShift;    /**< Back-calculation of the fixed point filter */
+  float               m_AwGain;     /**< Back-calculation of the float filter */
+  uint32_t            m_PeriodNs;   /**< Control period */
+  uint32_t            m_Decimation; /**< Control periods per recorded sample */
+  float               m_Param[XMC_CMD_PARAM_COUNT];  /**< Parameters at the start */
+} XMC_TRACE_HEADER_t;
+
+/**
+ * Structure defining the recorder and its ring buffer. The ring holds whole
+ * records only; when it is full, recording stops until the reader has
+ * emptied it, then restarts with a sync.
+ */
+typedef struct XMC_TRACE
+{
+  uint8_t*            m_pBuf;
+  uint32_t            m_Mask;       /**< Ring size - 1, the size is a power of two */
+  volatile uint32_t   m_Head;       /**< Written by the recording ISR */
+  volatile uint32_t   m_Tail;       /**< Written by the reader */
+  uint32_t            m_Decimation;
+  uint32_t            m_Count;      /**< Periods to the next recorded sample */
+  uint32_t            m_SyncInterval;
+  uint32_t            m_ToSync;     /**< Samples to the next sync */
+  uint32_t            m_Time;       /**< Current control period */
+  uint32_t            m_LastTime;   /**< Period of the last recorded sample */
+  uint32_t            m_Adc;
+  uint32_t            m_Duty;
+  bool                m_Overflow;
+  uint32_t            m_Lost;       /**< Records lost since the last sync */
+  /* Counters for the supervision */
+  uint32_t            m_Samples;
+  uint32_t            m_LostTotal;
+  uint8_t             m_Header[XMC_TRACE_HEADER_SIZE];
+} XMC_TRACE_t;
+
+/**
+ * Kind of a decoded record
+ */
+typedef enum XMC_TRACE_REC
+{
+  XMC_TRACE_REC_END = 0,      /**< End of the data */
+  XMC_TRACE_REC_SAMPLE,
+  XMC_TRACE_REC_EVENT,
+  XMC_TRACE_REC_PARAM
+} XMC_TRACE_REC_t;
+
+/**
+ * Decoded record
+ */
+typedef struct XMC_TRACE_RECORD
+{
+  uint64_t            m_Time;       /**< Control period */
+  uint32_t            m_Adc;
+  uint32_t            m_Duty;
+  bool                m_Sync;       /**< Sample from a sync, the time may jump */
+  uint8_t             m_Event;      /**< XMC_TRACE_EVENT_t */
+  int32_t             m_Value;
+  float               m_Param[XMC_CMD_PARAM_COUNT];
+} XMC_TRACE_RECORD_t;
+
+/**
+ * Structure defining the decoder of a stream in memory
+ */
+typedef struct XMC_TRACE_DECODER
+{
+  const uint8_t*      m_pData;
+  size_t              m_Size;
+  size_t              m_Pos;
+  uint32_t            m_Decimation;
+  bool                m_Synced;
+  bool                m_HaveTime;   /**< m_Time is unwrapped from the start */
+  uint64_t            m_Time;       /**< Period of the last sample */
+  uint64_t            m_EventTime;  /**< Period of the last event */
+  uint32_t            m_Adc;
+  uint32_t            m_Duty;
+  uint64_t            m_Skipped;    /**< Bytes skipped looking for a sync */
+  uint32_t            m_Errors;     /**< Invalid records */
+} XMC_TRACE_DECODER_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_PutHeader
+********************************************************************************
+* Summary:
+* This function writes the 72-byte header: "XTRC", version, kit, backend,
+* flags, anti-windup mode and shift, 2 reserved bytes, the period, the
+* decimation, the anti-windup gain, the parameters and 4 reserved bytes.
+*
+* Parameters:
+* uint8_t*                  [out] pBuf XMC_TRACE_HEADER_SIZE bytes
+* const XMC_TRACE_HEADER_t* [in]  pHeader Loop description
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_PutHeader(uint8_t* pBuf, const XMC_TRACE_HEADER_t* pHeader)
+{
+  uint32_t i;
+
+  memset(pBuf, 0, XMC_TRACE_HEADER_SIZE);
+  memcpy(pBuf, "XTRC", 4U);
+  pBuf[4] = XMC_TRACE_VERSION;
+  pBuf[5] = pHeader->m_Kit;
+  pBuf[6] = pHeader->m_Backend;
+  pBuf[7] = pHeader->m_Flags;
+  pBuf[8] = pHeader->m_AwMode;
+  pBuf[9] = pHeader->m_AwShift;
+  XMC_CMD_PutU32(&pBuf[12], pHeader->m_PeriodNs);
+  XMC_CMD_PutU32(&pBuf[16], pHeader->m_Decimation);
+  XMC_CMD_PutFloat(&pBuf[20], pHeader->m_AwGain);
+  for (i = 0U; i < XMC_CMD_PARAM_COUNT; i++)
+  {
+    XMC_CMD_PutFloat(&pBuf[24U + (4U * i)], pHeader->m_Param[i]);
+  }
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_GetHeader
+********************************************************************************
+* Summary:
+* This function reads a header written by XMC_TRACE_PutHeader.
+*
+* Parameters:
+* const uint8_t*      [in]  pBuf XMC_TRACE_HEADER_SIZE bytes
+* XMC_TRACE_HEADER_t* [out] pHeader Loop description
+*
+* Return:
+*  bool false if this is not a trace of this version
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_GetHeader(const uint8_t* pBuf, XMC_TRACE_HEADER_t* pHeader)
+{
+  uint32_t i;
+
+  if ((memcmp(pBuf, "XTRC", 4U) != 0) || (pBuf[4] != XMC_TRACE_VERSION))
+  {
+    return false;
+  }
+
+  pHeader->m_Kit        = pBuf[5];
+  pHeader->m_Backend    = pBuf[6];
+  pHeader->m_Flags      = pBuf[7];
+  pHeader->m_AwMode     = pBuf[8];
+  pHeader->m_AwShift    = pBuf[9];
+  pHeader->m_PeriodNs   = XMC_CMD_GetU32(&pBuf[12]);
+  pHeader->m_Decimation = XMC_CMD_GetU32(&pBuf[16]);
+  pHeader->m_AwGain     = XMC_CMD_GetFloat(&pBuf[20]);
+  for (i = 0U; i < XMC_CMD_PARAM_COUNT; i++)
+  {
+    pHeader->m_Param[i] = XMC_CMD_GetFloat(&pBuf[24U + (4U * i)]);
+  }
+
+  return (pHeader->m_Decimation != 0U);
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Init
+********************************************************************************
+* Summary:
+* This API fills the recorder structure. The first recorded sample is the one
+* of the next call of XMC_TRACE_Sample, as a sync at time 0.
+*
+* Parameters:
+* XMC_TRACE_t*              [out] ptr Pointer to the recorder structure
+* uint8_t*                  [in]  pBuf Ring buffer
+* uint32_t                  [in]  size Ring buffer size, a power of two
+* const XMC_TRACE_HEADER_t* [in]  pHeader Loop description, m_Decimation is
+*                                 used by the recorder
+* uint32_t                  [in]  syncInterval Samples between syncs
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_Init(XMC_TRACE_t* ptr,
+                                    uint8_t* pBuf,
+                                    uint32_t size,
+                                    const XMC_TRACE_HEADER_t* pHeader,
+                                    uint32_t syncInterval)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_pBuf         = pBuf;
+  ptr->m_Mask         = size - 1U;
+  ptr->m_Decimation   = pHeader->m_Decimation;
+  ptr->m_Count        = 1U;
+  ptr->m_SyncInterval = syncInterval;
+  ptr->m_Time         = UINT32_MAX;
+  XMC_TRACE_PutHeader(ptr->m_Header, pHeader);
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_PutVarint
+********************************************************************************
+* Summary:
+* This function writes a varint into the ring buffer.
+*
+* Parameters:
+* uint8_t* [out] pBuf Ring buffer
+* uint32_t [in]  mask Ring size - 1
+* uint32_t [in]  pos Write position
+* uint32_t [in]  value Value
+*
+* Return:
+*  uint32_t Write position after the varint
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_TRACE_PutVarint(uint8_t* pBuf, uint32_t mask, uint32_t pos, uint32_t value)
+{
+  while (value >= 0x80U)
+  {
+    pBuf[pos++ & mask] = (uint8_t)(value | 0x80U);
+    value >>= 7;
+  }
+  pBuf[pos++ & mask] = (uint8_t)value;
+
+  return pos;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Zigzag
+********************************************************************************
+* Summary:
+* This function maps a signed value to an unsigned one with a small magnitude
+* for small positive and negative values: 0, -1, 1, -2 ... become 0, 1, 2, 3 ...
+*
+* Parameters:
+* int32_t [in] value Signed value
+*
+* Return:
+*  uint32_t Unsigned value
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_TRACE_Zigzag(int32_t value)
+{
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Reserve
+********************************************************************************
+* Summary:
+* This function checks the free space of the ring buffer for a record. If the
+* ring is full, or was full and has not yet been emptied by the reader, the
+* record is counted as lost.
+*
+* Parameters:
+* XMC_TRACE_t* [in/out] ptr Pointer to the recorder structure
+* uint32_t     [in]  len Longest length of the record
+*
+* Return:
+*  bool true if the record can be written
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_Reserve(XMC_TRACE_t* ptr, uint32_t len)
+{
+  uint32_t used = ptr->m_Head - ptr->m_Tail;
+
+  if ((ptr->m_Overflow && (used != 0U)) || ((ptr->m_Mask + 1U - used) < len))
+  {
+    ptr->m_Overflow = true;
+    ptr->m_Lost++;
+    ptr->m_LostTotal++;
+    return false;
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Sample
+********************************************************************************
+* Summary:
+* This function is called by the control ISR in every control period, after
+* the duty is written. Every m_Decimation periods, it records the ADC sample
+* and the duty: in one byte when both changed by a few ticks only.
+*
+* Parameters:
+* XMC_TRACE_t* [in/out] ptr Pointer to the recorder structure
+* uint32_t     [in]  adc ADC sample of the period
+* uint32_t     [in]  duty Duty written in the period
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_Sample(XMC_TRACE_t* ptr, uint32_t adc, uint32_t duty)
+{
+  uint32_t pos;
+  uint32_t start;
+  uint8_t check;
+  int32_t dAdc;
+  int32_t dDuty;
+
+  ptr->m_Time++;
+  if (--ptr->m_Count != 0U)
+  {
+    return;
+  }
+  ptr->m_Count = ptr->m_Decimation;
+
+  /* A drop event and a sync after an overflow */
+  if (!XMC_TRACE_Reserve(ptr, 2U * XMC_TRACE_RECORD_MAX))
+  {
+    return;
+  }
+
+  pos = ptr->m_Head;
+  if (ptr->m_Overflow || (ptr->m_ToSync == 0U))
+  {
+    if (ptr->m_Overflow)
+    {
+      ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_TAG_EVENT;
+      ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_EV_DROP;
+      pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, ptr->m_Time - ptr->m_LastTime);
+      pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, XMC_TRACE_Zigzag((int32_t)ptr->m_Lost));
+      ptr->m_Overflow = false;
+      ptr->m_Lost     = 0U;
+    }
+
+    start = pos;
+    ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_TAG_SYNC;
+    ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_SYNC_MARK;
+    pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, ptr->m_Time);
+    pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, adc);
+    pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, duty);
+    check = 0xFFU;
+    while (start != pos)
+    {
+      check ^= ptr->m_pBuf[start++ & ptr->m_Mask];
+    }
+    ptr->m_pBuf[pos++ & ptr->m_Mask] = check;
+    ptr->m_ToSync = ptr->m_SyncInterval;
+  }
+  else
+  {
+    dAdc  = (int32_t)(adc - ptr->m_Adc);
+    dDuty = (int32_t)(duty - ptr->m_Duty);
+    if ((dAdc >= -4) && (dAdc <= 3) && (dDuty >= -8) && (dDuty <= 7))
+    {
+      ptr->m_pBuf[pos++ & ptr->m_Mask] = (uint8_t)((((uint32_t)dAdc & 7U) << 4) | ((uint32_t)dDuty & 15U));
+    }
+    else
+    {
+      ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_TAG_SAMPLE;
+      pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, XMC_TRACE_Zigzag(dAdc));
+      pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, XMC_TRACE_Zigzag(dDuty));
+    }
+  }
+
+  ptr->m_ToSync--;
+  ptr->m_LastTime = ptr->m_Time;
+  ptr->m_Adc      = adc;
+  ptr->m_Duty     = duty;
+  ptr->m_Samples++;
+  ptr->m_Head     = pos;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Event
+********************************************************************************
+* Summary:
+* This function records an event of the current control period. It is called
+* by the control ISR, after XMC_TRACE_Sample.
+*
+* Parameters:
+* XMC_TRACE_t*      [in/out] ptr Pointer to the recorder structure
+* XMC_TRACE_EVENT_t [in]  id Event
+* int32_t           [in]  value Value of the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_Event(XMC_TRACE_t* ptr, XMC_TRACE_EVENT_t id, int32_t value)
+{
+  uint32_t pos;
+
+  if (!XMC_TRACE_Reserve(ptr, XMC_TRACE_RECORD_MAX))
+  {
+    return;
+  }
+
+  pos = ptr->m_Head;
+  ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_TAG_EVENT;
+  ptr->m_pBuf[pos++ & ptr->m_Mask] = (uint8_t)id;
+  pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, ptr->m_Time - ptr->m_LastTime);
+  pos = XMC_TRACE_PutVarint(ptr->m_pBuf, ptr->m_Mask, pos, XMC_TRACE_Zigzag(value));
+  ptr->m_Head = pos;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Param
+********************************************************************************
+* Summary:
+* This function records a parameter set, after a XMC_TRACE_EV_TUNE event.
+*
+* Parameters:
+* XMC_TRACE_t* [in/out] ptr Pointer to the recorder structure
+* const float* [in]  pParam XMC_CMD_PARAM_COUNT parameters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_Param(XMC_TRACE_t* ptr, const float* pParam)
+{
+  uint8_t value[4];
+  uint32_t pos;
+  uint32_t i;
+  uint32_t j;
+
+  if (!XMC_TRACE_Reserve(ptr, XMC_TRACE_PARAM_SIZE))
+  {
+    return;
+  }
+
+  pos = ptr->m_Head;
+  ptr->m_pBuf[pos++ & ptr->m_Mask] = XMC_TRACE_TAG_PARAM;
+  for (i = 0U; i < XMC_CMD_PARAM_COUNT; i++)
+  {
+    XMC_CMD_PutFloat(value, pParam[i]);
+    for (j = 0U; j < 4U; j++)
+    {
+      ptr->m_pBuf[pos++ & ptr->m_Mask] = value[j];
+    }
+  }
+  ptr->m_Head = pos;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Read
+********************************************************************************
+* Summary:
+* This function takes recorded bytes out of the ring buffer. It runs in the
+* main context.
+*
+* Parameters:
+* XMC_TRACE_t* [in/out] ptr Pointer to the recorder structure
+* uint8_t*     [out] pBuf Destination
+* uint32_t     [in]  max Size of the destination
+*
+* Return:
+*  uint32_t Bytes taken
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_TRACE_Read(XMC_TRACE_t* ptr, uint8_t* pBuf, uint32_t max)
+{
+  uint32_t tail = ptr->m_Tail;
+  uint32_t len  = ptr->m_Head - tail;
+  uint32_t i;
+
+  if (len > max)
+  {
+    len = max;
+  }
+  for (i = 0U; i < len; i++)
+  {
+    pBuf[i] = ptr->m_pBuf[tail++ & ptr->m_Mask];
+  }
+  ptr->m_Tail = tail;
+
+  return len;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_ReadHeader
+********************************************************************************
+* Summary:
+* This function copies a part of the header.
+*
+* Parameters:
+* const XMC_TRACE_t* [in]  ptr Pointer to the recorder structure
+* uint32_t           [in]  offset First header byte
+* uint8_t*           [out] pBuf Destination
+* uint32_t           [in]  max Size of the destination
+*
+* Return:
+*  uint32_t Bytes copied, 0 past the end of the header
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_TRACE_ReadHeader(const XMC_TRACE_t* ptr,
+                                              uint32_t offset,
+                                              uint8_t* pBuf,
+                                              uint32_t max)
+{
+  uint32_t len;
+
+  if (offset >= XMC_TRACE_HEADER_SIZE)
+  {
+    return 0U;
+  }
+  len = XMC_TRACE_HEADER_SIZE - offset;
+  if (len > max)
+  {
+    len = max;
+  }
+  memcpy(pBuf, &ptr->m_Header[offset], len);
+
+  return len;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_DecoderInit
+********************************************************************************
+* Summary:
+* This API fills the decoder structure for a stream in memory, the bytes after
+* the header.
+*
+* Parameters:
+* XMC_TRACE_DECODER_t* [out] ptr Pointer to the decoder structure
+* const uint8_t*       [in]  pData Stream
+* size_t               [in]  size Stream size
+* uint32_t             [in]  decimation m_Decimation of the header
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_DecoderInit(XMC_TRACE_DECODER_t* ptr,
+                                           const uint8_t* pData,
+                                           size_t size,
+                                           uint32_t decimation)
+{
+  memset(ptr, 0, sizeof(*ptr));
+
+  ptr->m_pData      = pData;
+  ptr->m_Size       = size;
+  ptr->m_Decimation = decimation;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_DecoderSeek
+********************************************************************************
+* Summary:
+* This function moves the decoder to a byte position. Decoding restarts at
+* the first sync from there, with the time modulo 2^32.
+*
+* Parameters:
+* XMC_TRACE_DECODER_t* [in/out] ptr Pointer to the decoder structure
+* size_t               [in]  pos Byte position in the stream
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_DecoderSeek(XMC_TRACE_DECODER_t* ptr, size_t pos)
+{
+  ptr->m_Pos      = (pos < ptr->m_Size) ? pos : ptr->m_Size;
+  ptr->m_Synced   = false;
+  ptr->m_HaveTime = false;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_GetVarint
+********************************************************************************
+* Summary:
+* This function reads a varint of up to 32 bits.
+*
+* Parameters:
+* const XMC_TRACE_DECODER_t* [in]  ptr Pointer to the decoder structure
+* size_t*                    [in/out] pPos Read position
+* uint32_t*                  [out] pValue Value
+*
+* Return:
+*  bool false if the varint is truncated or too long
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_GetVarint(const XMC_TRACE_DECODER_t* ptr, size_t* pPos, uint32_t* pValue)
+{
+  uint32_t value = 0U;
+  uint32_t shift = 0U;
+  uint8_t data;
+
+  do
+  {
+    if ((*pPos >= ptr->m_Size) || (shift > 28U))
+    {
+      return false;
+    }
+    data   = ptr->m_pData[(*pPos)++];
+    value |= (uint32_t)(data & 0x7FU) << shift;
+    shift += 7U;
+  } while ((data & 0x80U) != 0U);
+
+  *pValue = value;
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_DecodeSync
+********************************************************************************
+* Summary:
+* This function checks and decodes a sync record at the current position.
+*
+* Parameters:
+* XMC_TRACE_DECODER_t* [in/out] ptr Pointer to the decoder structure
+* XMC_TRACE_RECORD_t*  [out] pRec Decoded sample
+*
+* Return:
+*  bool false if there is no valid sync at the position
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_DecodeSync(XMC_TRACE_DECODER_t* ptr, XMC_TRACE_RECORD_t* pRec)
+{
+  size_t pos = ptr->m_Pos + 2U;
+  size_t i;
+  uint32_t time;
+  uint32_t adc;
+  uint32_t duty;
+  uint8_t check = 0xFFU;
+
+  if ((pos > ptr->m_Size) || (ptr->m_pData[ptr->m_Pos + 1U] != XMC_TRACE_SYNC_MARK) ||
+      !XMC_TRACE_GetVarint(ptr, &pos, &time) ||
+      !XMC_TRACE_GetVarint(ptr, &pos, &adc) ||
+      !XMC_TRACE_GetVarint(ptr, &pos, &duty) ||
+      (pos >= ptr->m_Size))
+  {
+    return false;
+  }
+  for (i = ptr->m_Pos; i < pos; i++)
+  {
+    check ^= ptr->m_pData[i];
+  }
+  if (check != ptr->m_pData[pos])
+  {
+    return false;
+  }
+
+  if (ptr->m_HaveTime)
+  {
+    ptr->m_Time += (uint32_t)(time - (uint32_t)ptr->m_Time);
+  }
+  else
+  {
+    ptr->m_Time     = time;
+    ptr->m_HaveTime = true;
+  }
+  ptr->m_Adc    = adc;
+  ptr->m_Duty   = duty;
+  ptr->m_Pos    = pos + 1U;
+  ptr->m_Synced = true;
+
+  pRec->m_Time = ptr->m_Time;
+  pRec->m_Adc  = adc;
+  pRec->m_Duty = duty;
+  pRec->m_Sync = true;
+
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_Decode
+********************************************************************************
+* Summary:
+* This function decodes the next record. Before the first sync, and after an
+* invalid record, bytes are skipped up to the next valid sync.
+*
+* Parameters:
+* XMC_TRACE_DECODER_t* [in/out] ptr Pointer to the decoder structure
+* XMC_TRACE_RECORD_t*  [out] pRec Decoded record
+*
+* Return:
+*  XMC_TRACE_REC_t Kind of the record, XMC_TRACE_REC_END at the end
+*
+*******************************************************************************/
+__STATIC_INLINE XMC_TRACE_REC_t XMC_TRACE_Decode(XMC_TRACE_DECODER_t* ptr, XMC_TRACE_RECORD_t* pRec)
+{
+  const uint8_t* pSync;
+  size_t pos;
+  uint32_t a;
+  uint32_t b;
+  uint32_t i;
+  uint8_t tag;
+
+  for (;;)
+  {
+    if (!ptr->m_Synced)
+    {
+      pSync = (ptr->m_Pos < ptr->m_Size) ?
+              memchr(&ptr->m_pData[ptr->m_Pos], XMC_TRACE_TAG_SYNC, ptr->m_Size - ptr->m_Pos) : NULL;
+      if (pSync == NULL)
+      {
+        ptr->m_Skipped += ptr->m_Size - ptr->m_Pos;
+        ptr->m_Pos      = ptr->m_Size;
+        return XMC_TRACE_REC_END;
+      }
+      ptr->m_Skipped += (size_t)(pSync - &ptr->m_pData[ptr->m_Pos]);
+      ptr->m_Pos      = (size_t)(pSync - ptr->m_pData);
+      if (XMC_TRACE_DecodeSync(ptr, pRec))
+      {
+        return XMC_TRACE_REC_SAMPLE;
+      }
+      ptr->m_Pos++;
+      ptr->m_Skipped++;
+      continue;
+    }
+
+    if (ptr->m_Pos >= ptr->m_Size)
+    {
+      return XMC_TRACE_REC_END;
+    }
+
+    pos = ptr->m_Pos;
+    tag = ptr->m_pData[pos++];
+    pRec->m_Sync = false;
+
+    if (tag < XMC_TRACE_TAG_SAMPLE)
+    {
+      ptr->m_Time += ptr->m_Decimation;
+      ptr->m_Adc  += (uint32_t)((int32_t)((uint32_t)tag << 25) >> 29);
+      ptr->m_Duty += (uint32_t)((int32_t)((uint32_t)tag << 28) >> 28);
+      ptr->m_Pos   = pos;
+      pRec->m_Time = ptr->m_Time;
+      pRec->m_Adc  = ptr->m_Adc;
+      pRec->m_Duty = ptr->m_Duty;
+      return XMC_TRACE_REC_SAMPLE;
+    }
+
+    if ((tag == XMC_TRACE_TAG_SAMPLE) &&
+        XMC_TRACE_GetVarint(ptr, &pos, &a) && XMC_TRACE_GetVarint(ptr, &pos, &b))
+    {
+      ptr->m_Time += ptr->m_Decimation;
+      ptr->m_Adc  += (a >> 1) ^ (0U - (a & 1U));
+      ptr->m_Duty += (b >> 1) ^ (0U - (b & 1U));
+      ptr->m_Pos   = pos;
+      pRec->m_Time = ptr->m_Time;
+      pRec->m_Adc  = ptr->m_Adc;
+      pRec->m_Duty = ptr->m_Duty;
+      return XMC_TRACE_REC_SAMPLE;
+    }
+
+    if ((tag == XMC_TRACE_TAG_EVENT) && (pos < ptr->m_Size))
+    {
+      pRec->m_Event = ptr->m_pData[pos++];
+      if (XMC_TRACE_GetVarint(ptr, &pos, &a) && XMC_TRACE_GetVarint(ptr, &pos, &b))
+      {
+        ptr->m_Pos       = pos;
+        ptr->m_EventTime = ptr->m_Time + a;
+        pRec->m_Time     = ptr->m_EventTime;
+        pRec->m_Value = (int32_t)((b >> 1) ^ (0U - (b & 1U)));
+        return XMC_TRACE_REC_EVENT;
+      }
+    }
+
+    if ((tag == XMC_TRACE_TAG_PARAM) && ((ptr->m_Size - pos) >= (XMC_TRACE_PARAM_SIZE - 1U)))
+    {
+      for (i = 0U; i < XMC_CMD_PARAM_COUNT; i++)
+      {
+        pRec->m_Param[i] = XMC_CMD_GetFloat(&ptr->m_pData[pos + (4U * i)]);
+      }
+      ptr->m_Pos   = pos + (XMC_TRACE_PARAM_SIZE - 1U);
+      pRec->m_Time = ptr->m_EventTime;
+      return XMC_TRACE_REC_PARAM;
+    }
+
+    if (tag == XMC_TRACE_TAG_SYNC)
+    {
+      if (XMC_TRACE_DecodeSync(ptr, pRec))
+      {
+        return XMC_TRACE_REC_SAMPLE;
+      }
+    }
+
+    /* Invalid or truncated record, the next sync is searched from the next byte */
+    ptr->m_Errors++;
+    ptr->m_Synced = false;
+    ptr->m_Pos++;
+  }
+}
+
+#endif /* #ifndef XMC_TRACE_H */
@@ -49,6 +49,17 @@
 #include "cybsp.h"
 #include "cy_utils.h"
 #include "xmc_3p3z_filter_fixed.h"
+#include "xmc_compensator.h"
+#include "xmc_2p2z_filter_fixed.h"
+#include "xmc_predictor_fixed.h"
+#include "xmc_feedforward.h"
+#include "xmc_cmd.h"
+#include "xmc_cmd_uart.h"
+#include "xmc_reg_stats.h"
+#include "xmc_burst_mode.h"
+#include "xmc_protection.h"
+#include "xmc_trace.h"
+#include "xmc_deadtime.h"
 #include "xmc13_vcm_buck_single.h"
 
 #if (UC_FAMILY == XMC1)
@@ -81,6 +92,229 @@
 #define DUTY_TICKS_MIN (0)
 #define DUTY_TICKS_MAX (576)
 
+/* Anti-windup policy of the compensator when the duty saturates, one of
+ * XMC_3P3Z_AW_CLAMP, XMC_3P3Z_AW_BACK_CALC or XMC_3P3Z_AW_CONDITIONAL. */
+#define ANTI_WINDUP_MODE          (XMC_3P3Z_AW_CLAMP)
+#define ANTI_WINDUP_SHIFT         (2)    /* back-calculation keeps 1/4 of the excess */
+
+/* Light-load burst mode. After BURST_ENTER_SAMPLES samples with the duty at or
+ * below BURST_ENTER_DUTY, the compensator is frozen. Bursts of BURST_PULSES
+ * pulses of BURST_DUTY ticks start when Vout is BURST_START_BAND below the
+ * reference; otherwise the trap holds both outputs passive. The linear loop
+ * resumes when Vout is BURST_EXIT_BAND below the reference or when a window of
+ * BURST_WINDOW samples has more than BURST_MAX_PULSES pulses. The ADC and the
+ * ISR still run every period; only the compensator is skipped. With the
+ * complementary outputs of the kit, the duty stays near Vout/Vin down to no
+ * load, so any duty enters and the pulse count sends heavy loads back to the
+ * linear loop. Each entry at a heavy load dips Vout by about BURST_EXIT_BAND
+ * plus the resume transient. The values are sized with tools/xmc_burst_sim.c.
+ * Set BURST_MODE_ENABLE to 1U to use it. */
+#define BURST_MODE_ENABLE         (0U)
+#define BURST_ENTER_DUTY          (DUTY_TICKS_MAX)        /* any duty */
+#define BURST_ENTER_SAMPLES       (10000U)                /* 100 ms at 100 kHz */
+#define BURST_DUTY                (224U)                  /* 35 %, above Vout/Vin */
+#define BURST_PULSES              (1U)
+#define BURST_START_BAND          (10U)                   /* ~10 mV */
+#define BURST_EXIT_BAND           (60U)                   /* ~60 mV */
+#define BURST_WINDOW              (128U)                  /* 1.28 ms */
+#define BURST_MAX_PULSES          (26U)                   /* 20 % of the window */
+
+/* Cascaded average-current-mode control. The inner current loop (2p2z) runs
+* every PWM cycle on the inductor current, and the outer voltage loop (3p3z)
+* once every OUTER_LOOP_DECIMATION cycles. The output of the outer loop,
+* shifted by CURRENT_REF_SHIFT, is the current reference; it is limited to
+* CURRENT_LIMIT ADC counts.
+* These coefficients are calculated for the following configuration.
+*
+* Power stage      = 10 uH, 470 uF, 10 mOhm ESR, 20 mOhm DCR
+* Current sense    = 200 ADC counts/A
+* Inner loop       = 100 kHz
+* Outer loop       = 50 kHz
+* PWM delay        = 1 period, duty applied with the next shadow transfer
+*
+* The coefficients are tuned in tools/xmc_current_mode_sim.c with the PWM
+* delay. Both loops settle for 7 to 13 uH and 330 to 700 uF.
+*
+* The inductor current must be converted by the ADC_CH_IL channel in the same
+* group and with the same trigger as the output voltage. Set
+* CURRENT_MODE_ENABLE to 1U to use it.
+*/
+#define CURRENT_MODE_ENABLE       (0U)
+#define ADC_CH_IL                 (7U)     /* placeholder, set the channel of the board */
+#define OUTER_LOOP_DECIMATION     (2U)
+#define CURRENT_REF_SHIFT         (2U)
+#define CURRENT_LIMIT             (2000U)  /* ~10 A */
+#define ILOOP_B0 (+0.044550000000)
+#define ILOOP_B1 (+0.001140480000)
+#define ILOOP_B2 (-0.043409520000)
+#define ILOOP_A1 (+0.88629150390625)
+#define ILOOP_A2 (+0.11370849609375)
+#define ILOOP_K  (+1.0)
+#define VLOOP_B0 (+0.451069000000)
+#define VLOOP_B1 (+0.042580914000)
+#define VLOOP_B2 (-0.408488086000)
+#define VLOOP_B3 (+0.0)
+#define VLOOP_A1 (+0.1619873046875)
+#define VLOOP_A2 (+0.8380126953125)
+#define VLOOP_A3 (+0.0)
+#define VLOOP_K  (+1.0)
+
+#if (CURRENT_MODE_ENABLE == 1U) && (BURST_MODE_ENABLE == 1U)
+#error "Burst mode is only available in voltage mode"
+#endif
+#if (OUTER_LOOP_DECIMATION < 2U)
+#error "OUTER_LOOP_DECIMATION must be at least 2"
+#endif
+
+/* One-step-ahead predictor. The compensator regulates the output voltage
+* predicted for the next shadow transfer instead of the sample, which removes
+* most of the phase lag of the one-sample delay. The model assumes the sample
+* is taken at the start of the PWM period.
+* These coefficients are calculated for the following configuration.
+*
+* Power stage      = 10 uH, 470 uF, 10 mOhm ESR, 20 mOhm DCR, 12 V input
+* Sample period    = 10 us
+* ADC gain         = 1000 counts/V, duty in 640 ticks/period
+*
+* Set PREDICTOR_ENABLE to 1U to use it.
+*/
+#define PREDICTOR_ENABLE          (0U)
+#define PRED_A1 (+1.949522056350)
+#define PRED_A2 (-0.970445533549)
+#define PRED_B1 (+0.381200170521)
+#define PRED_B2 (+0.011115026960)
+
+#if (PREDICTOR_ENABLE == 1U) && (CURRENT_MODE_ENABLE == 1U)
+#error "The predictor is only available in voltage mode"
+#endif
+
+/* Input voltage feedforward. The duty is scaled by VIN_NOMINAL/Vin, so the
+* loop gain does not change with the input voltage and line steps are
+* corrected in the next PWM period. The compensator coefficients stay tuned
+* for the nominal input voltage. The input voltage must be converted by the
+* ADC_CH_VIN channel in the same group and with the same trigger as the
+* output voltage. Set VIN_FEEDFORWARD_ENABLE to 1U to use it.
+*/
+#define VIN_FEEDFORWARD_ENABLE    (0U)
+#define ADC_CH_VIN                (6U)     /* placeholder, set the channel of the board */
+#define VIN_NOMINAL               (2000U)  /* Vin sample at 12 V, depends on the divider */
+#define VIN_FF_MAX_GAIN           (2.0f)   /* feedforward down to 6 V */
+
+/* Command channel for runtime tuning (xmc_cmd.h) on a USIC UART. The frames
+* are handled by a background task, and a new parameter set is taken by the
+* control ISR at the next sample boundary. The UART interrupts run below the
+* control ISR. Set CMD_CHANNEL_ENABLE to 1U to use it.
+*/
+#define CMD_CHANNEL_ENABLE        (0U)
+#define CMD_UART_CHANNEL          XMC_UART0_CH0
+#define CMD_UART_TX_PIN           P1_5     /* placeholder, set the pins of the board */
+#define CMD_UART_TX_MODE          XMC_GPIO_MODE_OUTPUT_PUSH_PULL_ALT2
+#define CMD_UART_RX_PIN           P1_4
+#define CMD_UART_RX_SOURCE        USIC0_C0_DX0_P1_4
+#define CMD_UART_BAUDRATE         (115200U)
+#define CMD_UART_PRIORITY         ((1UL << __NVIC_PRIO_BITS) - 2UL)
+#define CMD_TASK_PERIOD           (1U)     /* ms, 64-byte receive buffer at 115200 baud */
+#define CMD_TASK_BUDGET           (20000U)
+#if (CURRENT_MODE_ENABLE == 1U)
+#define CMD_OUT_MAX               (CURRENT_LIMIT >> CURRENT_REF_SHIFT)
+#else
+#define CMD_OUT_MAX               (DUTY_TICKS_MAX)
+#endif
+
+/* Compensator backend. XMC_COMP_BACKEND selects the kernel of the voltage
+* loop at compile time (xmc_compensator.h), XMC_COMP_FIXED by default. The
+* float, Q15 and Q31 backends run the plain filter with clamping anti-windup,
+* without current mode and the command channel.
+*/
+#if (XMC_COMP_BACKEND != XMC_COMP_FIXED) && \
+    ((CURRENT_MODE_ENABLE == 1U) || (CMD_CHANNEL_ENABLE == 1U) || \
+     (ANTI_WINDUP_MODE != XMC_3P3Z_AW_CLAMP))
+#error "This feature needs the fixed point backend, set XMC_COMP_BACKEND to XMC_COMP_FIXED"
+#endif
+
+/* Protection. The control ISR checks every sample for overvoltage, overcurrent
+* (in current mode) and a stuck ADC, and the duty before it is written. A trip
+* sets the trap flag of the CCU8 slice, which forces both PWM outputs to their
+* passive level. The same trap shuts down the PWM in hardware when
+* PROT_TRAP_INPUT becomes active, for example from an overvoltage or
+* overcurrent comparator. The fault is latched; protection_task restarts the
+* converter after PROT_RESTART_DELAY task periods. After PROT_MAX_RESTARTS
+* restarts without a stable run of PROT_STABLE_PERIODS, the fault stays
+* latched until reset. Set PROTECTION_ENABLE to 1U to use it.
+*/
+#define PROTECTION_ENABLE         (0U)
+#define PROT_TRAP_INPUT           (XMC_CCU8_SLICE_INPUT_A) /* placeholder, set the trap signal of the board */
+#define PROT_TRAP_LEVEL           (XMC_CCU8_SLICE_EVENT_LEVEL_SENSITIVITY_ACTIVE_LOW)
+#define PROT_OV_LEVEL             (4000U)  /* ~4.0 V */
+#if (CURRENT_MODE_ENABLE == 1U)
+#define PROT_OC_LEVEL             (CURRENT_LIMIT + 400U)  /* ~12 A */
+#define PROT_IL_SAMPLE            (il_result)
+#else
+#define PROT_OC_LEVEL             (UINT32_MAX)            /* no current sense */
+#define PROT_IL_SAMPLE            (0U)
+#endif
+#define PROT_STUCK_DUTY           (DUTY_TICKS_MAX / 4)
+#define PROT_STUCK_SAMPLES        (4U)
+#define PROT_TASK_PERIOD          (10U)    /* ms */
+#define PROT_TASK_BUDGET          (2000U)
+#define PROT_RESTART_DELAY        (10U)    /* 100 ms */
+#define PROT_MAX_RESTARTS         (3U)
+#define PROT_STABLE_PERIODS       (100U)   /* 1 s */
+
+/* Trace of the control loop (xmc_trace.h). Every TRACE_DECIMATION periods, the
+* control ISR records the output voltage sample and the duty into a RAM ring,
+* with the protection, burst mode and tuning events. The ring is read out with
+* XMC_CMD_TRACE; xmc_cmd_client trace writes it to a file. The command channel
+* carries about 7 kB/s, so at a decimation of 1 the trace is a sequence of
+* windows of TRACE_BUF_SIZE bytes. Set TRACE_ENABLE to 1U to use it.
+*/
+#define TRACE_ENABLE              (0U)
+#define TRACE_BUF_SIZE            (4096U)  /* power of two */
+#define TRACE_DECIMATION          (32U)    /* ~3 kB/s in steady state */
+#define TRACE_SYNC_INTERVAL       (256U)
+#define TRACE_PERIOD_NS           (10000U)
+#if (TRACE_ENABLE == 1U) && (CMD_CHANNEL_ENABLE == 0U)
+#error "The trace is read out over the command channel, set CMD_CHANNEL_ENABLE to 1U"
+#endif
+
+/* Adaptive dead time (xmc_deadtime.h). At the regulated output voltage, the
+* duty settles lower when less is lost in the power stage. deadtime_task
+* tries one dead time tick up or down every few windows of 2^DEADTIME_LOG2_WINDOW
+* samples, measured against the current setting before and after, and keeps
+* it if the mean duty falls. Only the falling edge (the low-side turn-on delay)
+* is optimized, the rising edge stays at DEADTIME_RISE. The duty does not see
+* cross conduction, whose current is drawn from the input, so DEADTIME_MIN is
+* the hard limit and must be set from the measured switching delays of the
+* board, then DEADTIME_MIN_MEASURED set to 1U. Set DEADTIME_ENABLE to 1U to
+* use it.
+*/
+#define DEADTIME_ENABLE (1U)
+#define DEADTIME_RISE             (7U)     /* design.modus, 64 MHz ticks */
+#define DEADTIME_FALL             (7U)
+#define DEADTIME_MIN              (3U)     /* placeholder, ~47 ns */
+#define DEADTIME_MIN_MEASURED     (0U)     /* 1U once DEADTIME_MIN is from the board */
+#define DEADTIME_MAX              (15U)
+#define DEADTIME_STEP             (1U)
+#define DEADTIME_LOG2_WINDOW      (14U)    /* ~164 ms */
+#define DEADTIME_SETTLE           (1U)     /* windows */
+#define DEADTIME_HOLD             (16U)    /* ~2.6 s between rounds */
+#define DEADTIME_MAX_SPREAD       (32U)    /* duty ticks in a window */
+#define DEADTIME_MAX_DRIFT        (1.0f)   /* mean duty ticks */
+#define DEADTIME_MIN_GAIN         (0.02f)  /* mean duty ticks */
+#define DEADTIME_TASK_BUDGET      (2000U)
+#if (DEADTIME_ENABLE == 1U) && (DEADTIME_MIN_MEASURED == 0U)
+#error "DEADTIME_MIN is a placeholder, set it from the measured switching delays of the board"
+#endif
+
+/* Regulation statistics window as a power of two (1024 samples, ~10 ms at 100 kHz) */
+#define STATS_LOG2_WINDOW         (10U)
+/* Cycle budget of the background task computing the statistics */
+#define STATS_TASK_BUDGET         (5000U)
+
+/* Priority for ADC interrupt. 0 is the highest priority, so the control ISR
+ * preempts the SysTick and any other background interrupt. */
+#define ADC_ISR_PRIORITY_HIGH     0U
+
 #if ENABLE_XMC_DEBUG_PRINT
 static bool LOOP_ENTER = false;
 #endif
@@ -90,7 +324,394 @@ static bool LOOP_ENTER = false;
 *******************************************************************************/
 volatile XMC_VADC_RESULT_SIZE_t adc_result =0;
 /* Definition of the structure to store the filter paremeters*/
-XMC_3P3Z_DATA_FIXED_t ctrlFixed;
+XMC_COMP_t ctrlComp;
+#if (CURRENT_MODE_ENABLE == 1U)
+/* Inner current loop and its feedback, and the ISR of the outer loop period in
+* which the next outer loop part runs */
+volatile XMC_VADC_RESULT_SIZE_t il_result =0;
+XMC_2P2Z_DATA_FIXED_t ctrlCurrent;
+static uint32_t outerPhase;
+#endif
+#if (PREDICTOR_ENABLE == 1U)
+/* Predicted output voltage, the compensator feedback */
+XMC_PRED_DATA_FIXED_t predictor;
+#endif
+#if (VIN_FEEDFORWARD_ENABLE == 1U)
+/* Input voltage and its feedforward gain table */
+volatile XMC_VADC_RESULT_SIZE_t vin_result =0;
+XMC_FF_t feedForward;
+#endif
+/* Regulation statistics, updated by the ISR and computed in the background */
+XMC_STATS_t regStats;
+XMC_STATS_RESULT_t regStatsResult;
+#if (BURST_MODE_ENABLE == 1U)
+/* Light-load burst mode state and counters */
+XMC_BURST_t burstMode;
+#endif
+#if (PROTECTION_ENABLE == 1U)
+/* Protection limits, latched fault and counters */
+XMC_PROT_t protection;
+#endif
+
+#if (DEADTIME_ENABLE == 1U)
+/* Adaptive dead time, its windows are fed by the ISR */
+XMC_DT_t deadTime;
+#endif
+
+/* Background scheduler and the ids of the tasks posted by the ISR */
+static XMC_SCHED_t* pSched;
+static int statsTaskId;
+#if (DEADTIME_ENABLE == 1U)
+static int deadTimeTaskId;
+#endif
+
+/* Command channel, its UART link and the parameter set handed to the ISR */
+#if (CMD_CHANNEL_ENABLE == 1U)
+XMC_CMD_SERVER_t cmdServer;
+XMC_CMD_UART_t cmdUart;
+static XMC_3P3Z_DATA_FIXED_t ctrlNext;
+static uint8_t cmdTxFrame[XMC_CMD_MAX_FRAME];  /* Response waiting for room in the TX ring */
+static uint32_t cmdTxLen;
+static volatile uint32_t tunePending;
+static volatile uint32_t tuneApplied;
+#endif
+
+/* Trace of the control loop, and the state its events are detected from */
+#if (TRACE_ENABLE == 1U)
+XMC_TRACE_t trace;
+static uint8_t traceBuf[TRACE_BUF_SIZE];
+static float traceParam[XMC_CMD_PARAM_COUNT];
+#if (PROTECTION_ENABLE == 1U)
+static uint32_t traceFault;
+#endif
+#if (BURST_MODE_ENABLE == 1U)
+static bool traceBurst;
+#endif
+static uint32_t traceApplied;
+#endif
+
+/*******************************************************************************
+* Function Name: compensator_run
+********************************************************************************
+* Summary:
+* Runs the compensator on the latest ADC sample.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t Duty for the next PWM cycle
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t compensator_run(void)
+{
+    return XMC_COMP_Run(&ctrlComp);
+}
+
+#if (BURST_MODE_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: burst_mode_run
+********************************************************************************
+* Summary:
+* Runs the light-load burst mode. In burst mode, the compensator is frozen and
+* the burst duty is returned. Otherwise the compensator runs, preset with the
+* duty from before the burst when the linear loop resumes.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t Duty for the next PWM cycle
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t burst_mode_run(void)
+{
+    uint32_t duty;
+    XMC_BURST_ACTION_t action;
+    bool passive;
+
+    passive = burstMode.m_Passive;
+    action = XMC_BURST_Update(&burstMode, adc_result);
+    if (burstMode.m_Passive != passive)
+    {
+        /* The trap flag holds both outputs passive for skipped pulses. It is
+         * left at the start of the next period once the flag is cleared. Only
+         * the flag set here is cleared here: a trap from the input sets the
+         * event 2 flag as well, and protection_check trips on it before. */
+        if (burstMode.m_Passive)
+        {
+            XMC_CCU8_SLICE_SetEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_TRAP);
+        }
+        else
+        {
+            XMC_CCU8_SLICE_ClearEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_TRAP);
+        }
+    }
+    if (action == XMC_BURST_APPLY_DUTY)
+    {
+        return burstMode.m_Duty;
+    }
+
+    if (action == XMC_BURST_RESUME)
+    {
+        XMC_COMP_Preset(&ctrlComp, (int32_t)burstMode.m_ResumeDuty);
+    }
+
+    duty = compensator_run();
+    XMC_BURST_Observe(&burstMode, duty);
+
+    return duty;
+}
+#endif
+
+#if (CURRENT_MODE_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: current_mode_run
+********************************************************************************
+* Summary:
+* Runs the inner current loop every PWM cycle, and the outer voltage loop once
+* every OUTER_LOOP_DECIMATION cycles. The outer loop is split in two parts run
+* in different ISRs, so the ISR time stays close to the inner loop time plus
+* half the outer loop time. The new current reference is used from the next
+* cycle.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t Duty for the next PWM cycle
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t current_mode_run(void)
+{
+    XMC_2P2Z_FilterFixed(&ctrlCurrent);
+
+    if (outerPhase == 0U)
+    {
+        XMC_3P3Z_FilterFixedPrepare(&ctrlComp);
+    }
+    else if (outerPhase == (OUTER_LOOP_DECIMATION - 1U))
+    {
+        XMC_3P3Z_FilterFixedComplete(&ctrlComp);
+        ctrlCurrent.m_Ref = (int32_t)(ctrlComp.m_pOut << CURRENT_REF_SHIFT);
+    }
+
+    if (++outerPhase == OUTER_LOOP_DECIMATION)
+    {
+        outerPhase = 0U;
+    }
+
+    return ctrlCurrent.m_pOut;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: pwm_write
+********************************************************************************
+* Summary:
+* Writes the duty of the next PWM cycle.
+*
+* Parameters:
+*  uint32_t duty Duty in PWM ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void pwm_write(uint32_t duty)
+{
+    /* Updating the compare value 1 of the CCU8 */
+    CCU80_CC80->CR1S= duty;
+
+    /* Enabling shadow transfer */
+    ((XMC_CCU8_MODULE_t*) CCU80_BASE)->GCSS= 0x1;
+}
+
+#if (PROTECTION_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: protection_trip
+********************************************************************************
+* Summary:
+* Shuts down the PWM outputs and latches the fault.
+*
+* Parameters:
+*  uint32_t fault XMC_PROT_FAULT_xxx bits
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void protection_trip(uint32_t fault)
+{
+    /* The trap flag forces both outputs to the passive level at once */
+    XMC_CCU8_SLICE_SetEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_TRAP);
+    XMC_PROT_Trip(&protection, fault);
+}
+
+/*******************************************************************************
+* Function Name: protection_check
+********************************************************************************
+* Summary:
+* Checks the latest samples and the trap input. While a fault is latched, the
+* compensator must not run: its state belongs to protection_task.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool true if the PWM is shut down
+*
+*******************************************************************************/
+__STATIC_INLINE bool protection_check(void)
+{
+    uint32_t fault;
+
+    if (protection.m_Fault != 0U)
+    {
+        XMC_PROT_Observe(&protection, adc_result, PROT_IL_SAMPLE);
+        return true;
+    }
+
+    fault = XMC_PROT_CheckSample(&protection, adc_result, PROT_IL_SAMPLE);
+    /* Only the trap input sets the event 2 flag. Software sets the trap flag
+     * itself, for a trip or a skipped pulse of burst mode. */
+    if (XMC_CCU8_SLICE_GetEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_EVENT2))
+    {
+        fault |= XMC_PROT_FAULT_TRAP;
+    }
+    if (fault == 0U)
+    {
+        return false;
+    }
+
+    protection_trip(fault);
+    return true;
+}
+#endif
+
+#if (TRACE_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: trace_record
+********************************************************************************
+* Summary:
+* Records the sample of the period, then the events found by comparing the
+* protection, burst mode and tuning state with the one of the previous period.
+*
+* Parameters:
+*  uint32_t duty Duty written in the period
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void trace_record(uint32_t duty)
+{
+    XMC_TRACE_Sample(&trace, adc_result, duty);
+
+#if (PROTECTION_ENABLE == 1U)
+    if (protection.m_Fault != traceFault)
+    {
+        traceFault = protection.m_Fault;
+        if (traceFault != 0U)
+        {
+            XMC_TRACE_Event(&trace, XMC_TRACE_EV_FAULT, (int32_t)traceFault);
+        }
+        else
+        {
+            XMC_TRACE_Event(&trace, XMC_TRACE_EV_RESTART, DUTY_TICKS_MIN);
+        }
+    }
+#endif
+
+#if (BURST_MODE_ENABLE == 1U)
+    if (burstMode.m_Active != traceBurst)
+    {
+        traceBurst = burstMode.m_Active;
+        XMC_TRACE_Event(&trace,
+                        traceBurst ? XMC_TRACE_EV_BURST_ENTER : XMC_TRACE_EV_BURST_EXIT,
+                        (int32_t)burstMode.m_ResumeDuty);
+    }
+#endif
+
+    if (tuneApplied != traceApplied)
+    {
+        traceApplied = tuneApplied;
+        XMC_TRACE_Event(&trace, XMC_TRACE_EV_TUNE, (int32_t)traceApplied);
+        XMC_TRACE_Param(&trace, traceParam);
+    }
+}
+#endif
+
+#if (CMD_CHANNEL_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: tune_take
+********************************************************************************
+* Summary:
+* Takes the parameter set handed over by the command channel, if any. It is
+* called at the start of the control ISR, so the set changes between samples.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void tune_take(void)
+{
+    if (tunePending == 0U)
+    {
+        return;
+    }
+#if (CURRENT_MODE_ENABLE == 1U)
+    /* Both parts of the outer loop use the same set */
+    if (outerPhase != 0U)
+    {
+        return;
+    }
+#endif
+
+    /* ctrlNext is not volatile, so the barriers keep the copy after the
+     * tunePending load and before the store that hands it back */
+    __DMB();
+    XMC_3P3Z_UpdateFixed(&ctrlComp, &ctrlNext);
+    tuneApplied++;
+    __DMB();
+    tunePending = 0U;
+}
+#endif
+
+#if (DEADTIME_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: deadtime_take
+********************************************************************************
+* Summary:
+* Writes the dead times handed over by deadtime_task, if any. The CCU8 dead
+* time register has no shadow register, the values apply from the next edge.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void deadtime_take(void)
+{
+    if (deadTime.m_Pending == 0U)
+    {
+        return;
+    }
+    /* m_Out is not volatile, so the barrier keeps its loads after m_Pending */
+    __DMB();
+
+    XMC_CCU8_SLICE_SetDeadTimeValue((XMC_CCU8_SLICE_t*) CCU80_CC80,
+                                    XMC_CCU8_SLICE_COMPARE_CHANNEL_1,
+                                    (uint8_t)deadTime.m_Out[0],
+                                    (uint8_t)deadTime.m_Out[1]);
+    deadTime.m_Pending = 0U;
+}
+#endif
 
 /*******************************************************************************
 * Function Name: VADC0_G1_0_IRQHandler
@@ -110,39 +731,533 @@ XMC_3P3Z_DATA_FIXED_t ctrlFixed;
 *******************************************************************************/
 void VADC0_G1_0_IRQHandler(void)
 {
+    uint32_t duty;
+
     /* Retrieve result from result register. */
     adc_result = XMC_VADC_GROUP_GetResult(VADC_G1, 5);
+#if (VIN_FEEDFORWARD_ENABLE == 1U)
+    vin_result = XMC_VADC_GROUP_GetResult(VADC_G1, ADC_CH_VIN);
+#endif
+#if (CURRENT_MODE_ENABLE == 1U)
+    il_result = XMC_VADC_GROUP_GetResult(VADC_G1, ADC_CH_IL);
+#endif
+
+#if (PROTECTION_ENABLE == 1U)
+    if (protection_check())
+    {
+        pwm_write(DUTY_TICKS_MIN);
+#if (TRACE_ENABLE == 1U)
+        trace_record(DUTY_TICKS_MIN);
+#endif
+        return;
+    }
+#endif
+
+#if (CMD_CHANNEL_ENABLE == 1U)
+    tune_take();
+#endif
+
+#if (DEADTIME_ENABLE == 1U)
+    deadtime_take();
+#endif
+
+#if (PREDICTOR_ENABLE == 1U)
+    XMC_PRED_PredictFixed(&predictor, adc_result);
+#endif
 
     /* Applying the filter to the ADC measured value */
-    XMC_3P3Z_FilterFixed(&ctrlFixed);
+#if (CURRENT_MODE_ENABLE == 1U)
+    duty = current_mode_run();
+#elif (BURST_MODE_ENABLE == 1U)
+    duty = burst_mode_run();
+#else
+    duty = compensator_run();
+#endif
 
-    /* Updating the compare value 1 of the CCU8 */
-    CCU80_CC80->CR1S= ctrlFixed.m_pOut;
+#if (PREDICTOR_ENABLE == 1U)
+    /* The model input is the duty at the nominal input voltage */
+    XMC_PRED_ApplyFixed(&predictor, duty);
+#endif
 
-    /* Enabling shadow transfer */
-    ((XMC_CCU8_MODULE_t*) CCU80_BASE)->GCSS= 0x1;
+#if (VIN_FEEDFORWARD_ENABLE == 1U)
+    duty = XMC_FF_Scale(&feedForward, duty, vin_result);
+#endif
+
+#if (PROTECTION_ENABLE == 1U)
+    if (XMC_PROT_CheckDuty(&protection, duty) != 0U)
+    {
+        protection_trip(XMC_PROT_FAULT_DUTY);
+        duty = DUTY_TICKS_MIN;
+    }
+#endif
+
+    pwm_write(duty);
+
+#if (TRACE_ENABLE == 1U)
+    trace_record(duty);
+#endif
+
+    /* Updating the regulation statistics */
+    if (XMC_STATS_Update(&regStats, adc_result, ctrlComp.m_Ref - (int32_t)adc_result))
+    {
+        XMC_SCHED_Post(pSched, statsTaskId);
+    }
+
+#if (DEADTIME_ENABLE == 1U)
+    /* Feeding the dead time optimizer with the duty written */
+    if (XMC_DT_Update(&deadTime, duty))
+    {
+        XMC_SCHED_Post(pSched, deadTimeTaskId);
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: stats_task
+********************************************************************************
+* Summary:
+* Background task computing the statistics of the window finished by the ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stats_task(void)
+{
+    XMC_STATS_Read(&regStats, &regStatsResult);
+}
+
+#if (DEADTIME_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: deadtime_task
+********************************************************************************
+* Summary:
+* Background task stepping the dead time optimizer on the window finished by
+* the ISR. The duty is only a loss signal while the linear loop regulates, so
+* a fault or burst mode ends the trial in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void deadtime_task(void)
+{
+    bool steady = true;
+
+#if (PROTECTION_ENABLE == 1U)
+    steady = steady && (protection.m_Fault == 0U);
+#endif
+#if (BURST_MODE_ENABLE == 1U)
+    steady = steady && !burstMode.m_Active;
+#endif
+
+    (void)XMC_DT_Step(&deadTime, steady);
 }
+#endif
+
+#if (PROTECTION_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: compensator_restart
+********************************************************************************
+* Summary:
+* Resets the control state for a restart after a fault, so the converter
+* starts again from zero duty. The coefficients, also those set by the command
+* channel, are kept.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void compensator_restart(void)
+{
+#if (CURRENT_MODE_ENABLE == 1U)
+    XMC_COMP_Preset(&ctrlComp, 0);
+    XMC_2P2Z_ResetFixed(&ctrlCurrent);
+    ctrlCurrent.m_Ref = 0;
+    outerPhase = 0U;
+#else
+    XMC_COMP_Preset(&ctrlComp, DUTY_TICKS_MIN);
+#if (BURST_MODE_ENABLE == 1U)
+    XMC_BURST_Leave(&burstMode);
+#endif
+#if (PREDICTOR_ENABLE == 1U)
+    XMC_PRED_InitFixed(&predictor,
+                       PRED_A1,
+                       PRED_A2,
+                       PRED_B1,
+                       PRED_B2,
+                       adc_result,
+                       DUTY_TICKS_MIN,
+                       4095U);
+#endif
+#endif
+}
+
+/*******************************************************************************
+* Function Name: protection_task
+********************************************************************************
+* Summary:
+* Background task running the restart policy of the protection. On a restart,
+* the control state is reset and the trap is cleared before the fault, so the
+* ISR resumes with a clean compensator.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void protection_task(void)
+{
+    if (XMC_PROT_Supervise(&protection) != XMC_PROT_RESTART)
+    {
+        return;
+    }
+
+    compensator_restart();
+    /* If the trap input is still active, the event 2 flag is set again and
+     * the next sample trips */
+    XMC_CCU8_SLICE_ClearEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_EVENT2);
+    XMC_CCU8_SLICE_ClearEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_TRAP);
+    __DMB();
+    XMC_PROT_Release(&protection);
+}
+#endif
+
+#if (CMD_CHANNEL_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: cmd_b_peak
+********************************************************************************
+* Summary:
+* Returns the largest magnitude of the partial sums B0 K, (B0 + B1) K, ... of
+* a parameter set: the B x E sum for a unit error step, over the samples
+* after the step.
+*
+* Parameters:
+*  const float* p XMC_CMD_PARAM_COUNT parameters
+*
+* Return:
+*  float Largest partial sum
+*
+*******************************************************************************/
+static float cmd_b_peak(const float* p)
+{
+    float sum = 0.0f;
+    float peak = 0.0f;
+    uint32_t i;
+
+    for (i = XMC_CMD_PARAM_B0; i <= XMC_CMD_PARAM_B3; i++)
+    {
+        sum += p[i] * p[XMC_CMD_PARAM_K];
+        peak = fmaxf(peak, fabsf(sum));
+    }
+
+    return peak;
+}
+
+/*******************************************************************************
+* Function Name: cmd_apply
+********************************************************************************
+* Summary:
+* Checks a parameter set from the command channel and hands it to the control
+* ISR. The conversion to the filter format is done here, in the main context.
+*
+* Parameters:
+*  const float* p XMC_CMD_PARAM_COUNT parameters
+*
+* Return:
+*  XMC_CMD_STATUS_t XMC_CMD_OK, XMC_CMD_ERR_VALUE or XMC_CMD_BUSY
+*
+*******************************************************************************/
+static XMC_CMD_STATUS_t cmd_apply(const float* p)
+{
+    if (tunePending != 0U)
+    {
+        return XMC_CMD_BUSY;
+    }
+
+    if ((p[XMC_CMD_PARAM_REF] < 0.0f) || (p[XMC_CMD_PARAM_REF] > 4095.0f) ||
+        (p[XMC_CMD_PARAM_OUT_MIN] < 0.0f) ||
+        (p[XMC_CMD_PARAM_OUT_MIN] >= p[XMC_CMD_PARAM_OUT_MAX]) ||
+        (p[XMC_CMD_PARAM_OUT_MAX] > (float)CMD_OUT_MAX))
+    {
+        return XMC_CMD_ERR_VALUE;
+    }
+
+    /* The A x U sum of the fixed-point filter fits in 32 bits for sum |An| < 1.8 */
+    if ((fabsf(p[XMC_CMD_PARAM_A1]) + fabsf(p[XMC_CMD_PARAM_A2]) + fabsf(p[XMC_CMD_PARAM_A3])) >= 1.8f)
+    {
+        return XMC_CMD_ERR_VALUE;
+    }
+
+    /* The accumulator holds +/-4096 in Q19. After a full-scale error step,
+     * the B x E sum reaches the largest partial sum of Bn x K times 4095, on
+     * top of the A x U sum */
+    if (((cmd_b_peak(p) * 4095.0f) +
+         ((fabsf(p[XMC_CMD_PARAM_A1]) + fabsf(p[XMC_CMD_PARAM_A2]) + fabsf(p[XMC_CMD_PARAM_A3])) *
+          p[XMC_CMD_PARAM_OUT_MAX])) >= 4096.0f)
+    {
+        return XMC_CMD_ERR_VALUE;
+    }
+
+    XMC_3P3Z_InitFixed(&ctrlNext,
+                       p[XMC_CMD_PARAM_B0],
+                       p[XMC_CMD_PARAM_B1],
+                       p[XMC_CMD_PARAM_B2],
+                       p[XMC_CMD_PARAM_B3],
+                       p[XMC_CMD_PARAM_A1],
+                       p[XMC_CMD_PARAM_A2],
+                       p[XMC_CMD_PARAM_A3],
+                       p[XMC_CMD_PARAM_K],
+                       (uint16_t)p[XMC_CMD_PARAM_REF],
+                       (uint16_t)p[XMC_CMD_PARAM_OUT_MIN],
+                       (uint16_t)p[XMC_CMD_PARAM_OUT_MAX],
+                       ctrlComp.m_pFeedBack);
+#if (TRACE_ENABLE == 1U)
+    memcpy(traceParam, p, sizeof(traceParam));
+#endif
+    /* The set is complete before the ISR can see tunePending */
+    __DMB();
+    tunePending = 1U;
+
+    return XMC_CMD_OK;
+}
+
+/*******************************************************************************
+* Function Name: cmd_dump
+********************************************************************************
+* Summary:
+* Fills the regulator state for the command channel.
+*
+* Parameters:
+*  XMC_CMD_STATE_t* pState State to fill
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void cmd_dump(XMC_CMD_STATE_t* pState)
+{
+    pState->m_Vout      = adc_result;
+    pState->m_Ref       = (uint32_t)ctrlComp.m_Ref;
+    pState->m_Out       = XMC_COMP_Out(&ctrlComp);
+    pState->m_SatCount  = ctrlComp.m_SatCount;
+    pState->m_Applied   = tuneApplied;
+    pState->m_StatsSeq  = regStatsResult.m_Seq;
+    pState->m_MeanV     = regStatsResult.m_MeanV;
+    pState->m_RippleRms = regStatsResult.m_RippleRms;
+    pState->m_Idle      = pSched->m_Idle;
+    pState->m_Flags     = ((tunePending != 0U) ? XMC_CMD_FLAG_PENDING : 0U) |
+                          ((CURRENT_MODE_ENABLE == 1U) ? XMC_CMD_FLAG_CURRENT_MODE : 0U) |
+                          ((PREDICTOR_ENABLE == 1U) ? XMC_CMD_FLAG_PREDICTOR : 0U) |
+                          ((VIN_FEEDFORWARD_ENABLE == 1U) ? XMC_CMD_FLAG_FEEDFORWARD : 0U) |
+                          ((BURST_MODE_ENABLE == 1U) ? XMC_CMD_FLAG_BURST : 0U);
+#if (PROTECTION_ENABLE == 1U)
+    if (protection.m_Fault != 0U)
+    {
+        pState->m_Flags |= XMC_CMD_FLAG_FAULT;
+    }
+#endif
+}
+
+#if (TRACE_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: cmd_trace
+********************************************************************************
+* Summary:
+* Reads the trace for the command channel.
+*
+* Parameters:
+*  bool     header true for the header, false for the next bytes of the stream
+*  uint32_t offset First header byte
+*  uint8_t* pBuf Destination
+*  uint32_t max Size of the destination
+*
+* Return:
+*  uint32_t Bytes read
+*
+*******************************************************************************/
+static uint32_t cmd_trace(bool header, uint32_t offset, uint8_t* pBuf, uint32_t max)
+{
+    if (header)
+    {
+        return XMC_TRACE_ReadHeader(&trace, offset, pBuf, max);
+    }
+
+    return XMC_TRACE_Read(&trace, pBuf, max);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: cmd_task
+********************************************************************************
+* Summary:
+* Background task parsing the bytes received on the command channel and
+* sending the responses. A response that does not fit in the transmit ring is
+* kept, and no more bytes are parsed until it is queued whole at a later run.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void cmd_task(void)
+{
+    uint8_t data;
+
+    if ((cmdTxLen != 0U) && !XMC_CMD_UART_Write(&cmdUart, cmdTxFrame, cmdTxLen))
+    {
+        return;
+    }
+    cmdTxLen = 0U;
+
+    while (XMC_CMD_UART_Read(&cmdUart, &data))
+    {
+        if (XMC_CMD_ParserFeed(&cmdServer.m_Parser, data))
+        {
+            cmdTxLen = XMC_CMD_Handle(&cmdServer, &cmdServer.m_Parser.m_Frame, cmdTxFrame);
+            if (!XMC_CMD_UART_Write(&cmdUart, cmdTxFrame, cmdTxLen))
+            {
+                return;
+            }
+            cmdTxLen = 0U;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: USIC0_0_IRQHandler
+********************************************************************************
+* Summary:
+* Receive interrupt of the command channel.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void USIC0_0_IRQHandler(void)
+{
+    XMC_CMD_UART_RxIsr(&cmdUart);
+}
+
+/*******************************************************************************
+* Function Name: USIC0_1_IRQHandler
+********************************************************************************
+* Summary:
+* Transmit interrupt of the command channel.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void USIC0_1_IRQHandler(void)
+{
+    XMC_CMD_UART_TxIsr(&cmdUart);
+}
+#endif
 
 /*******************************************************************************
 * Function Name: xmc13_vcm_buck_single_init
 ********************************************************************************
 * Summary:
 * Function performing the initialization of the compensator, peripherals used,
-* and interrupt.
+* and interrupt. The background tasks of the converter are registered with the
+* scheduler.
 *
 * Parameters:
-*  void
+*  XMC_SCHED_t* sched Pointer to the initialized background scheduler
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-void xmc13_vcm_buck_single_init(void)
+void xmc13_vcm_buck_single_init(XMC_SCHED_t* sched)
 {
+#if (CMD_CHANNEL_ENABLE == 1U)
+    static const float cmdDefaults[XMC_CMD_PARAM_COUNT] =
+    {
+#if (CURRENT_MODE_ENABLE == 1U)
+        VLOOP_B0, VLOOP_B1, VLOOP_B2, VLOOP_B3, VLOOP_A1, VLOOP_A2, VLOOP_A3, VLOOP_K,
+        REF, 0, CURRENT_LIMIT >> CURRENT_REF_SHIFT
+#else
+        B0, B1, B2, B3, A1, A2, A3, K,
+        REF, DUTY_TICKS_MIN, DUTY_TICKS_MAX
+#endif
+    };
+    const XMC_GPIO_CONFIG_t cmdTxPin = { .mode = CMD_UART_TX_MODE };
+    const XMC_GPIO_CONFIG_t cmdRxPin = { .mode = XMC_GPIO_MODE_INPUT_TRISTATE };
+#endif
+#if (TRACE_ENABLE == 1U)
+    XMC_TRACE_HEADER_t traceHeader =
+    {
+        .m_Kit        = UC_FAMILY,
+        .m_Backend    = XMC_COMP_BACKEND,
+        .m_Flags      = ((CURRENT_MODE_ENABLE == 1U) ? XMC_TRACE_FLAG_CURRENT_MODE : 0U) |
+                        ((PREDICTOR_ENABLE == 1U) ? XMC_TRACE_FLAG_PREDICTOR : 0U) |
+                        ((VIN_FEEDFORWARD_ENABLE == 1U) ? XMC_TRACE_FLAG_FEEDFORWARD : 0U) |
+                        ((BURST_MODE_ENABLE == 1U) ? XMC_TRACE_FLAG_BURST : 0U) |
+                        ((PROTECTION_ENABLE == 1U) ? XMC_TRACE_FLAG_PROTECTION : 0U),
+        .m_AwMode     = ANTI_WINDUP_MODE,
+        .m_AwShift    = ANTI_WINDUP_SHIFT,
+        .m_AwGain     = 0.0f,
+        .m_PeriodNs   = TRACE_PERIOD_NS,
+        .m_Decimation = TRACE_DECIMATION
+    };
+#endif
+#if (PROTECTION_ENABLE == 1U)
+    const XMC_CCU8_SLICE_EVENT_CONFIG_t trapEvent =
+    {
+        .mapped_input = PROT_TRAP_INPUT,
+        .edge         = XMC_CCU8_SLICE_EVENT_EDGE_SENSITIVITY_NONE,
+        .level        = PROT_TRAP_LEVEL,
+        .duration     = XMC_CCU8_SLICE_EVENT_FILTER_3_CYCLES
+    };
+#endif
+
+    /* Registering the background tasks before the ISR can post them. */
+    pSched      = sched;
+    statsTaskId = XMC_SCHED_AddTask(sched, stats_task, XMC_SCHED_EVENT_ONLY,
+                                    STATS_TASK_BUDGET);
+    XMC_STATS_Init(&regStats, STATS_LOG2_WINDOW);
+#if (DEADTIME_ENABLE == 1U)
+    deadTimeTaskId = XMC_SCHED_AddTask(sched, deadtime_task, XMC_SCHED_EVENT_ONLY,
+                                       DEADTIME_TASK_BUDGET);
+    XMC_DT_Init(&deadTime,
+                DEADTIME_LOG2_WINDOW,
+                DEADTIME_RISE,
+                DEADTIME_FALL,
+                DEADTIME_MIN,
+                DEADTIME_MAX,
+                DEADTIME_STEP,
+                DEADTIME_SETTLE,
+                DEADTIME_HOLD,
+                DEADTIME_MAX_SPREAD,
+                DEADTIME_MAX_DRIFT,
+                DEADTIME_MIN_GAIN);
+#endif
+
     /* Initializing the interrupt. */
     NVIC_SetPriority(VADC0_G1_0_IRQn,
     NVIC_EncodePriority(NVIC_GetPriorityGrouping(),
-                        63,
+                        ADC_ISR_PRIORITY_HIGH,
                         0));
 
     /* Enable the interrupt. */
@@ -150,25 +1265,150 @@ void xmc13_vcm_buck_single_init(void)
 
     /* Initializing the compensator with the values for the required regulator
     configuration. */
-    XMC_3P3Z_InitFixed(&ctrlFixed,
-                       B0,
-                       B1,
-                       B2,
-                       B3,
-                       A1,
-                       A2,
-                       A3,
-                       K,
+#if (CURRENT_MODE_ENABLE == 1U)
+    /* Outer voltage loop, its output is the current reference */
+    XMC_3P3Z_InitFixed(&ctrlComp,
+                       VLOOP_B0,
+                       VLOOP_B1,
+                       VLOOP_B2,
+                       VLOOP_B3,
+                       VLOOP_A1,
+                       VLOOP_A2,
+                       VLOOP_A3,
+                       VLOOP_K,
                        REF,
+                       0,
+                       CURRENT_LIMIT >> CURRENT_REF_SHIFT,
+                       (uint32_t*)&adc_result);
+
+    /* Inner current loop, the reference is set by the outer loop */
+    XMC_2P2Z_InitFixed(&ctrlCurrent,
+                       ILOOP_B0,
+                       ILOOP_B1,
+                       ILOOP_B2,
+                       ILOOP_A1,
+                       ILOOP_A2,
+                       ILOOP_K,
+                       0,
                        DUTY_TICKS_MIN,
                        DUTY_TICKS_MAX,
-                       (uint32_t*)&adc_result);
+                       (uint32_t*)&il_result);
+    outerPhase = 0U;
+#else
+    XMC_COMP_Init(&ctrlComp,
+                  B0,
+                  B1,
+                  B2,
+                  B3,
+                  A1,
+                  A2,
+                  A3,
+                  K,
+                  REF,
+                  DUTY_TICKS_MIN,
+                  DUTY_TICKS_MAX,
+                  (uint32_t*)&adc_result);
+#if (PREDICTOR_ENABLE == 1U)
+    /* The compensator regulates the predicted output voltage */
+    XMC_PRED_InitFixed(&predictor,
+                       PRED_A1,
+                       PRED_A2,
+                       PRED_B1,
+                       PRED_B2,
+                       0,
+                       0,
+                       4095U);
+    ctrlComp.m_pFeedBack = &predictor.m_Out;
+#endif
+#endif
+
+#if (VIN_FEEDFORWARD_ENABLE == 1U)
+    XMC_FF_Init(&feedForward, VIN_NOMINAL, VIN_FF_MAX_GAIN, DUTY_TICKS_MAX);
+#endif
+
+#if (BURST_MODE_ENABLE == 1U)
+    XMC_BURST_Init(&burstMode,
+                   BURST_ENTER_DUTY,
+                   BURST_ENTER_SAMPLES,
+                   BURST_DUTY,
+                   BURST_PULSES,
+                   DUTY_TICKS_MIN,
+                   REF,
+                   BURST_START_BAND,
+                   BURST_EXIT_BAND,
+                   BURST_WINDOW,
+                   BURST_MAX_PULSES);
+#endif
+
+#if (XMC_COMP_BACKEND == XMC_COMP_FIXED)
+    XMC_3P3Z_InitAntiWindupFixed(&ctrlComp, ANTI_WINDUP_MODE, ANTI_WINDUP_SHIFT);
+#endif
+
+#if (PROTECTION_ENABLE == 1U)
+    XMC_PROT_Init(&protection,
+                  PROT_OV_LEVEL,
+                  PROT_OC_LEVEL,
+                  PROT_STUCK_DUTY,
+                  PROT_STUCK_SAMPLES,
+                  DUTY_TICKS_MAX,
+                  PROT_RESTART_DELAY,
+                  PROT_MAX_RESTARTS,
+                  PROT_STABLE_PERIODS);
+#endif
 
     /* Enable CCU80 Clock. */
     XMC_CCU8_EnableClock(CCU80_BASE, CCU80_CC80);
 
+#if (PROTECTION_ENABLE == 1U)
+    /* Trap on event 2, left only when software clears the flag: protection_task
+     * after a fault, burst_mode_run after skipped pulses */
+    XMC_CCU8_SLICE_ConfigureEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_EVENT_2, &trapEvent);
+    XMC_CCU8_SLICE_TrapConfig((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_TRAP_EXIT_MODE_SW, true);
+    XMC_CCU8_SLICE_ClearEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_EVENT2);
+#elif (BURST_MODE_ENABLE == 1U)
+    /* Burst mode only: no trap input is mapped and event 2 is not connected to
+     * the trap, so only burst_mode_run sets and clears the trap flag */
+    XMC_CCU8_SLICE_TrapConfig((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_TRAP_EXIT_MODE_SW, true);
+    ((XMC_CCU8_SLICE_t*) CCU80_CC80)->CMC &= ~((uint32_t)CCU8_CC8_CMC_TS_Msk);
+#endif
+#if (PROTECTION_ENABLE == 1U) || (BURST_MODE_ENABLE == 1U)
+    XMC_CCU8_SLICE_EnableTrap((XMC_CCU8_SLICE_t*) CCU80_CC80,
+                              XMC_CCU8_SLICE_OUTPUT_0 | XMC_CCU8_SLICE_OUTPUT_1);
+    XMC_CCU8_SLICE_ClearEvent((XMC_CCU8_SLICE_t*) CCU80_CC80, XMC_CCU8_SLICE_IRQ_ID_TRAP);
+#endif
+#if (PROTECTION_ENABLE == 1U)
+    (void)XMC_SCHED_AddTask(sched, protection_task, PROT_TASK_PERIOD, PROT_TASK_BUDGET);
+#endif
+
+#if (TRACE_ENABLE == 1U)
+    /* The trace starts with the first control period */
+    memcpy(traceHeader.m_Param, cmdDefaults, sizeof(traceHeader.m_Param));
+    memcpy(traceParam, cmdDefaults, sizeof(traceParam));
+    XMC_TRACE_Init(&trace, traceBuf, TRACE_BUF_SIZE, &traceHeader, TRACE_SYNC_INTERVAL);
+#endif
+
     /* Start CCU80 timer. */
     XMC_CCU8_SLICE_StartTimer((XMC_CCU8_SLICE_t*) CCU80_CC80);
+
+#if (CMD_CHANNEL_ENABLE == 1U)
+    /* Starting the command channel with the parameters in use */
+    XMC_GPIO_Init(CMD_UART_TX_PIN, &cmdTxPin);
+    XMC_GPIO_Init(CMD_UART_RX_PIN, &cmdRxPin);
+    XMC_CMD_UART_Init(&cmdUart,
+                      CMD_UART_CHANNEL,
+                      CMD_UART_BAUDRATE,
+                      CMD_UART_RX_SOURCE,
+                      0U,
+                      1U,
+                      USIC0_0_IRQn,
+                      USIC0_1_IRQn,
+                      CMD_UART_PRIORITY);
+    XMC_CMD_ServerInit(&cmdServer, UC_FAMILY, cmdDefaults, cmd_apply, cmd_dump);
+#if (TRACE_ENABLE == 1U)
+    XMC_CMD_ServerSetTrace(&cmdServer, cmd_trace);
+#endif
+    (void)XMC_SCHED_AddTask(sched, cmd_task, CMD_TASK_PERIOD, CMD_TASK_BUDGET);
+#endif
 }
 
 #endif /*(UC_FAMILY == XMC1)*/
@@ -42,6 +42,8 @@
 #ifndef XMC13_VCM_BUCK_SINGLE_H
 #define XMC13_VCM_BUCK_SINGLE_H
 
+#include "xmc_scheduler.h"
+
 /*******************************************************************************
 * Macros
 ********************************************************************************/
@@ -55,16 +57,17 @@
 ********************************************************************************
 * Summary:
 * Function performing the initialization of the compensator, peripherals used,
-* and interrupt.
+* and interrupt. The background tasks of the converter are registered with the
+* scheduler.
 *
 * Parameters:
-*  void
+*  XMC_SCHED_t* sched Pointer to the initialized background scheduler
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-void xmc13_vcm_buck_single_init(void);
+void xmc13_vcm_buck_single_init(XMC_SCHED_t* sched);
 
 
 #endif /*XMC13_VCM_BUCK_SINGLE_H*/
@@ -0,0 +1,306 @@
+/******************************************************************************
+* File Name:   xmc_antiwindup_bench.c
+*
+* Description: Host benchmark of the anti-windup modes of
+*              XMC_3P3Z_FilterFixed (XMC1302) and XMC_3P3Z_FilterFloat
+*              (XMC4200). The loop of each target runs on the averaged model
+*              of xmc_buck_model.h, with the duty applied one period late as
+*              by the PWM shadow transfer. Two cases saturate the duty:
+*              - the input drops from 12 V to 3 V for 10 ms at a 4 A load, so
+*                the duty stays at its upper limit, and then comes back,
+*              - the reference steps from 3.3 V to 2.5 V at a 0.5 A load, so
+*                the duty stays at its lower limit while the load discharges
+*                the output capacitor.
+*              For each mode it reports the time per sample on this host, the
+*              number of saturated samples, the peak deviation from the
+*              target voltage after the input is back or after the step, and
+*              the recovery time into a band of 2% of the target voltage.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_antiwindup_bench xmc_antiwindup_bench.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_EVENT_TIME        (0.02)      /* Input drop or reference step at 20 ms */
+#define SIM_TIME              (0.05)
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+#define SIM_BAND              (0.02)      /* Recovery band, fraction of the target */
+#define BENCH_MAX_SAMPLES     (10000)     /* SIM_TIME at 200 kHz */
+#define BENCH_TIMING_RUNS     (200)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Saturation case */
+typedef struct BENCH_CASE
+{
+    const char*         m_Name;
+    double              m_Load;       /* Load current in A */
+    double              m_VinLow;     /* Input voltage during the drop, 0 for no drop */
+    double              m_DropLength; /* Length of the drop in s */
+    double              m_VRef;       /* Reference after the event in V */
+} BENCH_CASE_t;
+
+/* Anti-windup setting under test */
+typedef struct BENCH_MODE
+{
+    const char*         m_Name;
+    int                 m_Kit;        /* XMC_BUCK_XMC1 (fixed) or XMC_BUCK_XMC4 (float) */
+    int                 m_Mode;       /* XMC_3P3Z_AW_xxx */
+    int                 m_Shift;      /* Back-calculation of the fixed kernel */
+    float               m_Gain;       /* Back-calculation of the float kernel */
+} BENCH_MODE_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const BENCH_CASE_t benchCases[] =
+{
+    { "input 12 V -> 3 V for 10 ms at 4 A",     4.0, 3.0, 0.01, XMC_BUCK_VOUT },
+    { "reference 3.3 V -> 2.5 V at 0.5 A",      0.5, 0.0, 0.0,  2.5           },
+};
+
+/* The defaults of the code examples are shift 2 and gain 0.25 */
+static const BENCH_MODE_t benchModes[] =
+{
+    { "clamp",            XMC_BUCK_XMC1, XMC_3P3Z_AW_CLAMP,       0, 0.0f  },
+    { "back-calc >>0",    XMC_BUCK_XMC1, XMC_3P3Z_AW_BACK_CALC,   0, 0.0f  },
+    { "back-calc >>2",    XMC_BUCK_XMC1, XMC_3P3Z_AW_BACK_CALC,   2, 0.0f  },
+    { "back-calc >>6",    XMC_BUCK_XMC1, XMC_3P3Z_AW_BACK_CALC,   6, 0.0f  },
+    { "conditional",      XMC_BUCK_XMC1, XMC_3P3Z_AW_CONDITIONAL, 0, 0.0f  },
+    { "clamp",            XMC_BUCK_XMC4, XMC_3P3Z_AW_CLAMP,       0, 0.0f  },
+    { "back-calc 0.25",   XMC_BUCK_XMC4, XMC_3P3Z_AW_BACK_CALC,   0, 0.25f },
+    { "back-calc 0.75",   XMC_BUCK_XMC4, XMC_3P3Z_AW_BACK_CALC,   0, 0.75f },
+    { "back-calc 1",      XMC_BUCK_XMC4, XMC_3P3Z_AW_BACK_CALC,   0, 1.0f  },
+    { "conditional",      XMC_BUCK_XMC4, XMC_3P3Z_AW_CONDITIONAL, 0, 0.0f  },
+};
+
+static volatile uint32_t adc;
+static XMC_3P3Z_DATA_FIXED_t fixedComp;
+static XMC_3P3Z_DATA_FLOAT_t floatComp;
+static uint32_t traceAdc[BENCH_MAX_SAMPLES];
+
+/*******************************************************************************
+* Function Name: comp_init
+********************************************************************************
+* Summary:
+* Initializes the compensator of a target with an anti-windup setting.
+*
+* Parameters:
+*  const BENCH_MODE_t* m Setting
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void comp_init(const BENCH_MODE_t* m)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[m->m_Kit];
+
+    if (m->m_Kit == XMC_BUCK_XMC1)
+    {
+        XMC_3P3Z_InitFixed(&fixedComp, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+        XMC_3P3Z_InitAntiWindupFixed(&fixedComp, m->m_Mode, m->m_Shift);
+    }
+    else
+    {
+        XMC_3P3Z_InitFloat(&floatComp, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+        XMC_3P3Z_InitAntiWindupFloat(&floatComp, m->m_Mode, m->m_Gain);
+    }
+}
+
+/*******************************************************************************
+* Function Name: comp_step
+********************************************************************************
+* Summary:
+* Runs the compensator of a target on the sample in adc.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*
+* Return:
+*  double Duty in ticks
+*
+*******************************************************************************/
+static inline double comp_step(int kit)
+{
+    if (kit == XMC_BUCK_XMC1)
+    {
+        XMC_3P3Z_FilterFixed(&fixedComp);
+        return (double)fixedComp.m_pOut;
+    }
+    XMC_3P3Z_FilterFloat(&floatComp);
+    return (double)floatComp.m_Out;
+}
+
+/*******************************************************************************
+* Function Name: run
+********************************************************************************
+* Summary:
+* Runs the loop of a target through a saturation case with an anti-windup
+* setting, then times the compensator alone on the recorded samples, and prints
+* the results.
+*
+* Parameters:
+*  const BENCH_CASE_t* c Saturation case
+*  const BENCH_MODE_t* m Setting
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run(const BENCH_CASE_t* c, const BENCH_MODE_t* m)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[m->m_Kit];
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t eventStart = (uint32_t)(SIM_EVENT_TIME * d->m_Fs);
+    uint32_t eventEnd = eventStart + (uint32_t)(c->m_DropLength * d->m_Fs);
+    uint16_t ref = (uint16_t)(c->m_VRef * d->m_AdcGain + 0.5);
+    struct timespec t0;
+    struct timespec t1;
+    XMC_BUCK_t buck;
+    uint32_t seed = 1U;
+    uint32_t satCount;
+    uint32_t n;
+    double peak = 0.0;
+    double recovery = 0.0;
+    double best = 1e9;
+    double ns;
+    double v;
+    int r;
+
+    XMC_BUCK_Init(&buck, d, XMC_BUCK_VIN, c->m_Load);
+    buck.m_Delay = true;
+    comp_init(m);
+    adc = 0U;
+
+    for (n = 0; n < samples; n++)
+    {
+        if (n == eventStart)
+        {
+            /* The command channel changes the reference the same way */
+            fixedComp.m_Ref = ref;
+            floatComp.m_Ref = ref;
+        }
+        traceAdc[n] = adc;
+        buck.m_Vin = ((n >= eventStart) && (n < eventEnd)) ? c->m_VinLow : XMC_BUCK_VIN;
+        v = XMC_BUCK_Run(&buck, comp_step(m->m_Kit));
+        adc = XMC_BUCK_Noise(&seed, XMC_BUCK_Adc(d, v), SIM_NOISE);
+
+        if (n >= eventEnd)
+        {
+            peak = fmax(peak, fabs(v - c->m_VRef));
+            if (fabs(v - c->m_VRef) > SIM_BAND * c->m_VRef)
+            {
+                recovery = (double)(n - eventEnd + 1U) / d->m_Fs;
+            }
+        }
+    }
+    satCount = (m->m_Kit == XMC_BUCK_XMC1) ? fixedComp.m_SatCount : floatComp.m_SatCount;
+
+    /* Time per sample on the samples of the loop, best of the runs */
+    for (r = 0; r < BENCH_TIMING_RUNS; r++)
+    {
+        comp_init(m);
+        fixedComp.m_Ref = ref;
+        floatComp.m_Ref = ref;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (n = 0; n < samples; n++)
+        {
+            adc = traceAdc[n];
+            (void)comp_step(m->m_Kit);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / samples;
+        best = fmin(best, ns);
+    }
+
+    printf("%-8s %-15s %7.1f %9u %10.0f %12.0f\n", d->m_Name, m->m_Name, best,
+           (unsigned)satCount, peak * 1e3, recovery * 1e6);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs every anti-windup setting of both targets.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (j = 0; j < sizeof(benchCases) / sizeof(benchCases[0]); j++)
+    {
+        printf("%s%s, recovery into +/-%.0f%% of %.1f V\n", (j == 0U) ? "" : "\n",
+               benchCases[j].m_Name, SIM_BAND * 100.0, benchCases[j].m_VRef);
+        printf("%-8s %-15s %7s %9s %10s %12s\n", "target", "mode", "ns/smp", "saturated",
+               "peak mV", "recovery us");
+        for (i = 0; i < sizeof(benchModes) / sizeof(benchModes[0]); i++)
+        {
+            run(&benchCases[j], &benchModes[i]);
+        }
+    }
+    printf("\ntime per sample on this host, not on the target\n");
+    return 0;
+}
@@ -0,0 +1,262 @@
+/******************************************************************************
+* File Name:   xmc_buck_model.h
+*
+* Description: Host side model of the buck power stage shared by the
+*              simulations in this folder: the compensator designs of the
+*              XMC1302 and XMC4200 code examples and an averaged model of the
+*              10 uH, 470 uF stage with a resistive load, the ADC conversion
+*              and its noise, with the constants of xmc_comp_bench.c. The
+*              includer defines __STATIC_INLINE.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_BUCK_MODEL_H
+#define XMC_BUCK_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#define XMC_BUCK_VIN                (12.0)    /**< Nominal input voltage in V */
+#define XMC_BUCK_VOUT               (3.3)     /**< Output voltage in V, for the load resistance */
+#define XMC_BUCK_L                  (10e-6)   /**< Inductance in H */
+#define XMC_BUCK_C                  (470e-6)  /**< Output capacitance in F */
+#define XMC_BUCK_ESR                (0.01)    /**< Capacitor ESR in Ohm */
+#define XMC_BUCK_DCR                (0.02)    /**< Inductor DCR in Ohm */
+#define XMC_BUCK_VF                 (0.7)     /**< Body diode forward voltage in V */
+#define XMC_BUCK_SUBSTEPS           (20)      /**< Integration steps per period */
+
+/**< Index of the designs in xmcBuckDesigns */
+#define XMC_BUCK_XMC1               (0)
+#define XMC_BUCK_XMC4               (1)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining the compensator design and the converter of a target
+ */
+typedef struct XMC_BUCK_DESIGN
+{
+  const char*         m_Name;
+  double              m_Fs;         /**< Control loop frequency in Hz */
+  double              m_Period;     /**< Switching period in duty ticks */
+  double              m_AdcGain;    /**< ADC counts per V */
+  float               m_B[4];
+  float               m_A[3];
+  float               m_K;
+  uint16_t            m_Ref;
+  uint32_t            m_DutyMin;
+  uint32_t            m_DutyMax;
+} XMC_BUCK_DESIGN_t;
+
+/**
+ * Structure defining the state of the averaged power stage. The switches are
+ * either driven with a duty, or both off (passive level of the PWM outputs),
+ * when the inductor current flows through the low-side body diode until it
+ * reaches zero.
+ */
+typedef struct XMC_BUCK
+{
+  const XMC_BUCK_DESIGN_t* m_pDesign;
+  double              m_Vin;        /**< Input voltage in V */
+  double              m_Load;       /**< Load current at XMC_BUCK_VOUT in A */
+  double              m_IL;         /**< Inductor current in A */
+  double              m_VC;         /**< Capacitor voltage in V */
+  double              m_VOut;       /**< Output voltage in V */
+  double              m_Pending;    /**< Duty of the next period with a delay */
+  bool                m_Delay;      /**< Duty applied one period late */
+  bool                m_Sync;       /**< Negative inductor current allowed */
+  double              m_EIn;        /**< Energy from the input in J */
+  double              m_EOut;       /**< Energy into the load in J */
+} XMC_BUCK_t;
+
+/******************************************************************************
+ * Global Variables
+ *****************************************************************************/
+static const XMC_BUCK_DESIGN_t xmcBuckDesigns[] =
+{
+  {
+    "XMC1302", 100e3, 640.0, 1000.0,
+    { +0.649757898241f, -0.582384858571f, -0.649256971688f, +0.582885785125f },
+    { +1.335491183190f, -0.211704021559f, -0.123787161631f },
+    +0.657007535988f, 3300U, 0U, 576U
+  },
+  {
+    "XMC4200", 200e3, 102400.0, 3215.0 / 3.3,
+    { +1.072329384164f, -1.009391619615f, -1.071806296352f, +1.009914707427f },
+    { +1.611302392630f, -0.426276608711f, -0.185025783919f },
+    +105.121205758148f, 3215U, 0U, 92160U
+  }
+};
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_BUCK_Init
+********************************************************************************
+* Summary:
+* This API starts the power stage from a discharged output.
+*
+* Parameters:
+* XMC_BUCK_t*              [out] ptr Pointer to the model structure
+* const XMC_BUCK_DESIGN_t* [in]  pDesign Target design
+* double                   [in]  vin Input voltage in V
+* double                   [in]  load Load current at XMC_BUCK_VOUT in A
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_BUCK_Init(XMC_BUCK_t* ptr,
+                                   const XMC_BUCK_DESIGN_t* pDesign,
+                                   double vin,
+                                   double load)
+{
+  memset(ptr, 0, sizeof(*ptr));
+  ptr->m_pDesign = pDesign;
+  ptr->m_Vin     = vin;
+  ptr->m_Load    = load;
+}
+
+/*******************************************************************************
+* Function Name: XMC_BUCK_Run
+********************************************************************************
+* Summary:
+* This function advances the power stage by one switching period. A negative
+* duty turns both switches off for the period.
+*
+* Parameters:
+* XMC_BUCK_t* [in/out] ptr Pointer to the model structure
+* double      [in]  duty Duty in ticks, or -1 for both switches off
+*
+* Return:
+*  double Output voltage at the end of the period
+*
+*******************************************************************************/
+__STATIC_INLINE double XMC_BUCK_Run(XMC_BUCK_t* ptr, double duty)
+{
+  double dt = 1.0 / (ptr->m_pDesign->m_Fs * XMC_BUCK_SUBSTEPS);
+  double rl = XMC_BUCK_VOUT / ptr->m_Load;
+  double vsw;
+  int k;
+
+  if (ptr->m_Delay)
+  {
+    double next = duty;
+
+    duty = ptr->m_Pending;
+    ptr->m_Pending = next;
+  }
+
+  for (k = 0; k < XMC_BUCK_SUBSTEPS; k++)
+  {
+    ptr->m_VOut = (ptr->m_VC + XMC_BUCK_ESR * ptr->m_IL) / (1.0 + XMC_BUCK_ESR / rl);
+    if (duty < 0.0)
+    {
+      /* Low-side body diode while the current flows */
+      vsw = (ptr->m_IL > 0.0) ? -XMC_BUCK_VF : ptr->m_VOut;
+    }
+    else
+    {
+      vsw = duty / ptr->m_pDesign->m_Period * ptr->m_Vin;
+      ptr->m_EIn += vsw * ptr->m_IL * dt;
+    }
+    ptr->m_IL += (vsw - ptr->m_VOut - XMC_BUCK_DCR * ptr->m_IL) / XMC_BUCK_L * dt;
+    if ((ptr->m_IL < 0.0) && (!ptr->m_Sync || (duty < 0.0)))
+    {
+      ptr->m_IL = 0.0;
+    }
+    ptr->m_VC   += (ptr->m_IL - ptr->m_VOut / rl) / XMC_BUCK_C * dt;
+    ptr->m_EOut += ptr->m_VOut * ptr->m_VOut / rl * dt;
+  }
+
+  return ptr->m_VOut;
+}
+
+/*******************************************************************************
+* Function Name: XMC_BUCK_Adc
+********************************************************************************
+* Summary:
+* This function converts a voltage with the output voltage divider and ADC
+* of the target.
+*
+* Parameters:
+* const XMC_BUCK_DESIGN_t* [in] pDesign Target design
+* double                   [in] v Voltage in V
+*
+* Return:
+*  uint32_t ADC result
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_BUCK_Adc(const XMC_BUCK_DESIGN_t* pDesign, double v)
+{
+  return (uint32_t)fmin(fmax(v * pDesign->m_AdcGain + 0.5, 0.0), 4095.0);
+}
+
+/*******************************************************************************
+* Function Name: XMC_BUCK_Noise
+********************************************************************************
+* Summary:
+* This function adds deterministic uniform noise to an ADC result, the same
+* sequence for every run with the same seed.
+*
+* Parameters:
+* uint32_t* [in/out] pSeed Generator state
+* uint32_t  [in]  adc ADC result
+* uint32_t  [in]  amplitude Noise in +/- counts
+*
+* Return:
+*  uint32_t Noisy ADC result
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t XMC_BUCK_Noise(uint32_t* pSeed, uint32_t adc, uint32_t amplitude)
+{
+  int32_t v;
+
+  *pSeed = *pSeed * 1664525U + 1013904223U;
+  v = (int32_t)adc + (int32_t)((*pSeed >> 16) % (2U * amplitude + 1U)) - (int32_t)amplitude;
+  return (uint32_t)((v < 0) ? 0 : ((v > 4095) ? 4095 : v));
+}
+
+#endif /* #ifndef XMC_BUCK_MODEL_H */
@@ -0,0 +1,341 @@
+/******************************************************************************
+* File Name:   xmc_burst_sim.c
+*
+* Description: Host simulation of the light-load burst mode of
+*              xmc_burst_mode.h. The loop of each target runs on a switched
+*              model of the synchronous buck with the complementary outputs
+*              of the code examples: the high-side switch conducts for the
+*              duty, the low-side switch for the rest of the period, and the
+*              inductor current may reverse. When both outputs are at the
+*              passive level, the current flows through the low-side body
+*              diode until it reaches zero. The averaged model of
+*              xmc_buck_model.h does not resolve the switching period, which
+*              decides the light load behaviour, so only its designs and stage
+*              values are used.
+*
+*              For each load, the tool compares the linear loop with burst
+*              mode when skipped pulses write the minimum duty, so the
+*              low-side switch conducts, and when they set the outputs to the
+*              passive level, as the code examples do. Burst mode runs with
+*              the BURST_xxx values of the code examples: it is entered at any
+*              duty, and the pulse count of each window sends heavy loads back
+*              to the linear loop. Switching and gate drive cost SIM_E_SWITCH
+*              per switched period.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_burst_sim xmc_burst_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_burst_mode.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_TIME              (0.6)       /* Measured over the second half */
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+#define SIM_SUBSTEPS          (400)       /* Integration steps per period */
+#define SIM_E_SWITCH          (100e-9)    /* Switching and gate drive per switched period in J */
+
+/* BURST_xxx of the code examples */
+#define BURST_ENTER_TIME      (0.1)       /* BURST_ENTER_SAMPLES in s */
+#define BURST_START_BAND      (10U)
+#define BURST_EXIT_BAND       (60U)
+#define BURST_WINDOW          (128U)
+
+/* Linear loop, burst mode skipping at the minimum duty, or with passive outputs */
+#define SIM_LINEAR            (0)
+#define SIM_SKIP_MIN_DUTY     (1)
+#define SIM_SKIP_PASSIVE      (2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Switched model of the power stage */
+typedef struct SIM_STAGE
+{
+    double              m_IL;         /* Inductor current in A */
+    double              m_VC;         /* Capacitor voltage in V */
+    double              m_VOut;       /* Output voltage in V */
+    double              m_EIn;        /* Energy from the input in J */
+    double              m_EOut;       /* Energy into the load in J */
+} SIM_STAGE_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* BURST_DUTY, BURST_PULSES and BURST_MAX_PULSES per target */
+static const uint32_t burstDuty[] = { 224U, 35840U };
+static const uint32_t burstPulses[] = { 1U, 1U };
+static const uint32_t burstMaxPulses[] = { 26U, 77U };
+
+static const double simLoads[] = { 0.02, 0.1, 0.3, 0.5, 1.0, 2.0, 4.0 };
+static const char* const simModes[] = { "linear", "skip min duty", "skip passive" };
+
+/*******************************************************************************
+* Function Name: stage_run
+********************************************************************************
+* Summary:
+* Runs the switched model for one PWM period. The high-side switch conducts
+* for the duty and the low-side switch for the rest of the period. With the
+* outputs passive, the current flows through the low-side body diode until it
+* reaches zero.
+*
+* Parameters:
+*  SIM_STAGE_t* s Stage
+*  const XMC_BUCK_DESIGN_t* d Design of the target
+*  double load Load current at 3.3 V in A
+*  double duty Duty in ticks
+*  bool passive Both outputs at the passive level
+*
+* Return:
+*  double Output voltage at the end of the period in V
+*
+*******************************************************************************/
+static double stage_run(SIM_STAGE_t* s, const XMC_BUCK_DESIGN_t* d, double load,
+                        double duty, bool passive)
+{
+    double dt = 1.0 / (d->m_Fs * SIM_SUBSTEPS);
+    double rl = XMC_BUCK_VOUT / load;
+    double on = passive ? 0.0 : duty / d->m_Period * SIM_SUBSTEPS;
+    double vsw;
+    double high;
+    double il;
+    int k;
+
+    for (k = 0; k < SIM_SUBSTEPS; k++)
+    {
+        s->m_VOut = (s->m_VC + XMC_BUCK_ESR * s->m_IL) / (1.0 + XMC_BUCK_ESR / rl);
+
+        /* Share of the step with the high-side switch on */
+        high = fmin(fmax(on - k, 0.0), 1.0);
+        if (passive)
+        {
+            vsw = (s->m_IL > 0.0) ? -XMC_BUCK_VF : s->m_VOut;
+        }
+        else
+        {
+            vsw = high * XMC_BUCK_VIN;
+        }
+
+        /* Trapezoidal input energy, the ripple is large against light loads */
+        il = s->m_IL;
+        s->m_IL += (vsw - s->m_VOut - XMC_BUCK_DCR * s->m_IL) / XMC_BUCK_L * dt;
+        s->m_EIn += vsw * 0.5 * (il + s->m_IL) * dt;
+        if (passive && (s->m_IL < 0.0))
+        {
+            s->m_IL = 0.0;
+        }
+        s->m_VC   += (s->m_IL - s->m_VOut / rl) / XMC_BUCK_C * dt;
+        s->m_EOut += s->m_VOut * s->m_VOut / rl * dt;
+    }
+
+    return s->m_VOut;
+}
+
+/*******************************************************************************
+* Function Name: run
+********************************************************************************
+* Summary:
+* Runs the loop of a target at one load in one mode and prints the efficiency,
+* the switched periods, the compensator executions and the ripple over the
+* second half of the run.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*  double load Load current in A
+*  int mode SIM_LINEAR, SIM_SKIP_MIN_DUTY or SIM_SKIP_PASSIVE
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run(int kit, double load, int mode)
+{
+    static volatile uint32_t adc;
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[kit];
+    XMC_3P3Z_DATA_FIXED_t fixed;
+    XMC_3P3Z_DATA_FLOAT_t flt;
+    XMC_BURST_t burst;
+    XMC_BURST_ACTION_t action;
+    SIM_STAGE_t stage;
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t seed = 1U;
+    uint32_t switched = 0U;
+    uint32_t filtered = 0U;
+    uint32_t n;
+    double eIn = 0.0;
+    double eOut = 0.0;
+    double vMin = 10.0;
+    double vMax = 0.0;
+    double duty;
+    double v;
+    bool passive;
+
+    memset(&stage, 0, sizeof(stage));
+    adc = 0U;
+    if (kit == XMC_BUCK_XMC1)
+    {
+        XMC_3P3Z_InitFixed(&fixed, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+    }
+    else
+    {
+        XMC_3P3Z_InitFloat(&flt, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+    }
+
+    /* The duty does not fall with the load on this stage, so any duty enters */
+    XMC_BURST_Init(&burst, d->m_DutyMax,
+                   (mode == SIM_LINEAR) ? 0U : (uint32_t)(BURST_ENTER_TIME * d->m_Fs),
+                   burstDuty[kit], burstPulses[kit], d->m_DutyMin, d->m_Ref,
+                   BURST_START_BAND, BURST_EXIT_BAND, BURST_WINDOW, burstMaxPulses[kit]);
+
+    for (n = 0; n < samples; n++)
+    {
+        /* As burst_mode_run of the code examples */
+        passive = false;
+        action = XMC_BURST_Update(&burst, adc);
+        if (action == XMC_BURST_APPLY_DUTY)
+        {
+            duty = (double)burst.m_Duty;
+            passive = burst.m_Passive && (mode == SIM_SKIP_PASSIVE);
+        }
+        else
+        {
+            if (action == XMC_BURST_RESUME)
+            {
+                if (kit == XMC_BUCK_XMC1)
+                {
+                    XMC_3P3Z_PresetFixed(&fixed, (int32_t)burst.m_ResumeDuty);
+                }
+                else
+                {
+                    XMC_3P3Z_PresetFloat(&flt, (float)burst.m_ResumeDuty);
+                }
+            }
+            if (kit == XMC_BUCK_XMC1)
+            {
+                XMC_3P3Z_FilterFixed(&fixed);
+                duty = (double)fixed.m_pOut;
+            }
+            else
+            {
+                XMC_3P3Z_FilterFloat(&flt);
+                duty = (double)flt.m_Out;
+            }
+            XMC_BURST_Observe(&burst, (uint32_t)duty);
+        }
+
+        if (n == samples / 2U)
+        {
+            eIn = stage.m_EIn;
+            eOut = stage.m_EOut;
+            switched = 0U;
+            filtered = 0U;
+        }
+        if (!passive && (duty > 0.0))
+        {
+            switched++;
+        }
+        if (action != XMC_BURST_APPLY_DUTY)
+        {
+            filtered++;
+        }
+
+        v = stage_run(&stage, d, load, duty, passive);
+        adc = XMC_BUCK_Noise(&seed, XMC_BUCK_Adc(d, v), SIM_NOISE);
+        if (n >= samples / 2U)
+        {
+            vMin = fmin(vMin, v);
+            vMax = fmax(vMax, v);
+        }
+    }
+
+    eIn  = stage.m_EIn - eIn + switched * SIM_E_SWITCH;
+    eOut = stage.m_EOut - eOut;
+    printf("%-8s %6.2f  %-14s %6.1f %11.1f %11.1f %7.0f\n", d->m_Name, load, simModes[mode],
+           100.0 * eOut / eIn, 100.0 * switched / (samples - samples / 2U),
+           100.0 * filtered / (samples - samples / 2U), (vMax - vMin) * 1e3);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs both targets at every load in every mode.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t i;
+    int kit;
+    int mode;
+
+    printf("%.0f V to %.1f V, %.0f nJ per switched period\n", XMC_BUCK_VIN, XMC_BUCK_VOUT,
+           SIM_E_SWITCH * 1e9);
+    printf("%-8s %6s  %-14s %6s %11s %11s %7s\n", "target", "load A", "mode",
+           "eff %", "switched %", "filtered %", "p-p mV");
+    for (kit = XMC_BUCK_XMC1; kit <= XMC_BUCK_XMC4; kit++)
+    {
+        for (i = 0U; i < sizeof(simLoads) / sizeof(simLoads[0]); i++)
+        {
+            for (mode = SIM_LINEAR; mode <= SIM_SKIP_PASSIVE; mode++)
+            {
+                run(kit, simLoads[i], mode);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,372 @@
+/******************************************************************************
+* File Name:   xmc_cmd_board_sim.c
+*
+* Description: Stand-in for the board on the command channel. It opens a
+*              pseudo terminal, prints its name and serves the command
+*              protocol with the same code as the firmware: a floating point
+*              3p3z voltage loop runs on an averaged model of the buck
+*              converter, takes parameter updates at a sample boundary,
+*              feeds the regulation statistics and records the control loop
+*              trace. It lets xmc_cmd_client and other host tools be tried
+*              without hardware. Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_cmd_board_sim xmc_cmd_board_sim.c -lm
+*
+*              Run it, then pass the printed /dev/pts/N to xmc_cmd_client.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define __STATIC_INLINE static inline
+/* The ISR and the main context of the simulated board share one thread */
+#define __DMB()         __asm__ volatile ("" ::: "memory")
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_reg_stats.h"
+#include "xmc_cmd.h"
+#include "xmc_trace.h"
+#include "xmc_compensator.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_KIT               (4U)        /* Reported as an XMC4 target */
+#define SIM_FS                (200e3)     /* Control loop frequency in Hz */
+#define SIM_PERIOD            (102400.0)  /* Switching period in duty ticks */
+#define SIM_VIN               (12.0)      /* Input voltage in V */
+#define SIM_L                 (10e-6)     /* Inductance in H */
+#define SIM_C                 (470e-6)    /* Output capacitance in F */
+#define SIM_ESR               (0.01)      /* Capacitor ESR in Ohm */
+#define SIM_DCR               (0.02)      /* Inductor DCR in Ohm */
+#define SIM_RLOAD             (3.3)       /* Load in Ohm */
+#define SIM_ADC_GAIN          (3215.0 / 3.3) /* ADC counts per V */
+#define SIM_SUBSTEPS          (50)        /* Integration steps per sample */
+#define SIM_SAMPLES_PER_POLL  (200U)      /* Samples simulated per 1 ms */
+
+#define REF                   (3215)
+#define DUTY_TICKS_MIN        (0)
+#define DUTY_TICKS_MAX        (92160)
+#define REG_STATS_LOG2_WINDOW (10U)
+#define TRACE_BUF_SIZE        (16384U)
+#define TRACE_DECIMATION      (256U)
+#define TRACE_SYNC_INTERVAL   (256U)
+
+/*******************************************************************************
+* Global Variable
+*******************************************************************************/
+static volatile uint32_t adc_result;
+static XMC_3P3Z_DATA_FLOAT_t ctrlFloat;
+static XMC_3P3Z_DATA_FLOAT_t ctrlNext;
+static uint32_t tunePending;
+static uint32_t tuneApplied;
+static XMC_STATS_t regStats;
+static XMC_STATS_RESULT_t regStatsResult;
+static XMC_CMD_SERVER_t cmdServer;
+static XMC_TRACE_t trace;
+static uint8_t traceBuf[TRACE_BUF_SIZE];
+static float traceParam[XMC_CMD_PARAM_COUNT];
+
+/* Voltage loop of the averaged model below */
+static const float cmdDefaults[XMC_CMD_PARAM_COUNT] =
+{
+    1.072329384164f, -1.009391619615f, -1.071806296352f, 1.009914707427f,
+    1.611302392630f, -0.426276608711f, -0.185025783919f, 105.121205758148f,
+    REF, DUTY_TICKS_MIN, DUTY_TICKS_MAX
+};
+
+/* Plant state */
+static double iL;
+static double vC;
+static double vOut;
+
+/*******************************************************************************
+* Function Name: cmd_apply
+********************************************************************************
+* Summary:
+* Checks a parameter set and hands it to the control loop, as on the target.
+*
+* Parameters:
+*  const float* p XMC_CMD_PARAM_COUNT parameters
+*
+* Return:
+*  XMC_CMD_STATUS_t XMC_CMD_OK, XMC_CMD_ERR_VALUE or XMC_CMD_BUSY
+*
+*******************************************************************************/
+static XMC_CMD_STATUS_t cmd_apply(const float* p)
+{
+    if (tunePending != 0U)
+    {
+        return XMC_CMD_BUSY;
+    }
+
+    if ((p[XMC_CMD_PARAM_REF] < 0.0f) || (p[XMC_CMD_PARAM_REF] > 4095.0f) ||
+        (p[XMC_CMD_PARAM_OUT_MIN] < 0.0f) ||
+        (p[XMC_CMD_PARAM_OUT_MIN] >= p[XMC_CMD_PARAM_OUT_MAX]) ||
+        (p[XMC_CMD_PARAM_OUT_MAX] > (float)DUTY_TICKS_MAX))
+    {
+        return XMC_CMD_ERR_VALUE;
+    }
+
+    XMC_3P3Z_InitFloat(&ctrlNext,
+                       p[XMC_CMD_PARAM_B0], p[XMC_CMD_PARAM_B1],
+                       p[XMC_CMD_PARAM_B2], p[XMC_CMD_PARAM_B3],
+                       p[XMC_CMD_PARAM_A1], p[XMC_CMD_PARAM_A2],
+                       p[XMC_CMD_PARAM_A3], p[XMC_CMD_PARAM_K],
+                       (uint16_t)p[XMC_CMD_PARAM_REF],
+                       p[XMC_CMD_PARAM_OUT_MIN], p[XMC_CMD_PARAM_OUT_MAX],
+                       &adc_result);
+    memcpy(traceParam, p, sizeof(traceParam));
+    tunePending = 1U;
+
+    return XMC_CMD_OK;
+}
+
+/*******************************************************************************
+* Function Name: cmd_dump
+********************************************************************************
+* Summary:
+* Fills the regulator state of the model.
+*
+* Parameters:
+*  XMC_CMD_STATE_t* pState State to fill
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void cmd_dump(XMC_CMD_STATE_t* pState)
+{
+    XMC_STATS_Read(&regStats, &regStatsResult);
+
+    pState->m_Vout      = adc_result;
+    pState->m_Ref       = ctrlFloat.m_Ref;
+    pState->m_Out       = ctrlFloat.m_Out;
+    pState->m_SatCount  = ctrlFloat.m_SatCount;
+    pState->m_Applied   = tuneApplied;
+    pState->m_StatsSeq  = regStatsResult.m_Seq;
+    pState->m_MeanV     = regStatsResult.m_MeanV;
+    pState->m_RippleRms = regStatsResult.m_RippleRms;
+    pState->m_Idle      = 0U;
+    pState->m_Flags     = (tunePending != 0U) ? XMC_CMD_FLAG_PENDING : 0U;
+}
+
+/*******************************************************************************
+* Function Name: cmd_trace
+********************************************************************************
+* Summary:
+* Reads the trace for the command channel.
+*
+* Parameters:
+*  bool     header true for the header, false for the next bytes of the stream
+*  uint32_t offset First header byte
+*  uint8_t* pBuf Destination
+*  uint32_t max Size of the destination
+*
+* Return:
+*  uint32_t Bytes read
+*
+*******************************************************************************/
+static uint32_t cmd_trace(bool header, uint32_t offset, uint8_t* pBuf, uint32_t max)
+{
+    if (header)
+    {
+        return XMC_TRACE_ReadHeader(&trace, offset, pBuf, max);
+    }
+
+    return XMC_TRACE_Read(&trace, pBuf, max);
+}
+
+/*******************************************************************************
+* Function Name: control_sample
+********************************************************************************
+* Summary:
+* One control period: ADC sample, pending update, compensator, trace, then
+* the averaged buck model over one switching period.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void control_sample(void)
+{
+    double dt = 1.0 / (SIM_FS * SIM_SUBSTEPS);
+    double duty;
+    double vl;
+    bool tuned = false;
+    int k;
+
+    adc_result = (uint32_t)(vOut * SIM_ADC_GAIN + 0.5);
+    if (adc_result > 4095U)
+    {
+        adc_result = 4095U;
+    }
+
+    if (tunePending != 0U)
+    {
+        XMC_3P3Z_UpdateFloat(&ctrlFloat, &ctrlNext);
+        tuneApplied++;
+        tunePending = 0U;
+        tuned = true;
+    }
+
+    XMC_3P3Z_FilterFloat(&ctrlFloat);
+    (void)XMC_STATS_Update(&regStats, adc_result, (int32_t)ctrlFloat.m_Ref - (int32_t)adc_result);
+
+    XMC_TRACE_Sample(&trace, adc_result, ctrlFloat.m_Out);
+    if (tuned)
+    {
+        XMC_TRACE_Event(&trace, XMC_TRACE_EV_TUNE, (int32_t)tuneApplied);
+        XMC_TRACE_Param(&trace, traceParam);
+    }
+
+    duty = (double)ctrlFloat.m_Out / SIM_PERIOD;
+    for (k = 0; k < SIM_SUBSTEPS; k++)
+    {
+        vOut = (vC + SIM_ESR * iL) / (1.0 + SIM_ESR / SIM_RLOAD);
+        vl   = duty * SIM_VIN - vOut - SIM_DCR * iL;
+        iL  += vl / SIM_L * dt;
+        vC  += (iL - vOut / SIM_RLOAD) / SIM_C * dt;
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Opens the pseudo terminal, then runs the model and serves the requests.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int 0 on success
+*
+*******************************************************************************/
+int main(void)
+{
+    struct termios tio;
+    struct pollfd pfd;
+    uint8_t buf[64];
+    uint8_t frame[XMC_CMD_MAX_FRAME];
+    ssize_t n;
+    ssize_t i;
+    uint32_t len;
+    uint32_t s;
+    int fd;
+    XMC_TRACE_HEADER_t traceHeader =
+    {
+        .m_Kit        = SIM_KIT,
+        .m_Backend    = XMC_COMP_FLOAT,
+        .m_AwMode     = XMC_3P3Z_AW_CLAMP,
+        .m_PeriodNs   = (uint32_t)(1e9 / SIM_FS),
+        .m_Decimation = TRACE_DECIMATION
+    };
+
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0))
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+    printf("%s\n", ptsname(fd));
+    fflush(stdout);
+
+    XMC_3P3Z_InitFloat(&ctrlFloat,
+                       cmdDefaults[XMC_CMD_PARAM_B0], cmdDefaults[XMC_CMD_PARAM_B1],
+                       cmdDefaults[XMC_CMD_PARAM_B2], cmdDefaults[XMC_CMD_PARAM_B3],
+                       cmdDefaults[XMC_CMD_PARAM_A1], cmdDefaults[XMC_CMD_PARAM_A2],
+                       cmdDefaults[XMC_CMD_PARAM_A3], cmdDefaults[XMC_CMD_PARAM_K],
+                       REF, DUTY_TICKS_MIN, DUTY_TICKS_MAX, &adc_result);
+    XMC_STATS_Init(&regStats, REG_STATS_LOG2_WINDOW);
+    memcpy(traceHeader.m_Param, cmdDefaults, sizeof(traceHeader.m_Param));
+    memcpy(traceParam, cmdDefaults, sizeof(traceParam));
+    XMC_TRACE_Init(&trace, traceBuf, TRACE_BUF_SIZE, &traceHeader, TRACE_SYNC_INTERVAL);
+    XMC_CMD_ServerInit(&cmdServer, SIM_KIT, cmdDefaults, cmd_apply, cmd_dump);
+    XMC_CMD_ServerSetTrace(&cmdServer, cmd_trace);
+
+    pfd.fd     = fd;
+    pfd.events = POLLIN;
+    for (;;)
+    {
+        /* Roughly real time, 1 ms of switching periods per poll */
+        for (s = 0U; s < SIM_SAMPLES_PER_POLL; s++)
+        {
+            control_sample();
+        }
+
+        if (poll(&pfd, 1, 1) <= 0)
+        {
+            continue;
+        }
+        /* EIO, with POLLHUP, while no client has the slave side open */
+        n = read(fd, buf, sizeof(buf));
+        if (n < 0)
+        {
+            (void)usleep(1000);
+        }
+        for (i = 0; i < n; i++)
+        {
+            if (XMC_CMD_ParserFeed(&cmdServer.m_Parser, buf[i]))
+            {
+                len = XMC_CMD_Handle(&cmdServer, &cmdServer.m_Parser.m_Frame, frame);
+                if (write(fd, frame, len) != (ssize_t)len)
+                {
+                    perror("write");
+                }
+            }
+        }
+    }
+
+    return 0;
+}
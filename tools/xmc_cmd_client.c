@@ -0,0 +1,448 @@
+/******************************************************************************
+* File Name:   xmc_cmd_client.c
+*
+* Description: Host client of the command channel (source/common/xmc_cmd.h).
+*              It sends one request over a serial port and prints the
+*              response. Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_cmd_client xmc_cmd_client.c
+*
+*              Usage: xmc_cmd_client <port> ping
+*                     xmc_cmd_client <port> get <param>
+*                     xmc_cmd_client <port> set <param> <value>
+*                     xmc_cmd_client <port> apply
+*                     xmc_cmd_client <port> tune <param> <value>
+*                     xmc_cmd_client <port> ref <adc counts>
+*                     xmc_cmd_client <port> dump
+*                     xmc_cmd_client <port> trace <file> <seconds>
+*
+*              <param> is one of b0 b1 b2 b3 a1 a2 a3 k ref out_min out_max.
+*              tune is set followed by apply. trace saves the control loop
+*              trace of the board (xmc_trace.h) for tools/xmc_trace.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_cmd.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CLIENT_TIMEOUT_MS         (500)
+
+/*******************************************************************************
+* Global Variable
+*******************************************************************************/
+static const char* const paramNames[XMC_CMD_PARAM_COUNT] =
+{
+    "b0", "b1", "b2", "b3", "a1", "a2", "a3", "k", "ref", "out_min", "out_max"
+};
+
+static const char* const statusNames[] =
+{
+    "ok", "unknown command", "wrong length", "unknown parameter",
+    "value out of range", "busy, previous update pending"
+};
+
+/*******************************************************************************
+* Function Name: port_open
+********************************************************************************
+* Summary:
+* Opens the serial port in raw mode at 115200 baud.
+*
+* Parameters:
+*  const char* path Serial port or pty
+*
+* Return:
+*  int File descriptor, -1 on error
+*
+*******************************************************************************/
+static int port_open(const char* path)
+{
+    struct termios tio;
+    int fd = open(path, O_RDWR | O_NOCTTY);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tio.c_cc[VMIN]  = 0;
+        tio.c_cc[VTIME] = 0;
+        (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+    (void)tcflush(fd, TCIOFLUSH);
+
+    return fd;
+}
+
+/*******************************************************************************
+* Function Name: transact
+********************************************************************************
+* Summary:
+* Sends a request and waits for the matching response.
+*
+* Parameters:
+*  int              fd Serial port
+*  uint8_t          cmd Command
+*  const uint8_t*   pPayload Request payload
+*  uint32_t         len Request payload length
+*  XMC_CMD_FRAME_t* pResp Response
+*
+* Return:
+*  int 0 on success, -1 on timeout or I/O error
+*
+*******************************************************************************/
+static int transact(int fd, uint8_t cmd, const uint8_t* pPayload, uint32_t len,
+                    XMC_CMD_FRAME_t* pResp)
+{
+    uint8_t frame[XMC_CMD_MAX_FRAME];
+    uint8_t data;
+    uint32_t flen = XMC_CMD_Encode(frame, cmd, pPayload, len);
+    XMC_CMD_PARSER_t parser;
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    if (write(fd, frame, flen) != (ssize_t)flen)
+    {
+        return -1;
+    }
+
+    XMC_CMD_ParserInit(&parser);
+    while (poll(&pfd, 1, CLIENT_TIMEOUT_MS) > 0)
+    {
+        if (read(fd, &data, 1) != 1)
+        {
+            continue;
+        }
+        if (XMC_CMD_ParserFeed(&parser, data) &&
+            (parser.m_Frame.m_Cmd == (uint8_t)(cmd | XMC_CMD_RESPONSE)))
+        {
+            *pResp = parser.m_Frame;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: param_id
+********************************************************************************
+* Summary:
+* Looks up a parameter by name.
+*
+* Parameters:
+*  const char* name Parameter name
+*
+* Return:
+*  int Parameter id, -1 if unknown
+*
+*******************************************************************************/
+static int param_id(const char* name)
+{
+    int i;
+
+    for (i = 0; i < (int)XMC_CMD_PARAM_COUNT; i++)
+    {
+        if (strcmp(name, paramNames[i]) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: trace_capture
+********************************************************************************
+* Summary:
+* Saves the trace header, then the trace stream of the board for a time.
+*
+* Parameters:
+*  int         fd Port
+*  const char* path Trace file
+*  double      seconds Capture time
+*
+* Return:
+*  int 0 on success, 1 on error
+*
+*******************************************************************************/
+static int trace_capture(int fd, const char* path, double seconds)
+{
+    XMC_CMD_FRAME_t resp;
+    uint8_t offset = 0U;
+    uint64_t bytes = 0U;
+    time_t end = time(NULL) + (time_t)seconds;
+    FILE* f = fopen(path, "wb");
+
+    if (f == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    /* Header, then the stream until the time is over */
+    do
+    {
+        if ((transact(fd, XMC_CMD_TRACE, &offset, 1U, &resp) != 0) ||
+            (resp.m_Len == 0U) || (resp.m_Payload[0] != XMC_CMD_OK))
+        {
+            fprintf(stderr, "no trace\n");
+            fclose(f);
+            return 1;
+        }
+        fwrite(&resp.m_Payload[1], 1, resp.m_Len - 1U, f);
+        offset += (uint8_t)(resp.m_Len - 1U);
+    } while (resp.m_Len > 1U);
+
+    while (time(NULL) < end)
+    {
+        if ((transact(fd, XMC_CMD_TRACE, &offset, 0U, &resp) != 0) ||
+            (resp.m_Len == 0U) || (resp.m_Payload[0] != XMC_CMD_OK))
+        {
+            fprintf(stderr, "no response\n");
+            fclose(f);
+            return 1;
+        }
+        fwrite(&resp.m_Payload[1], 1, resp.m_Len - 1U, f);
+        bytes += resp.m_Len - 1U;
+    }
+
+    fclose(f);
+    printf("%llu bytes in %.0f s, %.1f kB/s\n", (unsigned long long)bytes, seconds,
+           (double)bytes / seconds * 1e-3);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: usage
+********************************************************************************
+* Summary:
+* Prints the command line help.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int Exit code
+*
+*******************************************************************************/
+static int usage(void)
+{
+    fprintf(stderr,
+            "usage: xmc_cmd_client <port> ping | get <param> | set <param> <value> |\n"
+            "                             apply | tune <param> <value> | ref <counts> | dump |\n"
+            "                             trace <file> <seconds>\n"
+            "params: b0 b1 b2 b3 a1 a2 a3 k ref out_min out_max\n");
+    return 2;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Sends the request given on the command line and prints the response.
+*
+* Parameters:
+*  int    argc Argument count
+*  char** argv Arguments
+*
+* Return:
+*  int 0 on success, 1 on error status or timeout, 2 on usage error
+*
+*******************************************************************************/
+int main(int argc, char** argv)
+{
+    XMC_CMD_FRAME_t resp;
+    XMC_CMD_STATE_t state;
+    uint8_t req[XMC_CMD_MAX_PAYLOAD];
+    uint8_t cmd;
+    uint32_t len = 0U;
+    uint32_t ref;
+    int fd;
+    int id = -1;
+    bool tune = false;
+
+    if (argc < 3)
+    {
+        return usage();
+    }
+
+    if (strcmp(argv[2], "ping") == 0)
+    {
+        cmd = XMC_CMD_PING;
+    }
+    else if ((strcmp(argv[2], "get") == 0) && (argc == 4))
+    {
+        cmd = XMC_CMD_GET;
+        id  = param_id(argv[3]);
+        req[0] = (uint8_t)id;
+        len = 1U;
+    }
+    else if (((strcmp(argv[2], "set") == 0) || (strcmp(argv[2], "tune") == 0)) && (argc == 5))
+    {
+        cmd  = XMC_CMD_SET;
+        tune = (argv[2][0] == 't');
+        id   = param_id(argv[3]);
+        req[0] = (uint8_t)id;
+        XMC_CMD_PutFloat(&req[1], strtof(argv[4], NULL));
+        len = 5U;
+    }
+    else if (strcmp(argv[2], "apply") == 0)
+    {
+        cmd = XMC_CMD_APPLY;
+    }
+    else if ((strcmp(argv[2], "ref") == 0) && (argc == 4))
+    {
+        cmd = XMC_CMD_SET_REF;
+        ref = (uint32_t)strtoul(argv[3], NULL, 0);
+        req[0] = (uint8_t)ref;
+        req[1] = (uint8_t)(ref >> 8);
+        len = 2U;
+    }
+    else if (strcmp(argv[2], "dump") == 0)
+    {
+        cmd = XMC_CMD_DUMP;
+    }
+    else if ((strcmp(argv[2], "trace") == 0) && (argc == 5))
+    {
+        cmd = XMC_CMD_TRACE;
+    }
+    else
+    {
+        return usage();
+    }
+
+    if (((cmd == XMC_CMD_GET) || (cmd == XMC_CMD_SET)) && (id < 0))
+    {
+        fprintf(stderr, "unknown parameter %s\n", argv[3]);
+        return usage();
+    }
+
+    fd = port_open(argv[1]);
+    if (fd < 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    if (cmd == XMC_CMD_TRACE)
+    {
+        id = trace_capture(fd, argv[3], atof(argv[4]));
+        close(fd);
+        return id;
+    }
+
+    if (transact(fd, cmd, req, len, &resp) != 0)
+    {
+        fprintf(stderr, "no response\n");
+        return 1;
+    }
+    if (tune && (resp.m_Payload[0] == XMC_CMD_OK))
+    {
+        cmd = XMC_CMD_APPLY;
+        if (transact(fd, cmd, req, 0U, &resp) != 0)
+        {
+            fprintf(stderr, "no response\n");
+            return 1;
+        }
+    }
+    close(fd);
+
+    if ((resp.m_Len == 0U) || (resp.m_Payload[0] != XMC_CMD_OK))
+    {
+        fprintf(stderr, "error: %s\n",
+                (resp.m_Len != 0U) && (resp.m_Payload[0] <= XMC_CMD_BUSY) ?
+                statusNames[resp.m_Payload[0]] : "malformed response");
+        return 1;
+    }
+
+    switch (cmd)
+    {
+        case XMC_CMD_PING:
+            printf("protocol %u, kit XMC%u, %u parameters\n",
+                   resp.m_Payload[1], resp.m_Payload[2], resp.m_Payload[3]);
+            break;
+
+        case XMC_CMD_GET:
+            printf("%s = %.9g\n", paramNames[resp.m_Payload[1]],
+                   XMC_CMD_GetFloat(&resp.m_Payload[2]));
+            break;
+
+        case XMC_CMD_DUMP:
+            XMC_CMD_GetState(&resp.m_Payload[1], &state);
+            printf("vout      %u\n", (unsigned)state.m_Vout);
+            printf("ref       %u\n", (unsigned)state.m_Ref);
+            printf("out       %u\n", (unsigned)state.m_Out);
+            printf("saturated %u\n", (unsigned)state.m_SatCount);
+            printf("applied   %u%s\n", (unsigned)state.m_Applied,
+                   (state.m_Flags & XMC_CMD_FLAG_PENDING) ? " (pending)" : "");
+            printf("window    %u: mean %.1f, ripple %.2f rms\n", (unsigned)state.m_StatsSeq,
+                   state.m_MeanV, state.m_RippleRms);
+            printf("idle      %.2f %%\n", state.m_Idle / 100.0);
+            printf("features %s%s%s%s\n",
+                   (state.m_Flags & XMC_CMD_FLAG_CURRENT_MODE) ? " current-mode" : "",
+                   (state.m_Flags & XMC_CMD_FLAG_PREDICTOR) ? " predictor" : "",
+                   (state.m_Flags & XMC_CMD_FLAG_FEEDFORWARD) ? " feedforward" : "",
+                   (state.m_Flags & XMC_CMD_FLAG_BURST) ? " burst" : "");
+            printf("pwm       %s\n",
+                   (state.m_Flags & XMC_CMD_FLAG_FAULT) ? "shut down (fault)" : "running");
+            break;
+
+        default:
+            printf("ok\n");
+            break;
+    }
+
+    return 0;
+}
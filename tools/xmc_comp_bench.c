@@ -0,0 +1,534 @@
+/******************************************************************************
+* File Name:   xmc_comp_bench.c
+*
+* Description: Host benchmark of the compensator backends of
+*              xmc_compensator.h. Every backend runs the XMC1302 and XMC4200
+*              designs on the same stimuli: a start-up and load steps on an
+*              averaged model of the buck converter, with the same ADC noise.
+*              For each backend it reports the time per sample and the code
+*              size of the filter on this host, the state size, and the error
+*              against a double precision reference of the same filter:
+*              the duty error when the backend is fed the samples of the
+*              reference loop, and the output voltage error in its own loop.
+*              Built on Linux with:
+*
+*              gcc -O2 -fwrapv -Wall -I../source/common -o xmc_comp_bench xmc_comp_bench.c -lm
+*
+*              The partial sums of B x E in the fixed kernel can leave the
+*              int32 range even when the final sum fits. Signed overflow is
+*              undefined in C, and -fwrapv makes it wrap as the ARM adds do,
+*              so the host computes the same sum as the target.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_q15.h"
+#include "xmc_3p3z_filter_q31.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_VIN               (12.0)      /* Input voltage in V */
+#define SIM_L                 (10e-6)     /* Inductance in H */
+#define SIM_C                 (470e-6)    /* Output capacitance in F */
+#define SIM_ESR               (0.01)      /* Capacitor ESR in Ohm */
+#define SIM_DCR               (0.02)      /* Inductor DCR in Ohm */
+#define SIM_VOUT              (3.3)       /* Nominal output voltage in V */
+#define SIM_ILOAD_LOW         (1.0)       /* Load current in A */
+#define SIM_ILOAD_HIGH        (8.0)
+#define SIM_SUBSTEPS          (20)        /* Integration steps per sample */
+#define SIM_TIME              (0.03)      /* Start-up, load step at 10 ms, back at 20 ms */
+#define SIM_NOISE             (2)         /* ADC noise, uniform in +/- counts */
+#define SIM_SETTLED           (0.005)     /* Mean error over the last 5 ms */
+#define BENCH_MAX_SAMPLES     (6000)
+#define BENCH_TIMING_RUNS     (200)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Compensator design and converter of one target */
+typedef struct BENCH_DESIGN
+{
+    const char*         m_Name;
+    double              m_Fs;         /* Control loop frequency in Hz */
+    double              m_Period;     /* Switching period in duty ticks */
+    double              m_AdcGain;    /* ADC counts per V */
+    float               m_B[4];
+    float               m_A[3];
+    float               m_K;
+    uint16_t            m_Ref;
+    uint32_t            m_DutyMin;
+    uint32_t            m_DutyMax;
+} BENCH_DESIGN_t;
+
+/* Backend under test. The filter step is not inlined and is placed in its
+ * own section, whose size is the code size of the filter. */
+typedef struct BENCH_BACKEND
+{
+    const char*         m_Name;
+    size_t              m_StateSize;
+    void                (*m_Init)(void* p, const BENCH_DESIGN_t* d, volatile uint32_t* fb);
+    uint32_t            (*m_Step)(void* p);
+    const char*         m_CodeStart;
+    const char*         m_CodeStop;
+} BENCH_BACKEND_t;
+
+/* Double precision reference, direct form I with the clamping of
+ * XMC_3P3Z_AW_CLAMP */
+typedef struct BENCH_REF
+{
+    volatile uint32_t*  m_pFeedBack;
+    double              m_B[4];
+    double              m_A[3];
+    double              m_E[3];
+    double              m_U[3];
+    double              m_Min;
+    double              m_Max;
+    double              m_Ref;
+} BENCH_REF_t;
+
+/* Averaged buck converter */
+typedef struct BENCH_PLANT
+{
+    double              m_IL;
+    double              m_VC;
+    double              m_VOut;
+} BENCH_PLANT_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const BENCH_DESIGN_t designs[] =
+{
+    {
+        "XMC1302", 100e3, 640.0, 1000.0,
+        { +0.649757898241f, -0.582384858571f, -0.649256971688f, +0.582885785125f },
+        { +1.335491183190f, -0.211704021559f, -0.123787161631f },
+        +0.657007535988f, 3300U, 0U, 576U
+    },
+    {
+        "XMC4200", 200e3, 102400.0, 3215.0 / 3.3,
+        { +1.072329384164f, -1.009391619615f, -1.071806296352f, +1.009914707427f },
+        { +1.611302392630f, -0.426276608711f, -0.185025783919f },
+        +105.121205758148f, 3215U, 0U, 92160U
+    }
+};
+
+/* Recorded trace of the reference loop */
+static uint32_t traceAdc[BENCH_MAX_SAMPLES];
+static double traceDuty[BENCH_MAX_SAMPLES];
+static double traceVOut[BENCH_MAX_SAMPLES];
+
+/*******************************************************************************
+* Backends
+*******************************************************************************/
+__attribute__((noinline, section("bench_float")))
+static uint32_t step_float(void* p)
+{
+    XMC_3P3Z_FilterFloat((XMC_3P3Z_DATA_FLOAT_t*)p);
+    return ((XMC_3P3Z_DATA_FLOAT_t*)p)->m_Out;
+}
+
+__attribute__((noinline, section("bench_fixed")))
+static uint32_t step_fixed(void* p)
+{
+    XMC_3P3Z_FilterFixed((XMC_3P3Z_DATA_FIXED_t*)p);
+    return ((XMC_3P3Z_DATA_FIXED_t*)p)->m_pOut;
+}
+
+__attribute__((noinline, section("bench_q15")))
+static uint32_t step_q15(void* p)
+{
+    XMC_3P3Z_FilterQ15((XMC_3P3Z_DATA_Q15_t*)p);
+    return ((XMC_3P3Z_DATA_Q15_t*)p)->m_pOut;
+}
+
+__attribute__((noinline, section("bench_q31")))
+static uint32_t step_q31(void* p)
+{
+    XMC_3P3Z_FilterQ31((XMC_3P3Z_DATA_Q31_t*)p);
+    return ((XMC_3P3Z_DATA_Q31_t*)p)->m_pOut;
+}
+
+static void init_float(void* p, const BENCH_DESIGN_t* d, volatile uint32_t* fb)
+{
+    XMC_3P3Z_InitFloat(p, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3],
+                       d->m_A[0], d->m_A[1], d->m_A[2], d->m_K,
+                       d->m_Ref, (float)d->m_DutyMin, (float)d->m_DutyMax, fb);
+}
+
+static void init_fixed(void* p, const BENCH_DESIGN_t* d, volatile uint32_t* fb)
+{
+    XMC_3P3Z_InitFixed(p, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3],
+                       d->m_A[0], d->m_A[1], d->m_A[2], d->m_K,
+                       d->m_Ref, d->m_DutyMin, d->m_DutyMax, fb);
+}
+
+static void init_q15(void* p, const BENCH_DESIGN_t* d, volatile uint32_t* fb)
+{
+    XMC_3P3Z_InitQ15(p, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3],
+                     d->m_A[0], d->m_A[1], d->m_A[2], d->m_K,
+                     d->m_Ref, d->m_DutyMin, d->m_DutyMax, fb);
+}
+
+static void init_q31(void* p, const BENCH_DESIGN_t* d, volatile uint32_t* fb)
+{
+    XMC_3P3Z_InitQ31(p, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3],
+                     d->m_A[0], d->m_A[1], d->m_A[2], d->m_K,
+                     d->m_Ref, d->m_DutyMin, d->m_DutyMax, fb);
+}
+
+extern const char __start_bench_float[], __stop_bench_float[];
+extern const char __start_bench_fixed[], __stop_bench_fixed[];
+extern const char __start_bench_q15[], __stop_bench_q15[];
+extern const char __start_bench_q31[], __stop_bench_q31[];
+
+static const BENCH_BACKEND_t backends[] =
+{
+    { "float",     sizeof(XMC_3P3Z_DATA_FLOAT_t), init_float, step_float,
+      __start_bench_float, __stop_bench_float },
+    { "Q19/Q14",   sizeof(XMC_3P3Z_DATA_FIXED_t), init_fixed, step_fixed,
+      __start_bench_fixed, __stop_bench_fixed },
+    { "Q15",       sizeof(XMC_3P3Z_DATA_Q15_t),   init_q15,   step_q15,
+      __start_bench_q15,   __stop_bench_q15 },
+    { "Q31-64",    sizeof(XMC_3P3Z_DATA_Q31_t),   init_q31,   step_q31,
+      __start_bench_q31,   __stop_bench_q31 }
+};
+
+/*******************************************************************************
+* Function Name: ref_init
+********************************************************************************
+* Summary:
+* Fills the double precision reference from a design.
+*
+* Parameters:
+*  BENCH_REF_t* p Reference filter
+*  const BENCH_DESIGN_t* d Design
+*  volatile uint32_t* fb Feedback sample
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ref_init(BENCH_REF_t* p, const BENCH_DESIGN_t* d, volatile uint32_t* fb)
+{
+    int i;
+
+    memset(p, 0, sizeof(*p));
+    p->m_pFeedBack = fb;
+    for (i = 0; i < 4; i++)
+    {
+        p->m_B[i] = (double)d->m_B[i] * (double)d->m_K;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        p->m_A[i] = (double)d->m_A[i];
+    }
+    p->m_Min = (double)d->m_DutyMin;
+    p->m_Max = (double)d->m_DutyMax;
+    p->m_Ref = (double)d->m_Ref;
+}
+
+/*******************************************************************************
+* Function Name: ref_step
+********************************************************************************
+* Summary:
+* Runs the double precision reference on the latest sample.
+*
+* Parameters:
+*  BENCH_REF_t* p Reference filter
+*
+* Return:
+*  double Duty in ticks, not rounded
+*
+*******************************************************************************/
+static double ref_step(BENCH_REF_t* p)
+{
+    double e = p->m_Ref - (double)*p->m_pFeedBack;
+    double acc;
+    double sat;
+
+    acc = p->m_A[0] * p->m_U[0] + p->m_A[1] * p->m_U[1] + p->m_A[2] * p->m_U[2] +
+          p->m_B[0] * e + p->m_B[1] * p->m_E[0] + p->m_B[2] * p->m_E[1] +
+          p->m_B[3] * p->m_E[2];
+
+    p->m_E[2] = p->m_E[1];
+    p->m_E[1] = p->m_E[0];
+    p->m_E[0] = e;
+    p->m_U[2] = p->m_U[1];
+    p->m_U[1] = p->m_U[0];
+    p->m_U[0] = fmax(fmin(acc, p->m_Max), -p->m_Max);
+
+    sat = fmax(fmin(acc, p->m_Max), p->m_Min);
+    return sat;
+}
+
+/*******************************************************************************
+* Function Name: plant_step
+********************************************************************************
+* Summary:
+* Advances the averaged buck model by one switching period and returns the
+* ADC sample of the output voltage taken at its end.
+*
+* Parameters:
+*  BENCH_PLANT_t* p Plant state
+*  const BENCH_DESIGN_t* d Design
+*  double duty Duty in ticks
+*  int n Sample number, selects the load
+*
+* Return:
+*  uint32_t ADC sample without noise
+*
+*******************************************************************************/
+static uint32_t plant_step(BENCH_PLANT_t* p, const BENCH_DESIGN_t* d, double duty, int n)
+{
+    double dt = 1.0 / (d->m_Fs * SIM_SUBSTEPS);
+    double t = (double)n / d->m_Fs;
+    double rl;
+    double vl;
+    double adc;
+    int k;
+
+    rl = SIM_VOUT / (((t >= 0.01) && (t < 0.02)) ? SIM_ILOAD_HIGH : SIM_ILOAD_LOW);
+    duty /= d->m_Period;
+    for (k = 0; k < SIM_SUBSTEPS; k++)
+    {
+        p->m_VOut = (p->m_VC + SIM_ESR * p->m_IL) / (1.0 + SIM_ESR / rl);
+        vl        = duty * SIM_VIN - p->m_VOut - SIM_DCR * p->m_IL;
+        p->m_IL  += vl / SIM_L * dt;
+        if (p->m_IL < 0.0)
+        {
+            p->m_IL = 0.0;
+        }
+        p->m_VC  += (p->m_IL - p->m_VOut / rl) / SIM_C * dt;
+    }
+
+    adc = p->m_VOut * d->m_AdcGain + 0.5;
+    return (uint32_t)fmin(fmax(adc, 0.0), 4095.0);
+}
+
+/*******************************************************************************
+* Function Name: noise
+********************************************************************************
+* Summary:
+* Deterministic ADC noise, the same sequence for every loop.
+*
+* Parameters:
+*  uint32_t* pSeed Generator state
+*  uint32_t adc ADC sample
+*
+* Return:
+*  uint32_t Noisy ADC sample
+*
+*******************************************************************************/
+static uint32_t noise(uint32_t* pSeed, uint32_t adc)
+{
+    int32_t v;
+
+    *pSeed = *pSeed * 1664525U + 1013904223U;
+    v = (int32_t)adc + (int32_t)((*pSeed >> 16) % (2U * SIM_NOISE + 1U)) - SIM_NOISE;
+    return (uint32_t)((v < 0) ? 0 : ((v > 4095) ? 4095 : v));
+}
+
+/*******************************************************************************
+* Function Name: run_reference
+********************************************************************************
+* Summary:
+* Runs the reference loop and records its samples, duty and output voltage.
+*
+* Parameters:
+*  const BENCH_DESIGN_t* d Design
+*
+* Return:
+*  int Number of samples
+*
+*******************************************************************************/
+static int run_reference(const BENCH_DESIGN_t* d)
+{
+    static volatile uint32_t adc;
+    BENCH_REF_t ref;
+    BENCH_PLANT_t plant;
+    uint32_t seed = 1U;
+    uint32_t clean = 0U;
+    int count = (int)(SIM_TIME * d->m_Fs);
+    int n;
+
+    memset(&plant, 0, sizeof(plant));
+    ref_init(&ref, d, &adc);
+    for (n = 0; n < count; n++)
+    {
+        adc = noise(&seed, clean);
+        traceAdc[n]  = adc;
+        traceDuty[n] = ref_step(&ref);
+        clean        = plant_step(&plant, d, traceDuty[n], n);
+        traceVOut[n] = plant.m_VOut;
+    }
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: bench_backend
+********************************************************************************
+* Summary:
+* Measures one backend on one design and prints a row of the matrix.
+*
+* Parameters:
+*  const BENCH_BACKEND_t* b Backend
+*  const BENCH_DESIGN_t* d Design
+*  int count Number of samples of the reference trace
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_backend(const BENCH_BACKEND_t* b, const BENCH_DESIGN_t* d, int count)
+{
+    static volatile uint32_t adc;
+    static uint64_t state[64];
+    struct timespec t0, t1;
+    BENCH_PLANT_t plant;
+    double best = 1e30;
+    double ns;
+    double err;
+    double dutyMax = 0.0, dutySq = 0.0;
+    double vMax = 0.0, vSq = 0.0;
+    double settled = 0.0;
+    uint32_t seed = 1U;
+    uint32_t clean = 0U;
+    uint32_t duty;
+    int settledFrom = count - (int)(SIM_SETTLED * d->m_Fs);
+    int run;
+    int n;
+
+    /* Duty error on the samples of the reference loop */
+    b->m_Init(state, d, &adc);
+    for (n = 0; n < count; n++)
+    {
+        adc = traceAdc[n];
+        err = (double)b->m_Step(state) - traceDuty[n];
+        dutyMax = fmax(dutyMax, fabs(err));
+        dutySq += err * err;
+    }
+
+    /* Time per sample on the same samples, best of the runs */
+    for (run = 0; run < BENCH_TIMING_RUNS; run++)
+    {
+        b->m_Init(state, d, &adc);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (n = 0; n < count; n++)
+        {
+            adc = traceAdc[n];
+            (void)b->m_Step(state);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / count;
+        best = fmin(best, ns);
+    }
+
+    /* Output voltage error in its own loop with the same stimuli */
+    memset(&plant, 0, sizeof(plant));
+    b->m_Init(state, d, &adc);
+    for (n = 0; n < count; n++)
+    {
+        adc   = noise(&seed, clean);
+        duty  = b->m_Step(state);
+        clean = plant_step(&plant, d, (double)duty, n);
+        err   = (plant.m_VOut - traceVOut[n]) * 1e3;
+        vMax  = fmax(vMax, fabs(err));
+        vSq  += err * err;
+        if (n >= settledFrom)
+        {
+            settled += (double)d->m_Ref - (double)adc;
+        }
+    }
+
+    printf("%-8s %8.1f %7u %7u %9.1f %9.2f %9.2f %9.2f %10.2f\n",
+           b->m_Name, best,
+           (unsigned)(b->m_CodeStop - b->m_CodeStart), (unsigned)b->m_StateSize,
+           dutyMax, sqrt(dutySq / count),
+           vMax, sqrt(vSq / count),
+           settled / (count - settledFrom));
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs every backend on every design.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int 0 on success
+*
+*******************************************************************************/
+int main(void)
+{
+    size_t i;
+    size_t j;
+    int count;
+
+    for (i = 0; i < sizeof(designs) / sizeof(designs[0]); i++)
+    {
+        count = run_reference(&designs[i]);
+        printf("%s: %.0f kHz, duty %u..%u ticks, %d samples\n", designs[i].m_Name,
+               designs[i].m_Fs / 1e3, (unsigned)designs[i].m_DutyMin,
+               (unsigned)designs[i].m_DutyMax, count);
+        printf("%-8s %8s %7s %7s %9s %9s %9s %9s %10s\n", "backend", "ns/smp", "code B",
+               "state B", "duty max", "duty rms", "Vout max", "Vout rms", "mean err");
+        for (j = 0; j < sizeof(backends) / sizeof(backends[0]); j++)
+        {
+            bench_backend(&backends[j], &designs[i], count);
+        }
+        printf("\n");
+    }
+    printf("duty error in ticks against the reference on its samples, Vout error in mV\n"
+           "in the closed loop, mean err in ADC counts over the last %.0f ms\n",
+           SIM_SETTLED * 1e3);
+    return 0;
+}
@@ -0,0 +1,321 @@
+/******************************************************************************
+* File Name:   xmc_current_mode_sim.c
+*
+* Description: Host simulation of the average current mode of the code
+*              examples. The loop of each target runs on the averaged model of
+*              xmc_buck_model.h in voltage mode and in current mode, with the
+*              inner 2p2z loop every cycle and the outer 3p3z loop split over
+*              OUTER_LOOP_DECIMATION cycles, as current_mode_run does. It
+*              reports the inductor current peak at startup and the response
+*              to load steps from 1 A to 8 A and back.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_current_mode_sim xmc_current_mode_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_2p2z_filter_fixed.h"
+#include "xmc_2p2z_filter_float.h"
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_ILOAD_LOW         (1.0)       /* Load current in A */
+#define SIM_ILOAD_HIGH        (8.0)
+#define SIM_STEP_TIME         (0.02)      /* Step up at 20 ms, down at 30 ms */
+#define SIM_STEP_LENGTH       (0.01)
+#define SIM_TIME              (0.04)
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+#define SIM_BAND              (0.01)      /* Settling band, fraction of Vout */
+#define SIM_IL_GAIN           (200.0)     /* Current sense in ADC counts per A */
+
+/* Current mode settings of the code examples */
+#define OUTER_LOOP_DECIMATION (2U)
+#define CURRENT_REF_SHIFT     (2U)
+#define CURRENT_LIMIT         (2000U)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Current mode coefficients of a target */
+typedef struct SIM_CM_DESIGN
+{
+    float               m_IB[3];      /* Inner loop */
+    float               m_IA[2];
+    float               m_VB[3];      /* Outer loop */
+    float               m_VA[2];
+} SIM_CM_DESIGN_t;
+
+/* Response to one load step */
+typedef struct SIM_STEP
+{
+    double              m_Min;        /* Lowest and highest Vout in V */
+    double              m_Max;
+    double              m_Settle;     /* Last time outside the band in s */
+} SIM_STEP_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* ILOOP_xxx and VLOOP_xxx of xmc13_vcm_buck_single.c and xmc42_vcm_buck_single.c */
+static const SIM_CM_DESIGN_t cmDesigns[] =
+{
+    {
+        { 0.04455f, 0.00114048f, -0.04340952f },
+        { 0.88629150390625f, 0.11370849609375f },
+        { 0.451069f, 0.042580914f, -0.408488086f },
+        { 0.1619873046875f, 0.8380126953125f }
+    },
+    {
+        { 12.2756f, 0.061378f, -12.214222f },
+        { 0.88629150390625f, 0.11370849609375f },
+        { 0.9f, 0.05283f, -0.84717f },
+        { 0.32598876953125f, 0.67401123046875f }
+    }
+};
+
+static volatile uint32_t vadc;
+static volatile uint32_t iadc;
+
+/*******************************************************************************
+* Function Name: step_add
+********************************************************************************
+* Summary:
+* Adds a sample to the response of a load step.
+*
+* Parameters:
+*  SIM_STEP_t* s Response
+*  double v Output voltage in V
+*  double t Time since the step in s
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void step_add(SIM_STEP_t* s, double v, double t)
+{
+    s->m_Min = fmin(s->m_Min, v);
+    s->m_Max = fmax(s->m_Max, v);
+    if (fabs(v - XMC_BUCK_VOUT) > SIM_BAND * XMC_BUCK_VOUT)
+    {
+        s->m_Settle = t;
+    }
+}
+
+/*******************************************************************************
+* Function Name: run
+********************************************************************************
+* Summary:
+* Runs the loop of a target from startup through the load steps and prints
+* the responses.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*  bool current Current mode
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run(int kit, bool current)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[kit];
+    const SIM_CM_DESIGN_t* c = &cmDesigns[kit];
+    XMC_3P3Z_DATA_FIXED_t vFixed;
+    XMC_3P3Z_DATA_FLOAT_t vFloat;
+    XMC_2P2Z_DATA_FIXED_t iFixed;
+    XMC_2P2Z_DATA_FLOAT_t iFloat;
+    XMC_BUCK_t buck;
+    SIM_STEP_t up = { 10.0, 0.0, 0.0 };
+    SIM_STEP_t down = { 10.0, 0.0, 0.0 };
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t stepUp = (uint32_t)(SIM_STEP_TIME * d->m_Fs);
+    uint32_t stepDown = stepUp + (uint32_t)(SIM_STEP_LENGTH * d->m_Fs);
+    uint32_t outerPhase = 0U;
+    uint32_t seed = 1U;
+    uint32_t n;
+    double peak = 0.0;
+    double duty;
+    double v;
+
+    XMC_BUCK_Init(&buck, d, XMC_BUCK_VIN, SIM_ILOAD_LOW);
+    buck.m_Delay = true;
+    vadc = 0U;
+    iadc = 0U;
+    if (kit == XMC_BUCK_XMC1)
+    {
+        if (current)
+        {
+            XMC_3P3Z_InitFixed(&vFixed, c->m_VB[0], c->m_VB[1], c->m_VB[2], 0.0f, c->m_VA[0],
+                               c->m_VA[1], 0.0f, 1.0f, d->m_Ref, 0,
+                               CURRENT_LIMIT >> CURRENT_REF_SHIFT, &vadc);
+            XMC_2P2Z_InitFixed(&iFixed, c->m_IB[0], c->m_IB[1], c->m_IB[2], c->m_IA[0],
+                               c->m_IA[1], 1.0f, 0, d->m_DutyMin, d->m_DutyMax, &iadc);
+        }
+        else
+        {
+            XMC_3P3Z_InitFixed(&vFixed, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                               d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                               d->m_DutyMax, &vadc);
+        }
+    }
+    else
+    {
+        if (current)
+        {
+            XMC_3P3Z_InitFloat(&vFloat, c->m_VB[0], c->m_VB[1], c->m_VB[2], 0.0f, c->m_VA[0],
+                               c->m_VA[1], 0.0f, 1.0f, d->m_Ref, 0,
+                               CURRENT_LIMIT >> CURRENT_REF_SHIFT, &vadc);
+            XMC_2P2Z_InitFloat(&iFloat, c->m_IB[0], c->m_IB[1], c->m_IB[2], c->m_IA[0],
+                               c->m_IA[1], 1.0f, 0, (float)d->m_DutyMin, (float)d->m_DutyMax,
+                               &iadc);
+        }
+        else
+        {
+            XMC_3P3Z_InitFloat(&vFloat, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                               d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                               d->m_DutyMax, &vadc);
+        }
+    }
+
+    for (n = 0; n < samples; n++)
+    {
+        if (!current)
+        {
+            if (kit == XMC_BUCK_XMC1)
+            {
+                XMC_3P3Z_FilterFixed(&vFixed);
+                duty = (double)vFixed.m_pOut;
+            }
+            else
+            {
+                XMC_3P3Z_FilterFloat(&vFloat);
+                duty = (double)vFloat.m_Out;
+            }
+        }
+        else if (kit == XMC_BUCK_XMC1)
+        {
+            /* As current_mode_run of the code examples */
+            XMC_2P2Z_FilterFixed(&iFixed);
+            if (outerPhase == 0U)
+            {
+                XMC_3P3Z_FilterFixedPrepare(&vFixed);
+            }
+            else if (outerPhase == (OUTER_LOOP_DECIMATION - 1U))
+            {
+                XMC_3P3Z_FilterFixedComplete(&vFixed);
+                iFixed.m_Ref = (int32_t)(vFixed.m_pOut << CURRENT_REF_SHIFT);
+            }
+            duty = (double)iFixed.m_pOut;
+        }
+        else
+        {
+            XMC_2P2Z_FilterFloat(&iFloat);
+            if (outerPhase == 0U)
+            {
+                XMC_3P3Z_FilterFloatPrepare(&vFloat);
+            }
+            else if (outerPhase == (OUTER_LOOP_DECIMATION - 1U))
+            {
+                XMC_3P3Z_FilterFloatComplete(&vFloat);
+                iFloat.m_Ref = (float)(vFloat.m_Out << CURRENT_REF_SHIFT);
+            }
+            duty = (double)iFloat.m_Out;
+        }
+        if (++outerPhase == OUTER_LOOP_DECIMATION)
+        {
+            outerPhase = 0U;
+        }
+
+        buck.m_Load = ((n >= stepUp) && (n < stepDown)) ? SIM_ILOAD_HIGH : SIM_ILOAD_LOW;
+        v = XMC_BUCK_Run(&buck, duty);
+        vadc = XMC_BUCK_Noise(&seed, XMC_BUCK_Adc(d, v), SIM_NOISE);
+        iadc = (uint32_t)fmin(fmax(buck.m_IL * SIM_IL_GAIN + 0.5, 0.0), 4095.0);
+
+        if (n < stepUp)
+        {
+            peak = fmax(peak, buck.m_IL);
+        }
+        else if (n < stepDown)
+        {
+            step_add(&up, v, (double)(n - stepUp) / d->m_Fs);
+        }
+        else
+        {
+            step_add(&down, v, (double)(n - stepDown) / d->m_Fs);
+        }
+    }
+
+    printf("%-8s %-8s %13.1f %14.0f %10.0f %13.0f %10.0f\n", d->m_Name,
+           current ? "current" : "voltage", peak, (XMC_BUCK_VOUT - up.m_Min) * 1e3,
+           up.m_Settle * 1e6, (down.m_Max - XMC_BUCK_VOUT) * 1e3, down.m_Settle * 1e6);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs both targets in voltage mode and in current mode.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    printf("startup, then load step %.0f A -> %.0f A -> %.0f A, settling into +/-%.0f%% of %.1f V\n",
+           SIM_ILOAD_LOW, SIM_ILOAD_HIGH, SIM_ILOAD_LOW, SIM_BAND * 100.0, XMC_BUCK_VOUT);
+    printf("%-8s %-8s %13s %14s %10s %13s %10s\n", "target", "mode", "start peak A",
+           "undershoot mV", "settle us", "overshoot mV", "settle us");
+    run(XMC_BUCK_XMC1, false);
+    run(XMC_BUCK_XMC1, true);
+    run(XMC_BUCK_XMC4, false);
+    run(XMC_BUCK_XMC4, true);
+    return 0;
+}
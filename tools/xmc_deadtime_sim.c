@@ -0,0 +1,611 @@
+/******************************************************************************
+* File Name:   xmc_deadtime_sim.c
+*
+* Description: Host validation of the adaptive dead time of xmc_deadtime.h.
+*              The loop of the XMC1302 or XMC4200 target runs on an averaged
+*              buck model whose switch node voltage follows the dead times:
+*              the switch node transitions during each dead time, with the
+*              partial soft switching of the output capacitance, the body
+*              diode conduction and the conduction losses of the switches
+*              and the inductor. The model also accounts for the losses that
+*              the duty does not see: hard switching, reverse recovery and
+*              cross conduction below the guard band.
+*
+*              For each load, the tool sweeps the falling edge dead time to
+*              find the efficiency optimum and the duty minimum, then runs the
+*              optimizer with ADC noise and reports where it settles. It also
+*              runs a load step during the search.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_deadtime_sim xmc_deadtime_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define __STATIC_INLINE static inline
+/* The ISR and the background task of the simulation share one thread */
+#define __DMB()         __asm__ volatile ("" ::: "memory")
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_deadtime.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_VIN               (12.0)      /* Input voltage in V */
+#define SIM_L                 (10e-6)     /* Inductance in H */
+#define SIM_C                 (470e-6)    /* Output capacitance in F */
+#define SIM_ESR               (0.01)      /* Capacitor ESR in Ohm */
+#define SIM_DCR               (0.02)      /* Inductor DCR in Ohm */
+#define SIM_VOUT              (3.3)       /* Nominal output voltage in V */
+#define SIM_RDS               (0.008)     /* On resistance of each switch in Ohm */
+#define SIM_VF                (0.8)       /* Body diode forward voltage in V */
+#define SIM_QRR               (20e-9)     /* Body diode recovered charge in C */
+#define SIM_CSW               (3e-9)      /* Switch node capacitance in F */
+#define SIM_IST               (30.0)      /* Cross conduction current in A */
+#define SIM_SUBSTEPS          (20)        /* Integration steps per sample */
+#define SIM_NOISE             (2)         /* ADC noise, uniform in +/- counts */
+#define SIM_SETTLE_TIME       (0.1)       /* Sweep: settling time in s */
+#define SIM_MEASURE_TIME      (0.1)       /* Sweep: measurement time in s */
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Target, compensator design and optimizer settings */
+typedef struct SIM_KIT
+{
+    const char*         m_Name;
+    bool                m_Fixed;      /* Fixed-point or float compensator */
+    double              m_Fs;         /* Control loop frequency in Hz */
+    double              m_Period;     /* Switching period in duty ticks */
+    double              m_AdcGain;    /* ADC counts per V */
+    float               m_B[4];
+    float               m_A[3];
+    float               m_K;
+    uint16_t            m_Ref;
+    uint32_t            m_DutyMax;
+    double              m_DtTick;     /* Dead time register tick in s */
+    double              m_Delay;      /* Turn-off minus turn-on delay in s */
+    uint32_t            m_DtDesign;   /* Dead time of design.modus */
+    uint32_t            m_DtMin;      /* Guard band */
+    uint32_t            m_DtMax;
+    uint32_t            m_Log2Window;
+    uint32_t            m_Hold;       /* Windows between two rounds */
+    uint32_t            m_MaxSpread;
+    float               m_MaxDrift;
+    float               m_MinGain;
+} SIM_KIT_t;
+
+/* Buck converter with the dead times in register ticks */
+typedef struct SIM_PLANT
+{
+    double              m_IL;
+    double              m_VC;
+    double              m_VOut;
+    uint32_t            m_Dt[2];      /* Rising, falling edge */
+    double              m_EOut;       /* Energy delivered in J */
+    double              m_ELoss;      /* Energy lost in J */
+    double              m_DutySum;
+    uint32_t            m_Samples;
+} SIM_PLANT_t;
+
+/* Closed loop with the compensator of the kit */
+typedef struct SIM_LOOP
+{
+    const SIM_KIT_t*        m_Kit;
+    SIM_PLANT_t             m_Plant;
+    XMC_3P3Z_DATA_FIXED_t   m_Fixed;
+    XMC_3P3Z_DATA_FLOAT_t   m_Float;
+    volatile uint32_t       m_Adc;
+    uint32_t                m_Seed;
+} SIM_LOOP_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* The XMC1302 dead time clock is the 64 MHz CCU8 clock, the XMC4200 HRPWM
+ * dead time counts 80 MHz clocks. The guard bands keep 15 ns between the
+ * turn-off of one switch and the turn-on of the other. */
+static const SIM_KIT_t kits[] =
+{
+    {
+        "XMC1302", true, 100e3, 640.0, 1000.0,
+        { +0.649757898241f, -0.582384858571f, -0.649256971688f, +0.582885785125f },
+        { +1.335491183190f, -0.211704021559f, -0.123787161631f },
+        +0.657007535988f, 3300U, 576U,
+        1.0 / 64e6, 30e-9, 7U, 3U, 15U, 14U, 16U, 32U, 1.0f, 0.02f
+    },
+    {
+        "XMC4200", false, 200e3, 102400.0, 3215.0 / 3.3,
+        { +1.072329384164f, -1.009391619615f, -1.071806296352f, +1.009914707427f },
+        { +1.611302392630f, -0.426276608711f, -0.185025783919f },
+        +105.121205758148f, 3215U, 92160U,
+        1.0 / 80e6, 22e-9, 4U, 3U, 12U, 13U, 64U, 4096U, 64.0f, 2.0f
+    }
+};
+
+static const double loads[] = { 0.5, 1.0, 2.0, 4.0, 8.0 };
+
+/*******************************************************************************
+* Function Name: switch_node
+********************************************************************************
+* Summary:
+* Computes the mean switch node voltage over one period and the energy lost in
+* the switches. The current is taken constant during each dead time, at the
+* peak for the falling edge and at the valley for the rising edge. A dead time
+* shorter than the commutation of the switch node capacitance turns the next
+* switch on at a partial voltage, a longer one conducts the body diode.
+*
+* Parameters:
+*  const SIM_KIT_t* k Kit
+*  const SIM_PLANT_t* p Plant state and dead times
+*  double duty Duty as a fraction of the period
+*  double* pLoss Energy lost in the period, in J
+*
+* Return:
+*  double Mean switch node voltage in V
+*
+*******************************************************************************/
+static double switch_node(const SIM_KIT_t* k, const SIM_PLANT_t* p, double duty, double* pLoss)
+{
+    double t = 1.0 / k->m_Fs;
+    double ripple = (SIM_VIN - p->m_VOut) * duty * t / SIM_L;
+    double iPeak = p->m_IL + ripple / 2.0;
+    double iValley = p->m_IL - ripple / 2.0;
+    double irms2 = p->m_IL * p->m_IL + ripple * ripple / 12.0;
+    double gapRise = p->m_Dt[0] * k->m_DtTick - k->m_Delay;
+    double gapFall = p->m_Dt[1] * k->m_DtTick - k->m_Delay;
+    double tHigh = duty * t - fmax(gapRise, 0.0);
+    double tLow = (1.0 - duty) * t - fmax(gapFall, 0.0);
+    double area;
+    double loss;
+    double tc;
+    double v;
+
+    area = (SIM_VIN - p->m_IL * SIM_RDS) * tHigh - p->m_IL * SIM_RDS * tLow;
+    loss = irms2 * SIM_RDS * (tHigh + tLow);
+
+    /* Rising edge: the low side turns off, the high side turns on */
+    if (gapRise <= 0.0)
+    {
+        loss += SIM_VIN * SIM_IST * -gapRise + 0.5 * SIM_CSW * SIM_VIN * SIM_VIN;
+    }
+    else if (iValley >= 0.0)
+    {
+        /* Low side diode, then hard turn-on with its recovery */
+        area -= SIM_VF * gapRise;
+        loss += SIM_VF * iValley * gapRise + 0.5 * SIM_CSW * SIM_VIN * SIM_VIN + SIM_QRR * SIM_VIN;
+    }
+    else
+    {
+        /* Negative current charges the switch node towards the input */
+        tc = SIM_CSW * SIM_VIN / -iValley;
+        if (gapRise >= tc)
+        {
+            area += SIM_VIN * tc / 2.0 + (SIM_VIN + SIM_VF) * (gapRise - tc);
+            loss += SIM_VF * -iValley * (gapRise - tc);
+        }
+        else
+        {
+            v = SIM_VIN * gapRise / tc;
+            area += v * gapRise / 2.0;
+            loss += 0.5 * SIM_CSW * (SIM_VIN - v) * (SIM_VIN - v);
+        }
+    }
+
+    /* Falling edge: the high side turns off, the low side turns on */
+    if (gapFall <= 0.0)
+    {
+        loss += SIM_VIN * SIM_IST * -gapFall + 0.5 * SIM_CSW * SIM_VIN * SIM_VIN;
+    }
+    else
+    {
+        tc = SIM_CSW * SIM_VIN / fmax(iPeak, 1e-3);
+        if (gapFall >= tc)
+        {
+            area += SIM_VIN * tc / 2.0 - SIM_VF * (gapFall - tc);
+            loss += SIM_VF * iPeak * (gapFall - tc);
+        }
+        else
+        {
+            v = SIM_VIN * (1.0 - gapFall / tc);
+            area += (SIM_VIN + v) * gapFall / 2.0;
+            loss += 0.5 * SIM_CSW * v * v;
+        }
+    }
+
+    *pLoss = loss + irms2 * SIM_DCR * t;
+    return area / t;
+}
+
+/*******************************************************************************
+* Function Name: plant_step
+********************************************************************************
+* Summary:
+* Advances the buck model by one switching period and returns the ADC sample
+* of the output voltage taken at its end. The synchronous converter stays in
+* continuous conduction, the inductor current can be negative.
+*
+* Parameters:
+*  const SIM_KIT_t* k Kit
+*  SIM_PLANT_t* p Plant state
+*  double duty Duty in ticks
+*  double load Load current at the nominal voltage in A
+*
+* Return:
+*  uint32_t ADC sample without noise
+*
+*******************************************************************************/
+static uint32_t plant_step(const SIM_KIT_t* k, SIM_PLANT_t* p, double duty, double load)
+{
+    double dt = 1.0 / (k->m_Fs * SIM_SUBSTEPS);
+    double rl = SIM_VOUT / load;
+    double loss;
+    double vsw;
+    double adc;
+    int i;
+
+    vsw = switch_node(k, p, duty / k->m_Period, &loss);
+    p->m_ELoss   += loss;
+    p->m_DutySum += duty;
+    p->m_Samples++;
+    for (i = 0; i < SIM_SUBSTEPS; i++)
+    {
+        p->m_VOut  = (p->m_VC + SIM_ESR * p->m_IL) / (1.0 + SIM_ESR / rl);
+        p->m_IL   += (vsw - p->m_VOut - SIM_DCR * p->m_IL) / SIM_L * dt;
+        p->m_VC   += (p->m_IL - p->m_VOut / rl) / SIM_C * dt;
+        p->m_EOut += p->m_VOut * p->m_VOut / rl * dt;
+    }
+
+    adc = p->m_VOut * k->m_AdcGain + 0.5;
+    return (uint32_t)fmin(fmax(adc, 0.0), 4095.0);
+}
+
+/*******************************************************************************
+* Function Name: noise
+********************************************************************************
+* Summary:
+* Deterministic ADC noise, as in xmc_comp_bench.c.
+*
+* Parameters:
+*  uint32_t* pSeed Generator state
+*  uint32_t adc ADC sample
+*
+* Return:
+*  uint32_t Noisy ADC sample
+*
+*******************************************************************************/
+static uint32_t noise(uint32_t* pSeed, uint32_t adc)
+{
+    int32_t v;
+
+    *pSeed = *pSeed * 1664525U + 1013904223U;
+    v = (int32_t)adc + (int32_t)((*pSeed >> 16) % (2U * SIM_NOISE + 1U)) - SIM_NOISE;
+    return (uint32_t)((v < 0) ? 0 : ((v > 4095) ? 4095 : v));
+}
+
+/*******************************************************************************
+* Function Name: loop_init
+********************************************************************************
+* Summary:
+* Starts the loop from a discharged output with the given dead times.
+*
+* Parameters:
+*  SIM_LOOP_t* l Loop
+*  const SIM_KIT_t* k Kit
+*  uint32_t rise Rising edge dead time
+*  uint32_t fall Falling edge dead time
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void loop_init(SIM_LOOP_t* l, const SIM_KIT_t* k, uint32_t rise, uint32_t fall)
+{
+    memset(l, 0, sizeof(*l));
+    l->m_Kit           = k;
+    l->m_Seed          = 1U;
+    l->m_Plant.m_Dt[0] = rise;
+    l->m_Plant.m_Dt[1] = fall;
+    if (k->m_Fixed)
+    {
+        XMC_3P3Z_InitFixed(&l->m_Fixed, k->m_B[0], k->m_B[1], k->m_B[2], k->m_B[3],
+                           k->m_A[0], k->m_A[1], k->m_A[2], k->m_K, k->m_Ref,
+                           0U, k->m_DutyMax, &l->m_Adc);
+    }
+    else
+    {
+        XMC_3P3Z_InitFloat(&l->m_Float, k->m_B[0], k->m_B[1], k->m_B[2], k->m_B[3],
+                           k->m_A[0], k->m_A[1], k->m_A[2], k->m_K, k->m_Ref,
+                           0U, k->m_DutyMax, &l->m_Adc);
+    }
+}
+
+/*******************************************************************************
+* Function Name: loop_step
+********************************************************************************
+* Summary:
+* Runs one control sample: compensator, PWM and plant.
+*
+* Parameters:
+*  SIM_LOOP_t* l Loop
+*  double load Load current in A
+*  bool noisy ADC noise on
+*
+* Return:
+*  uint32_t Duty written to the PWM
+*
+*******************************************************************************/
+static uint32_t loop_step(SIM_LOOP_t* l, double load, bool noisy)
+{
+    uint32_t duty;
+    uint32_t adc;
+
+    if (l->m_Kit->m_Fixed)
+    {
+        XMC_3P3Z_FilterFixed(&l->m_Fixed);
+        duty = l->m_Fixed.m_pOut;
+    }
+    else
+    {
+        XMC_3P3Z_FilterFloat(&l->m_Float);
+        duty = l->m_Float.m_Out;
+    }
+
+    adc = plant_step(l->m_Kit, &l->m_Plant, (double)duty, load);
+    l->m_Adc = noisy ? noise(&l->m_Seed, adc) : adc;
+    return duty;
+}
+
+/*******************************************************************************
+* Function Name: loop_measure
+********************************************************************************
+* Summary:
+* Clears the energy and duty accumulators of the plant.
+*
+* Parameters:
+*  SIM_LOOP_t* l Loop
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void loop_measure(SIM_LOOP_t* l)
+{
+    l->m_Plant.m_EOut    = 0.0;
+    l->m_Plant.m_ELoss   = 0.0;
+    l->m_Plant.m_DutySum = 0.0;
+    l->m_Plant.m_Samples = 0U;
+}
+
+/*******************************************************************************
+* Function Name: efficiency
+********************************************************************************
+* Summary:
+* Efficiency in percent since the last loop_measure.
+*
+* Parameters:
+*  const SIM_LOOP_t* l Loop
+*
+* Return:
+*  double Efficiency
+*
+*******************************************************************************/
+static double efficiency(const SIM_LOOP_t* l)
+{
+    return 100.0 * l->m_Plant.m_EOut / (l->m_Plant.m_EOut + l->m_Plant.m_ELoss);
+}
+
+/*******************************************************************************
+* Function Name: sweep
+********************************************************************************
+* Summary:
+* Runs the loop without noise at each falling edge dead time of the guard
+* band, and returns the dead times of the best efficiency and of the lowest
+* mean duty.
+*
+* Parameters:
+*  const SIM_KIT_t* k Kit
+*  double load Load current in A
+*  uint32_t* pBest Dead time of the best efficiency
+*  uint32_t* pMinDuty Dead time of the lowest duty
+*  double* pBestEff Best efficiency in percent
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sweep(const SIM_KIT_t* k, double load, uint32_t* pBest, uint32_t* pMinDuty,
+                  double* pBestEff)
+{
+    SIM_LOOP_t l;
+    uint32_t dt;
+    uint32_t n;
+    double eff;
+    double duty;
+    double minDuty = 1e30;
+
+    *pBestEff = 0.0;
+    for (dt = k->m_DtMin; dt <= k->m_DtMax; dt++)
+    {
+        loop_init(&l, k, k->m_DtDesign, dt);
+        for (n = 0; n < (uint32_t)(SIM_SETTLE_TIME * k->m_Fs); n++)
+        {
+            loop_step(&l, load, false);
+        }
+        loop_measure(&l);
+        for (n = 0; n < (uint32_t)(SIM_MEASURE_TIME * k->m_Fs); n++)
+        {
+            loop_step(&l, load, false);
+        }
+
+        eff  = efficiency(&l);
+        duty = l.m_Plant.m_DutySum / l.m_Plant.m_Samples;
+        if (eff > *pBestEff)
+        {
+            *pBestEff = eff;
+            *pBest    = dt;
+        }
+        if (duty < minDuty)
+        {
+            minDuty   = duty;
+            *pMinDuty = dt;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: optimize
+********************************************************************************
+* Summary:
+* Runs the loop with ADC noise and the optimizer, as the target does: the ISR
+* takes pending dead times, writes the duty and feeds the windows, and the
+* background task steps the optimizer after each window. The load changes
+* from load0 to load1 at stepTime. The efficiency is measured over the last
+* second. Without search, the dead times stay at the design value.
+*
+* Parameters:
+*  const SIM_KIT_t* k Kit
+*  bool search Run the optimizer on the falling edge
+*  double load0 Load current before the step in A
+*  double load1 Load current after the step in A
+*  double stepTime Time of the load step in s
+*  double time Run time in s
+*  XMC_DT_t* dt Optimizer, returned for its counters
+*  double* pEff Efficiency over the last second
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void optimize(const SIM_KIT_t* k, bool search, double load0, double load1,
+                     double stepTime, double time, XMC_DT_t* dt, double* pEff)
+{
+    SIM_LOOP_t l;
+    uint32_t samples = (uint32_t)(time * k->m_Fs);
+    uint32_t n;
+    uint32_t duty;
+
+    loop_init(&l, k, k->m_DtDesign, k->m_DtDesign);
+    XMC_DT_Init(dt, k->m_Log2Window, k->m_DtDesign, k->m_DtDesign,
+                k->m_DtMin, k->m_DtMax, 1U, 1U, k->m_Hold, k->m_MaxSpread,
+                k->m_MaxDrift, k->m_MinGain);
+
+    for (n = 0; n < samples; n++)
+    {
+        if (dt->m_Pending != 0U)
+        {
+            l.m_Plant.m_Dt[0] = dt->m_Out[0];
+            l.m_Plant.m_Dt[1] = dt->m_Out[1];
+            dt->m_Pending     = 0U;
+        }
+        if (n == samples - (uint32_t)k->m_Fs)
+        {
+            loop_measure(&l);
+        }
+
+        duty = loop_step(&l, ((double)n / k->m_Fs < stepTime) ? load0 : load1, true);
+        if (XMC_DT_Update(dt, duty) && search)
+        {
+            XMC_DT_Step(dt, true);
+        }
+    }
+
+    *pEff = efficiency(&l);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the sweeps and the optimizer for both kits.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    XMC_DT_t dt;
+    size_t i;
+    size_t j;
+    uint32_t best = 0U;
+    uint32_t minDuty = 0U;
+    double bestEff;
+    double designEff;
+    double eff;
+
+    for (i = 0; i < sizeof(kits) / sizeof(kits[0]); i++)
+    {
+        const SIM_KIT_t* k = &kits[i];
+
+        printf("%s: dead time tick %.1f ns, design %u, guard band %u..%u, window 2^%u\n",
+               k->m_Name, k->m_DtTick * 1e9, (unsigned)k->m_DtDesign, (unsigned)k->m_DtMin,
+               (unsigned)k->m_DtMax, (unsigned)k->m_Log2Window);
+        printf("%6s %8s %8s %8s | %8s %8s %8s %7s %7s %7s %7s\n", "load A", "best dt",
+               "min duty", "best %", "design %", "found dt", "found %", "trials", "kept",
+               "lost", "rounds");
+        for (j = 0; j < sizeof(loads) / sizeof(loads[0]); j++)
+        {
+            sweep(k, loads[j], &best, &minDuty, &bestEff);
+            optimize(k, false, loads[j], loads[j], 1e9, 8.0, &dt, &designEff);
+            optimize(k, true, loads[j], loads[j], 1e9, 8.0, &dt, &eff);
+            printf("%6.1f %8u %8u %8.3f | %8.3f %8u %8.3f %7u %7u %7u %7u\n", loads[j],
+                   (unsigned)best, (unsigned)minDuty, bestEff, designEff,
+                   (unsigned)dt.m_Value, eff, (unsigned)dt.m_Trials,
+                   (unsigned)dt.m_Accepted, (unsigned)dt.m_Discarded,
+                   (unsigned)dt.m_Converged);
+        }
+
+        /* Load step in the search */
+        optimize(k, true, 1.0, 6.0, 2.0, 8.0, &dt, &eff);
+        printf("load step 1 A -> 6 A at 2 s: falling edge %u, %.3f %%, %u trials, "
+               "%u kept, %u lost\n\n", (unsigned)dt.m_Value, eff, (unsigned)dt.m_Trials,
+               (unsigned)dt.m_Accepted, (unsigned)dt.m_Discarded);
+    }
+    printf("best and min duty from a sweep of the falling edge without noise, design, found\n"
+           "and efficiencies with ADC noise over the last second of an 8 s run\n");
+    return 0;
+}
@@ -0,0 +1,257 @@
+/******************************************************************************
+* File Name:   xmc_feedforward_sim.c
+*
+* Description: Host simulation of the input voltage feedforward of
+*              xmc_feedforward.h. The loop of each target runs on the averaged
+*              model of xmc_buck_model.h, with the duty applied one period
+*              late and with ADC noise. It applies input voltage steps from
+*              12 V to 9 V and to 15 V at a 4 A load, with and without the
+*              feedforward, and load steps from 1 A to 8 A and back at 8 V,
+*              12 V and 16 V with the feedforward.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_feedforward_sim xmc_feedforward_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_feedforward.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_STEP_TIME         (0.02)      /* First step at 20 ms, second at 30 ms */
+#define SIM_STEP_LENGTH       (0.01)
+#define SIM_TIME              (0.04)
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+#define SIM_BAND              (0.033)     /* Settling band in V, 1% of Vout */
+
+/* Line steps at SIM_LINE_LOAD, load steps between SIM_ILOAD_LOW and SIM_ILOAD_HIGH */
+#define SIM_LINE_LOAD         (4.0)
+#define SIM_VIN_LOW           (9.0)
+#define SIM_VIN_HIGH          (15.0)
+#define SIM_ILOAD_LOW         (1.0)
+#define SIM_ILOAD_HIGH        (8.0)
+
+/* VIN_xxx of the code examples */
+#define VIN_NOMINAL           (2000U)     /* Vin sample at 12 V */
+#define VIN_FF_MAX_GAIN       (2.0f)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Response to one step */
+typedef struct SIM_STEP
+{
+    double              m_Dev;        /* Largest deviation from Vout in V */
+    double              m_Settle;     /* Last time outside the band in s */
+} SIM_STEP_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile uint32_t adc;
+
+/*******************************************************************************
+* Function Name: step_add
+********************************************************************************
+* Summary:
+* Adds a sample to the response of a step.
+*
+* Parameters:
+*  SIM_STEP_t* s Response
+*  double v Output voltage in V
+*  double t Time since the step in s
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void step_add(SIM_STEP_t* s, double v, double t)
+{
+    double e = v - XMC_BUCK_VOUT;
+
+    if (fabs(e) > fabs(s->m_Dev))
+    {
+        s->m_Dev = e;
+    }
+    if (fabs(e) > SIM_BAND)
+    {
+        s->m_Settle = t;
+    }
+}
+
+/*******************************************************************************
+* Function Name: run
+********************************************************************************
+* Summary:
+* Runs the loop of a target through two steps and prints the responses. For
+* line steps, the input goes from 12 V to SIM_VIN_LOW and then to SIM_VIN_HIGH.
+* For load steps, the load goes from SIM_ILOAD_LOW to SIM_ILOAD_HIGH and back
+* at the input voltage vin.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*  bool ff Feedforward on
+*  bool line Line steps instead of load steps
+*  double vin Input voltage of the load steps in V
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run(int kit, bool ff, bool line, double vin)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[kit];
+    XMC_3P3Z_DATA_FIXED_t fixed;
+    XMC_3P3Z_DATA_FLOAT_t flt;
+    XMC_FF_t feedForward;
+    XMC_BUCK_t buck;
+    SIM_STEP_t first = { 0.0, 0.0 };
+    SIM_STEP_t second = { 0.0, 0.0 };
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t step1 = (uint32_t)(SIM_STEP_TIME * d->m_Fs);
+    uint32_t step2 = step1 + (uint32_t)(SIM_STEP_LENGTH * d->m_Fs);
+    uint32_t seed = 1U;
+    uint32_t vinAdc;
+    uint32_t duty;
+    uint32_t n;
+    double v;
+
+    XMC_BUCK_Init(&buck, d, line ? XMC_BUCK_VIN : vin, line ? SIM_LINE_LOAD : SIM_ILOAD_LOW);
+    buck.m_Delay = true;
+    adc = 0U;
+    XMC_FF_Init(&feedForward, VIN_NOMINAL, VIN_FF_MAX_GAIN, d->m_DutyMax);
+    if (kit == XMC_BUCK_XMC1)
+    {
+        XMC_3P3Z_InitFixed(&fixed, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+    }
+    else
+    {
+        XMC_3P3Z_InitFloat(&flt, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+    }
+
+    for (n = 0; n < samples; n++)
+    {
+        if (line)
+        {
+            buck.m_Vin = (n < step1) ? XMC_BUCK_VIN : ((n < step2) ? SIM_VIN_LOW : SIM_VIN_HIGH);
+        }
+        else
+        {
+            buck.m_Load = ((n >= step1) && (n < step2)) ? SIM_ILOAD_HIGH : SIM_ILOAD_LOW;
+        }
+
+        /* As the control ISR of the code examples, Vin sampled with Vout */
+        vinAdc = (uint32_t)fmin(buck.m_Vin * VIN_NOMINAL / XMC_BUCK_VIN + 0.5, 4095.0);
+        if (kit == XMC_BUCK_XMC1)
+        {
+            XMC_3P3Z_FilterFixed(&fixed);
+            duty = fixed.m_pOut;
+        }
+        else
+        {
+            XMC_3P3Z_FilterFloat(&flt);
+            duty = flt.m_Out;
+        }
+        if (ff)
+        {
+            duty = XMC_FF_Scale(&feedForward, duty, vinAdc);
+        }
+
+        v = XMC_BUCK_Run(&buck, (double)duty);
+        adc = XMC_BUCK_Noise(&seed, XMC_BUCK_Adc(d, v), SIM_NOISE);
+
+        if ((n >= step1) && (n < step2))
+        {
+            step_add(&first, v, (double)(n - step1) / d->m_Fs);
+        }
+        else if (n >= step2)
+        {
+            step_add(&second, v, (double)(n - step2) / d->m_Fs);
+        }
+    }
+
+    printf("%-8s %-5s %-4s %5.0f %10.0f %10.0f %10.0f %10.0f\n", d->m_Name, line ? "line" : "load",
+           ff ? "on" : "off", line ? XMC_BUCK_VIN : vin, first.m_Dev * 1e3,
+           first.m_Settle * 1e6, second.m_Dev * 1e3, second.m_Settle * 1e6);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs both targets with the line steps and the load steps.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    int kit;
+
+    printf("line: %.0f V -> %.0f V -> %.0f V at %.0f A, load: %.0f A -> %.0f A -> %.0f A, "
+           "settling into +/-%.0f mV\n", XMC_BUCK_VIN, SIM_VIN_LOW, SIM_VIN_HIGH, SIM_LINE_LOAD,
+           SIM_ILOAD_LOW, SIM_ILOAD_HIGH, SIM_ILOAD_LOW, SIM_BAND * 1e3);
+    printf("%-8s %-5s %-4s %5s %10s %10s %10s %10s\n", "target", "step", "ff", "vin",
+           "dev 1 mV", "settle us", "dev 2 mV", "settle us");
+    for (kit = XMC_BUCK_XMC1; kit <= XMC_BUCK_XMC4; kit++)
+    {
+        run(kit, false, true, XMC_BUCK_VIN);
+        run(kit, true, true, XMC_BUCK_VIN);
+        run(kit, true, false, 8.0);
+        run(kit, true, false, 12.0);
+        run(kit, true, false, 16.0);
+    }
+    return 0;
+}
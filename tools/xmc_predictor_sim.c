@@ -0,0 +1,273 @@
+/******************************************************************************
+* File Name:   xmc_predictor_sim.c
+*
+* Description: Host simulation of the one-step-ahead output voltage predictor
+*              of xmc_predictor_fixed.h (XMC1302) and xmc_predictor_float.h
+*              (XMC4200). The loop of each target runs on the averaged model
+*              of xmc_buck_model.h, with the duty applied one period late and
+*              with ADC noise, with and without the predictor, at the design
+*              loop gain and at 1.25 times the gain. It reports the Vout noise
+*              before the load step, and the response to load steps from 1 A
+*              to 8 A and back.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_predictor_sim xmc_predictor_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_predictor_fixed.h"
+#include "xmc_predictor_float.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_ILOAD_LOW         (1.0)       /* Load current in A */
+#define SIM_ILOAD_HIGH        (8.0)
+#define SIM_STEP_TIME         (0.02)      /* Step up at 20 ms, down at 30 ms */
+#define SIM_STEP_LENGTH       (0.01)
+#define SIM_TIME              (0.04)
+#define SIM_NOISE_TIME        (0.005)     /* Vout noise over the 5 ms before the step */
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+#define SIM_BAND              (0.01)      /* Settling band, fraction of Vout */
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Predictor coefficients of a target */
+typedef struct SIM_PRED_DESIGN
+{
+    float               m_A1;
+    float               m_A2;
+    float               m_B1;
+    float               m_B2;
+} SIM_PRED_DESIGN_t;
+
+/* Response to one load step */
+typedef struct SIM_STEP
+{
+    double              m_Min;        /* Lowest and highest Vout in V */
+    double              m_Max;
+    double              m_Settle;     /* Last time outside the band in s */
+} SIM_STEP_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* PRED_xxx of xmc13_vcm_buck_single.c and xmc42_vcm_buck_single.c */
+static const SIM_PRED_DESIGN_t predDesigns[] =
+{
+    { 1.949522056350f, -0.970445533549f, 0.381200170521f, 0.011115026960f },
+    { 1.979834825321f, -0.985111939603f, 0.000868077757f, -0.000265594716f }
+};
+
+static volatile uint32_t adc;
+
+/*******************************************************************************
+* Function Name: step_add
+********************************************************************************
+* Summary:
+* Adds a sample to the response of a load step.
+*
+* Parameters:
+*  SIM_STEP_t* s Response
+*  double v Output voltage in V
+*  double t Time since the step in s
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void step_add(SIM_STEP_t* s, double v, double t)
+{
+    s->m_Min = fmin(s->m_Min, v);
+    s->m_Max = fmax(s->m_Max, v);
+    if (fabs(v - XMC_BUCK_VOUT) > SIM_BAND * XMC_BUCK_VOUT)
+    {
+        s->m_Settle = t;
+    }
+}
+
+/*******************************************************************************
+* Function Name: run
+********************************************************************************
+* Summary:
+* Runs the loop of a target through the load steps and prints the responses.
+* With the predictor, the compensator reads the prediction instead of the
+* sample, as in the code examples.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*  bool pred Predictor on
+*  float gain Factor on the k factor of the compensator
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run(int kit, bool pred, float gain)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[kit];
+    const SIM_PRED_DESIGN_t* p = &predDesigns[kit];
+    XMC_3P3Z_DATA_FIXED_t fixed;
+    XMC_3P3Z_DATA_FLOAT_t flt;
+    XMC_PRED_DATA_FIXED_t pFixed;
+    XMC_PRED_DATA_FLOAT_t pFloat;
+    XMC_BUCK_t buck;
+    SIM_STEP_t up = { 10.0, 0.0, 0.0 };
+    SIM_STEP_t down = { 10.0, 0.0, 0.0 };
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t stepUp = (uint32_t)(SIM_STEP_TIME * d->m_Fs);
+    uint32_t stepDown = stepUp + (uint32_t)(SIM_STEP_LENGTH * d->m_Fs);
+    uint32_t noiseStart = stepUp - (uint32_t)(SIM_NOISE_TIME * d->m_Fs);
+    uint32_t seed = 1U;
+    uint32_t n;
+    double sum = 0.0;
+    double sum2 = 0.0;
+    double duty;
+    double v;
+
+    XMC_BUCK_Init(&buck, d, XMC_BUCK_VIN, SIM_ILOAD_LOW);
+    buck.m_Delay = true;
+    adc = 0U;
+    if (kit == XMC_BUCK_XMC1)
+    {
+        XMC_3P3Z_InitFixed(&fixed, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K * gain, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+        XMC_PRED_InitFixed(&pFixed, p->m_A1, p->m_A2, p->m_B1, p->m_B2, 0U, d->m_DutyMin,
+                           4095U);
+        if (pred)
+        {
+            fixed.m_pFeedBack = &pFixed.m_Out;
+        }
+    }
+    else
+    {
+        XMC_3P3Z_InitFloat(&flt, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K * gain, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+        XMC_PRED_InitFloat(&pFloat, p->m_A1, p->m_A2, p->m_B1, p->m_B2, 0U, d->m_DutyMin,
+                           4095U);
+        if (pred)
+        {
+            flt.m_pFeedBack = &pFloat.m_Out;
+        }
+    }
+
+    for (n = 0; n < samples; n++)
+    {
+        /* As the control ISR of the code examples */
+        if (kit == XMC_BUCK_XMC1)
+        {
+            XMC_PRED_PredictFixed(&pFixed, adc);
+            XMC_3P3Z_FilterFixed(&fixed);
+            duty = (double)fixed.m_pOut;
+            XMC_PRED_ApplyFixed(&pFixed, fixed.m_pOut);
+        }
+        else
+        {
+            XMC_PRED_PredictFloat(&pFloat, adc);
+            XMC_3P3Z_FilterFloat(&flt);
+            duty = (double)flt.m_Out;
+            XMC_PRED_ApplyFloat(&pFloat, flt.m_Out);
+        }
+
+        buck.m_Load = ((n >= stepUp) && (n < stepDown)) ? SIM_ILOAD_HIGH : SIM_ILOAD_LOW;
+        v = XMC_BUCK_Run(&buck, duty);
+        adc = XMC_BUCK_Noise(&seed, XMC_BUCK_Adc(d, v), SIM_NOISE);
+
+        if ((n >= noiseStart) && (n < stepUp))
+        {
+            sum += v;
+            sum2 += v * v;
+        }
+        else if ((n >= stepUp) && (n < stepDown))
+        {
+            step_add(&up, v, (double)(n - stepUp) / d->m_Fs);
+        }
+        else if (n >= stepDown)
+        {
+            step_add(&down, v, (double)(n - stepDown) / d->m_Fs);
+        }
+    }
+
+    sum /= (stepUp - noiseStart);
+    sum2 = sqrt(fmax(sum2 / (stepUp - noiseStart) - sum * sum, 0.0));
+    printf("%-8s %-4s %5.2f %12.2f %14.0f %10.0f %13.0f %10.0f\n", d->m_Name,
+           pred ? "on" : "off", gain, sum2 * 1e3, (XMC_BUCK_VOUT - up.m_Min) * 1e3,
+           up.m_Settle * 1e6, (down.m_Max - XMC_BUCK_VOUT) * 1e3, down.m_Settle * 1e6);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs both targets with and without the predictor at both loop gains.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    int kit;
+
+    printf("one period of delay, load step %.0f A -> %.0f A -> %.0f A, settling into +/-%.0f%% of %.1f V\n",
+           SIM_ILOAD_LOW, SIM_ILOAD_HIGH, SIM_ILOAD_LOW, SIM_BAND * 100.0, XMC_BUCK_VOUT);
+    printf("%-8s %-4s %5s %12s %14s %10s %13s %10s\n", "target", "pred", "gain", "noise mV rms",
+           "undershoot mV", "settle us", "overshoot mV", "settle us");
+    for (kit = XMC_BUCK_XMC1; kit <= XMC_BUCK_XMC4; kit++)
+    {
+        run(kit, false, 1.0f);
+        run(kit, true, 1.0f);
+        run(kit, false, 1.25f);
+        run(kit, true, 1.25f);
+    }
+    return 0;
+}
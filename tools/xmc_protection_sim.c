@@ -0,0 +1,304 @@
+/******************************************************************************
+* File Name:   xmc_protection_sim.c
+*
+* Description: Host simulation of the protection of xmc_protection.h. The
+*              loop of each target runs on the averaged model of
+*              xmc_buck_model.h with the duty applied one period late, and the
+*              ISR and protection_task steps of the code examples: the sample
+*              and duty checks, the trap forcing both switches off at once,
+*              and the restart policy with the PROT_xxx settings. It runs the
+*              fault cases of the README with and without the protection.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_protection_sim xmc_protection_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_protection.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_FAULT_TIME        (0.05)      /* Fault at 50 ms */
+#define SIM_LOST_TIME         (0.05)      /* Feedback lost for 50 ms */
+#define SIM_TIME              (1.5)
+#define SIM_LOAD              (2.0)
+#define SIM_STEP_HIGH         (8.0)       /* Load step from 8 A to 0.2 A at the fault time */
+#define SIM_STEP_LOW          (0.2)
+#define SIM_STEP_LENGTH       (0.01)      /* Back to 8 A after 10 ms */
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+
+/* Gain of the too high tuning, a factor on K that makes both loops unstable */
+#define SIM_GAIN_FACTOR       (6.0f)
+
+/* PROT_xxx of the code examples */
+#define PROT_STUCK_SAMPLES    (4U)
+#define PROT_TASK_PERIOD      (0.01)      /* s */
+#define PROT_RESTART_DELAY    (10U)
+#define PROT_MAX_RESTARTS     (3U)
+#define PROT_STABLE_PERIODS   (100U)
+
+/* Fault cases */
+#define SIM_CASE_LOST         (0)
+#define SIM_CASE_LOST_FOREVER (1)
+#define SIM_CASE_GAIN         (2)
+#define SIM_CASE_LOAD         (3)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile uint32_t adc;
+
+static const char* const simCases[] =
+{
+    "feedback lost 50 ms", "feedback lost", "gain too high", "load 8 A -> 0.2 A"
+};
+
+/* PROT_OV_LEVEL of the code examples, about 4.0 V */
+static const uint32_t simOvLevel[] = { 4000U, 3900U };
+
+/*******************************************************************************
+* Function Name: run
+********************************************************************************
+* Summary:
+* Runs the loop of a target through a fault case and prints the peak output
+* voltage after the fault, the time from the fault to the first trip and its
+* cause, the trips, the restarts, and the output voltage at the end.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*  int simCase SIM_CASE_xxx
+*  bool prot Protection on
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run(int kit, int simCase, bool prot)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[kit];
+    XMC_3P3Z_DATA_FIXED_t fixed;
+    XMC_3P3Z_DATA_FLOAT_t flt;
+    XMC_3P3Z_DATA_FIXED_t fixedNew;
+    XMC_3P3Z_DATA_FLOAT_t fltNew;
+    XMC_PROT_t protection;
+    XMC_BUCK_t buck;
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t start = (uint32_t)(SIM_FAULT_TIME * d->m_Fs);
+    uint32_t end = start + (uint32_t)(SIM_LOST_TIME * d->m_Fs);
+    uint32_t step = start + (uint32_t)(SIM_STEP_LENGTH * d->m_Fs);
+    uint32_t task = (uint32_t)(PROT_TASK_PERIOD * d->m_Fs);
+    uint32_t firstTrip = 0U;
+    uint32_t firstCause = 0U;
+    uint32_t restarts = 0U;
+    uint32_t seed = 1U;
+    uint32_t fault;
+    uint32_t duty;
+    uint32_t n;
+    double pending = 0.0;
+    double next = 0.0;
+    double vPeak = 0.0;
+    double v = 0.0;
+    bool trapped = false;
+
+    XMC_BUCK_Init(&buck, d, XMC_BUCK_VIN, (simCase == SIM_CASE_LOAD) ? SIM_STEP_HIGH : SIM_LOAD);
+    adc = 0U;
+    XMC_PROT_Init(&protection, simOvLevel[kit], UINT32_MAX, d->m_DutyMax / 4U,
+                  PROT_STUCK_SAMPLES, d->m_DutyMax, PROT_RESTART_DELAY, PROT_MAX_RESTARTS,
+                  PROT_STABLE_PERIODS);
+    if (kit == XMC_BUCK_XMC1)
+    {
+        XMC_3P3Z_InitFixed(&fixed, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+        XMC_3P3Z_InitFixed(&fixedNew, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K * SIM_GAIN_FACTOR, d->m_Ref,
+                           d->m_DutyMin, d->m_DutyMax, &adc);
+    }
+    else
+    {
+        XMC_3P3Z_InitFloat(&flt, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,
+                           d->m_DutyMax, &adc);
+        XMC_3P3Z_InitFloat(&fltNew, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0],
+                           d->m_A[1], d->m_A[2], d->m_K * SIM_GAIN_FACTOR, d->m_Ref,
+                           d->m_DutyMin, d->m_DutyMax, &adc);
+    }
+
+    for (n = 0; n < samples; n++)
+    {
+        /* The ADC sample of the previous period, or the lost feedback */
+        adc = XMC_BUCK_Noise(&seed, XMC_BUCK_Adc(d, v), SIM_NOISE);
+        if (((simCase == SIM_CASE_LOST) && (n >= start) && (n < end)) ||
+            ((simCase == SIM_CASE_LOST_FOREVER) && (n >= start)))
+        {
+            adc = 0U;
+        }
+        if ((simCase == SIM_CASE_GAIN) && (n == start))
+        {
+            if (kit == XMC_BUCK_XMC1)
+            {
+                XMC_3P3Z_UpdateFixed(&fixed, &fixedNew);
+            }
+            else
+            {
+                XMC_3P3Z_UpdateFloat(&flt, &fltNew);
+            }
+        }
+        if (simCase == SIM_CASE_LOAD)
+        {
+            buck.m_Load = ((n >= start) && (n < step)) ? SIM_STEP_LOW : SIM_STEP_HIGH;
+        }
+
+        /* Control ISR: protection_check, compensator, duty check */
+        fault = 0U;
+        next = (double)d->m_DutyMin;
+        if (prot && (protection.m_Fault != 0U))
+        {
+            XMC_PROT_Observe(&protection, adc, 0U);
+            fault = protection.m_Fault;
+        }
+        else if (prot)
+        {
+            fault = XMC_PROT_CheckSample(&protection, adc, 0U);
+            if (fault != 0U)
+            {
+                XMC_PROT_Trip(&protection, fault);
+                trapped = true;
+            }
+        }
+        if (fault == 0U)
+        {
+            if (kit == XMC_BUCK_XMC1)
+            {
+                XMC_3P3Z_FilterFixed(&fixed);
+                duty = fixed.m_pOut;
+            }
+            else
+            {
+                XMC_3P3Z_FilterFloat(&flt);
+                duty = flt.m_Out;
+            }
+            if (prot && (XMC_PROT_CheckDuty(&protection, duty) != 0U))
+            {
+                XMC_PROT_Trip(&protection, XMC_PROT_FAULT_DUTY);
+                trapped = true;
+            }
+            else
+            {
+                next = (double)duty;
+            }
+        }
+        if (trapped && (firstTrip == 0U))
+        {
+            firstTrip = n;
+            firstCause = protection.m_LastFault;
+        }
+
+        /* The trap acts at once, a new duty one period late */
+        v = XMC_BUCK_Run(&buck, trapped ? -1.0 : pending);
+        pending = next;
+        if ((n >= start) && (v > vPeak))
+        {
+            vPeak = v;
+        }
+
+        /* protection_task */
+        if (prot && ((n % task) == 0U) && (XMC_PROT_Supervise(&protection) == XMC_PROT_RESTART))
+        {
+            if (kit == XMC_BUCK_XMC1)
+            {
+                XMC_3P3Z_PresetFixed(&fixed, 0);
+            }
+            else
+            {
+                XMC_3P3Z_PresetFloat(&flt, 0.0f);
+            }
+            trapped = false;
+            XMC_PROT_Release(&protection);
+            restarts++;
+        }
+    }
+
+    printf("%-8s %-20s %-4s %7.2f %9.0f  0x%02x %6u %9u %7s %7.2f\n", d->m_Name,
+           simCases[simCase], prot ? "on" : "off", vPeak,
+           (firstTrip == 0U) ? -1.0 : (double)(firstTrip - start) * 1e6 / d->m_Fs, firstCause,
+           (unsigned)protection.m_Trips, (unsigned)restarts,
+           protection.m_Locked ? "yes" : "no", v);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs both targets through the fault cases with and without the protection.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    int kit;
+    int simCase;
+
+    printf("fault at %.0f ms, %.0f A load, gain too high: K x %.2f\n", SIM_FAULT_TIME * 1e3,
+           SIM_LOAD, SIM_GAIN_FACTOR);
+    printf("%-8s %-20s %-4s %7s %9s %5s %6s %9s %7s %7s\n", "target", "case", "prot", "peak V",
+           "trip us", "cause", "trips", "restarts", "locked", "end V");
+    for (kit = XMC_BUCK_XMC1; kit <= XMC_BUCK_XMC4; kit++)
+    {
+        for (simCase = SIM_CASE_LOST; simCase <= SIM_CASE_LOAD; simCase++)
+        {
+            run(kit, simCase, false);
+            run(kit, simCase, true);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,463 @@
+/******************************************************************************
+* File Name:   xmc_realization_sim.c
+*
+* Description: Host check of the filter realizations of
+*              xmc_3p3z_realization_fixed.h and xmc_3p3z_realization_float.h.
+*              For both designs, it computes the pole drift caused by the
+*              truncated coefficients, for the direct forms and for the
+*              factored forms of xmc_3p3z_factor.h, at Q14 and Q10. It then
+*              runs every realization in the loop on the averaged model of
+*              xmc_buck_model.h, with ADC noise, and reports the mean
+*              regulation error and the host time per sample of the
+*              realization. The fixed-point realizations run the XMC1300
+*              design only, as in README.md.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -I../source/common -o xmc_realization_sim xmc_realization_sim.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <complex.h>
+#include <math.h>
+#include <time.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_3p3z_realization_fixed.h"
+#include "xmc_3p3z_realization_float.h"
+#include "xmc_buck_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_LOAD              (4.0)       /* Load current in A */
+#define SIM_TIME              (0.2)       /* Measured over the second half */
+#define SIM_NOISE             (2U)        /* ADC noise, uniform in +/- counts */
+#define SIM_MAX_SAMPLES       (40000U)    /* SIM_TIME at the highest rate */
+#define SIM_TIMING_RUNS       (200)       /* Best of, for the time per sample */
+
+/* Realizations */
+#define SIM_DF1               (0)
+#define SIM_TDF2              (1)
+#define SIM_CASCADE           (2)
+#define SIM_STATE_SPACE       (3)
+#define SIM_REALIZATIONS      (4)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* State of every realization, one is used at a time */
+typedef union SIM_FILTER
+{
+    XMC_3P3Z_DATA_FIXED_t     m_Df1Fixed;
+    XMC_3P3Z_TDF2_FIXED_t     m_Tdf2Fixed;
+    XMC_3P3Z_CASCADE_FIXED_t  m_CascadeFixed;
+    XMC_3P3Z_SS_FIXED_t       m_SsFixed;
+    XMC_3P3Z_DATA_FLOAT_t     m_Df1Float;
+    XMC_3P3Z_TDF2_FLOAT_t     m_Tdf2Float;
+    XMC_3P3Z_CASCADE_FLOAT_t  m_CascadeFloat;
+    XMC_3P3Z_SS_FLOAT_t       m_SsFloat;
+} SIM_FILTER_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char* const simNames[SIM_REALIZATIONS] =
+{
+    "direct form I", "transposed DF II", "cascade", "state-space"
+};
+
+static volatile uint32_t adc;
+static uint32_t traceAdc[SIM_MAX_SAMPLES];
+
+/*******************************************************************************
+* Function Name: cubic_roots
+********************************************************************************
+* Summary:
+* Finds the roots of z^3 + p1 z^2 + p2 z + p3 with the Durand-Kerner
+* iteration.
+*
+* Parameters:
+*  double complex* r Three roots
+*  double p1..p3 Coefficients
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void cubic_roots(double complex* r, double p1, double p2, double p3)
+{
+    double complex f;
+    double complex d;
+    int i;
+    int j;
+    int k;
+
+    for (i = 0; i < 3; i++)
+    {
+        r[i] = cpow(0.4 + 0.9 * I, i);
+    }
+    for (k = 0; k < 500; k++)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            f = ((r[i] + p1) * r[i] + p2) * r[i] + p3;
+            d = 1.0;
+            for (j = 0; j < 3; j++)
+            {
+                if (j != i)
+                {
+                    d *= r[i] - r[j];
+                }
+            }
+            r[i] -= f / d;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: drift
+********************************************************************************
+* Summary:
+* Returns the largest distance between an exact pole and the nearest of the
+* quantized poles.
+*
+* Parameters:
+*  const double complex* exact Exact poles
+*  const double complex* quant Quantized poles
+*
+* Return:
+*  double Pole drift
+*
+*******************************************************************************/
+static double drift(const double complex* exact, const double complex* quant)
+{
+    double worst = 0.0;
+    double near;
+    int i;
+    int j;
+
+    for (i = 0; i < 3; i++)
+    {
+        near = 1e9;
+        for (j = 0; j < 3; j++)
+        {
+            near = fmin(near, cabs(exact[i] - quant[j]));
+        }
+        worst = fmax(worst, near);
+    }
+    return worst;
+}
+
+/*******************************************************************************
+* Function Name: integrator
+********************************************************************************
+* Summary:
+* Returns the pole closest to 1.
+*
+* Parameters:
+*  const double complex* r Poles
+*
+* Return:
+*  double Real part of the pole
+*
+*******************************************************************************/
+static double integrator(const double complex* r)
+{
+    int best = 0;
+    int i;
+
+    for (i = 1; i < 3; i++)
+    {
+        if (cabs(r[i] - 1.0) < cabs(r[best] - 1.0))
+        {
+            best = i;
+        }
+    }
+    return creal(r[best]);
+}
+
+/*******************************************************************************
+* Function Name: pole_drift
+********************************************************************************
+* Summary:
+* Prints the pole drift of a design at a coefficient word length. The direct
+* forms store A, the factored forms store R - 1, C1 and C0, all truncated as
+* FIX_FROM_FLOAT does.
+*
+* Parameters:
+*  const XMC_BUCK_DESIGN_t* d Design
+*  int q Fractional bits of the coefficients
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void pole_drift(const XMC_BUCK_DESIGN_t* d, int q)
+{
+    XMC_3P3Z_FACTOR_t den;
+    double complex exact[3];
+    double complex direct[3];
+    double complex factored[3];
+    double scale = (double)(1 << q);
+    double c1;
+    double c0;
+    double disc;
+
+    cubic_roots(exact, -d->m_A[0], -d->m_A[1], -d->m_A[2]);
+    cubic_roots(direct, -FIX_FROM_FLOAT(d->m_A[0], q) / scale,
+                -FIX_FROM_FLOAT(d->m_A[1], q) / scale, -FIX_FROM_FLOAT(d->m_A[2], q) / scale);
+
+    XMC_3P3Z_FactorCubic(&den, -d->m_A[0], -d->m_A[1], -d->m_A[2], 1.0f);
+    c1 = FIX_FROM_FLOAT(den.m_C1, q) / scale;
+    c0 = FIX_FROM_FLOAT(den.m_C0, q) / scale;
+    disc = c1 * c1 - 4.0 * c0;
+    factored[0] = 1.0 + FIX_FROM_FLOAT(den.m_R - 1.0f, q) / scale;
+    factored[1] = (-c1 + csqrt(disc)) / 2.0;
+    factored[2] = (-c1 - csqrt(disc)) / 2.0;
+
+    printf("%-8s Q%-3d %10.1e %12.6f %10.1e %12.6f\n", d->m_Name, q, drift(exact, direct),
+           integrator(direct), drift(exact, factored), integrator(factored));
+}
+
+/*******************************************************************************
+* Function Name: filter_init
+********************************************************************************
+* Summary:
+* Initializes a realization with the coefficients of a design.
+*
+* Parameters:
+*  SIM_FILTER_t* f Filter
+*  const XMC_BUCK_DESIGN_t* d Design
+*  int real SIM_DF1, SIM_TDF2, SIM_CASCADE or SIM_STATE_SPACE
+*  bool fixed Fixed-point realization
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void filter_init(SIM_FILTER_t* f, const XMC_BUCK_DESIGN_t* d, int real, bool fixed)
+{
+#define SIM_INIT(fn, s) fn(&f->s, d->m_B[0], d->m_B[1], d->m_B[2], d->m_B[3], d->m_A[0], \
+                           d->m_A[1], d->m_A[2], d->m_K, d->m_Ref, d->m_DutyMin,        \
+                           d->m_DutyMax, &adc)
+    switch ((real << 1) | (fixed ? 1 : 0))
+    {
+    case (SIM_DF1 << 1) | 1:         SIM_INIT(XMC_3P3Z_InitFixed, m_Df1Fixed); break;
+    case (SIM_TDF2 << 1) | 1:        SIM_INIT(XMC_3P3Z_InitTdf2Fixed, m_Tdf2Fixed); break;
+    case (SIM_CASCADE << 1) | 1:     SIM_INIT(XMC_3P3Z_InitCascadeFixed, m_CascadeFixed); break;
+    case (SIM_STATE_SPACE << 1) | 1: SIM_INIT(XMC_3P3Z_InitStateSpaceFixed, m_SsFixed); break;
+    case (SIM_DF1 << 1):             SIM_INIT(XMC_3P3Z_InitFloat, m_Df1Float); break;
+    case (SIM_TDF2 << 1):            SIM_INIT(XMC_3P3Z_InitTdf2Float, m_Tdf2Float); break;
+    case (SIM_CASCADE << 1):         SIM_INIT(XMC_3P3Z_InitCascadeFloat, m_CascadeFloat); break;
+    default:                         SIM_INIT(XMC_3P3Z_InitStateSpaceFloat, m_SsFloat); break;
+    }
+#undef SIM_INIT
+}
+
+/*******************************************************************************
+* Function Name: filter_run
+********************************************************************************
+* Summary:
+* Runs a realization on the latest ADC sample.
+*
+* Parameters:
+*  SIM_FILTER_t* f Filter
+*  int real SIM_DF1, SIM_TDF2, SIM_CASCADE or SIM_STATE_SPACE
+*  bool fixed Fixed-point realization
+*
+* Return:
+*  uint32_t Duty in ticks
+*
+*******************************************************************************/
+static uint32_t filter_run(SIM_FILTER_t* f, int real, bool fixed)
+{
+    switch ((real << 1) | (fixed ? 1 : 0))
+    {
+    case (SIM_DF1 << 1) | 1:
+        XMC_3P3Z_FilterFixed(&f->m_Df1Fixed);
+        return f->m_Df1Fixed.m_pOut;
+    case (SIM_TDF2 << 1) | 1:
+        XMC_3P3Z_FilterTdf2Fixed(&f->m_Tdf2Fixed);
+        return f->m_Tdf2Fixed.m_pOut;
+    case (SIM_CASCADE << 1) | 1:
+        XMC_3P3Z_FilterCascadeFixed(&f->m_CascadeFixed);
+        return f->m_CascadeFixed.m_pOut;
+    case (SIM_STATE_SPACE << 1) | 1:
+        XMC_3P3Z_FilterStateSpaceFixed(&f->m_SsFixed);
+        return f->m_SsFixed.m_pOut;
+    case (SIM_DF1 << 1):
+        XMC_3P3Z_FilterFloat(&f->m_Df1Float);
+        return f->m_Df1Float.m_Out;
+    case (SIM_TDF2 << 1):
+        XMC_3P3Z_FilterTdf2Float(&f->m_Tdf2Float);
+        return f->m_Tdf2Float.m_Out;
+    case (SIM_CASCADE << 1):
+        XMC_3P3Z_FilterCascadeFloat(&f->m_CascadeFloat);
+        return f->m_CascadeFloat.m_Out;
+    default:
+        XMC_3P3Z_FilterStateSpaceFloat(&f->m_SsFloat);
+        return f->m_SsFloat.m_Out;
+    }
+}
+
+/*******************************************************************************
+* Function Name: regulate
+********************************************************************************
+* Summary:
+* Runs a realization in the loop and prints the mean regulation error and its
+* spread over the second half of the run. The error is taken before the ADC
+* noise is added. The realization is then timed alone on the recorded ADC
+* samples of the run, best of SIM_TIMING_RUNS.
+*
+* Parameters:
+*  int kit XMC_BUCK_XMC1 or XMC_BUCK_XMC4
+*  int real SIM_DF1, SIM_TDF2, SIM_CASCADE or SIM_STATE_SPACE
+*  bool fixed Fixed-point realization
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void regulate(int kit, int real, bool fixed)
+{
+    const XMC_BUCK_DESIGN_t* d = &xmcBuckDesigns[kit];
+    SIM_FILTER_t f;
+    XMC_BUCK_t buck;
+    uint32_t samples = (uint32_t)(SIM_TIME * d->m_Fs);
+    uint32_t seed = 1U;
+    uint32_t count = 0U;
+    uint32_t n;
+    uint32_t clean;
+    double sum = 0.0;
+    double sum2 = 0.0;
+    double best = 1e9;
+    double e;
+    double v;
+    struct timespec t0;
+    struct timespec t1;
+    int run;
+
+    XMC_BUCK_Init(&buck, d, XMC_BUCK_VIN, SIM_LOAD);
+    adc = 0U;
+    filter_init(&f, d, real, fixed);
+
+    for (n = 0; n < samples; n++)
+    {
+        traceAdc[n] = adc;
+        v = XMC_BUCK_Run(&buck, (double)filter_run(&f, real, fixed));
+        clean = XMC_BUCK_Adc(d, v);
+        adc = XMC_BUCK_Noise(&seed, clean, SIM_NOISE);
+        if (n >= samples / 2U)
+        {
+            e = (double)d->m_Ref - (double)clean;
+            sum += e;
+            sum2 += e * e;
+            count++;
+        }
+    }
+
+    for (run = 0; run < SIM_TIMING_RUNS; run++)
+    {
+        filter_init(&f, d, real, fixed);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (n = 0; n < samples; n++)
+        {
+            adc = traceAdc[n];
+            (void)filter_run(&f, real, fixed);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        e = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / samples;
+        best = fmin(best, e);
+    }
+
+    sum /= count;
+    printf("%-8s %-6s %-17s %10.3f %10.2f %10.1f\n", d->m_Name, fixed ? "fixed" : "float",
+           simNames[real], sum, sqrt(fmax(sum2 / count - sum * sum, 0.0)), best);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Prints the pole drift of both designs, and the regulation error and the time
+* per sample of every realization.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    int kit;
+    int real;
+
+    printf("pole drift, integrator pole in brackets\n");
+    printf("%-8s %-4s %10s %12s %10s %12s\n", "design", "coef", "direct", "(integr.)",
+           "factored", "(integr.)");
+    for (kit = XMC_BUCK_XMC1; kit <= XMC_BUCK_XMC4; kit++)
+    {
+        pole_drift(&xmcBuckDesigns[kit], 14);
+        pole_drift(&xmcBuckDesigns[kit], 10);
+    }
+
+    printf("\nregulation error at %.0f A, +/-%u counts of ADC noise, in ADC counts\n",
+           SIM_LOAD, SIM_NOISE);
+    printf("%-8s %-6s %-17s %10s %10s %10s\n", "design", "kernel", "realization", "mean",
+           "std dev", "ns/smp");
+    for (real = SIM_DF1; real < SIM_REALIZATIONS; real++)
+    {
+        regulate(XMC_BUCK_XMC1, real, true);
+    }
+    for (kit = XMC_BUCK_XMC1; kit <= XMC_BUCK_XMC4; kit++)
+    {
+        for (real = SIM_DF1; real < SIM_REALIZATIONS; real++)
+        {
+            regulate(kit, real, false);
+        }
+    }
+    return 0;
+}
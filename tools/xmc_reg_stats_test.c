@@ -0,0 +1,373 @@
+/******************************************************************************
+* File Name:   xmc_reg_stats_test.c
+*
+* Description: Host test of xmc_reg_stats.h. The window statistics are
+*              compared with a double precision reference computed from the
+*              same samples, for every window length and for signals up to
+*              the ADC full scale. A second thread stands in for the control
+*              ISR and publishes windows of a constant sample while the main
+*              thread reads them, so that a torn copy shows as a non-zero
+*              spread. This check needs at least two cores to interleave
+*              the threads. The program returns 1 if a check fails.
+*              Built on Linux with:
+*
+*              gcc -O2 -Wall -pthread -I../source/common -o xmc_reg_stats_test xmc_reg_stats_test.c -lm
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+
+#define __STATIC_INLINE static inline
+/* The reader and the writer threads run on different cores of the host, a
+ * full fence stands in for the DMB of the target */
+#define __DMB()         __sync_synchronize()
+#include "xmc_reg_stats.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_WINDOWS          (3U)        /* Windows checked per case */
+#define TEST_TOLERANCE        (1e-6)      /* Relative, float results */
+#define TEST_TIME             (1.0)       /* Length of the concurrency test in s */
+#define TEST_WRITER_SPIN      (50U)       /* Delay between two windows */
+#define TEST_REF              (3300)      /* Reference for the error in ADC counts */
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Test signal, returns the sample n in ADC counts */
+typedef uint32_t (*TEST_SIGNAL_t)(uint32_t n);
+
+typedef struct TEST_CASE
+{
+    const char*         m_Name;
+    TEST_SIGNAL_t       m_Signal;
+} TEST_CASE_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static XMC_STATS_t sharedStats;
+static volatile bool writerStop;
+
+/*******************************************************************************
+* Function Name: sig_xxx
+********************************************************************************
+* Summary:
+* Test signals: the ADC limits, a full-scale square wave, a ramp and a ripple
+* with noise around the reference.
+*
+* Parameters:
+*  uint32_t n Sample number
+*
+* Return:
+*  uint32_t Sample in ADC counts
+*
+*******************************************************************************/
+static uint32_t sig_zero(uint32_t n)
+{
+    (void)n;
+    return 0U;
+}
+
+static uint32_t sig_full(uint32_t n)
+{
+    (void)n;
+    return 4095U;
+}
+
+static uint32_t sig_square(uint32_t n)
+{
+    return ((n & 1U) != 0U) ? 4095U : 0U;
+}
+
+static uint32_t sig_ramp(uint32_t n)
+{
+    return n % 4096U;
+}
+
+static uint32_t sig_ripple(uint32_t n)
+{
+    static uint32_t seed = 1U;
+
+    seed = seed * 1664525U + 1013904223U;
+    return (uint32_t)(TEST_REF + (int32_t)lrint(40.0 * sin(0.3 * n)) +
+                      (int32_t)((seed >> 16) % 7U) - 3);
+}
+
+static const TEST_CASE_t testCases[] =
+{
+    { "zero",   sig_zero   },
+    { "full",   sig_full   },
+    { "square", sig_square },
+    { "ramp",   sig_ramp   },
+    { "ripple", sig_ripple },
+};
+
+/*******************************************************************************
+* Function Name: check
+********************************************************************************
+* Summary:
+* Compares a result with its reference and prints a failure.
+*
+* Parameters:
+*  const char* what Name of the value
+*  double value Result
+*  double ref Reference
+*
+* Return:
+*  bool true if the result is within the tolerance
+*
+*******************************************************************************/
+static bool check(const char* what, double value, double ref)
+{
+    if (fabs(value - ref) <= TEST_TOLERANCE * fmax(1.0, fabs(ref)))
+    {
+        return true;
+    }
+    printf("  %s: %.9g, reference %.9g\n", what, value, ref);
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: test_window
+********************************************************************************
+* Summary:
+* Runs a signal through TEST_WINDOWS windows of 2^log2N samples and compares
+* the statistics of each window with a double precision reference.
+*
+* Parameters:
+*  const TEST_CASE_t* c Test case
+*  uint32_t log2N Window length as a power of two
+*
+* Return:
+*  bool true if every window matches
+*
+*******************************************************************************/
+static bool test_window(const TEST_CASE_t* c, uint32_t log2N)
+{
+    XMC_STATS_t stats;
+    XMC_STATS_RESULT_t res;
+    uint32_t len = 1UL << log2N;
+    uint32_t n = 0U;
+    uint32_t w;
+    uint32_t i;
+    bool ok = true;
+
+    XMC_STATS_Init(&stats, log2N);
+    for (w = 0U; w < TEST_WINDOWS; w++)
+    {
+        double sumV = 0.0;
+        double sumV2 = 0.0;
+        double sumE = 0.0;
+        double sumE2 = 0.0;
+        uint32_t minV = UINT32_MAX;
+        uint32_t maxV = 0U;
+        bool done = false;
+
+        for (i = 0U; i < len; i++, n++)
+        {
+            uint32_t v = c->m_Signal(n);
+            int32_t e = TEST_REF - (int32_t)v;
+
+            sumV  += v;
+            sumV2 += (double)v * v;
+            sumE  += e;
+            sumE2 += (double)e * e;
+            minV = (v < minV) ? v : minV;
+            maxV = (v > maxV) ? v : maxV;
+            done = XMC_STATS_Update(&stats, v, e);
+        }
+
+        XMC_STATS_Read(&stats, &res);
+        if (!done || (res.m_Seq != w + 1U))
+        {
+            printf("  window %u not published\n", (unsigned)w);
+            ok = false;
+            continue;
+        }
+
+        /* The sums are exact in double for up to 2^12 samples of 12 bits */
+        ok &= check("mean", res.m_MeanV, sumV / len);
+        ok &= check("ripple rms", res.m_RippleRms,
+                    sqrt((len * sumV2 - sumV * sumV) / ((double)len * len)));
+        ok &= check("peak-peak", res.m_PeakPeak, maxV - minV);
+        ok &= check("error mean", res.m_MeanE, sumE / len);
+        ok &= check("error variance", res.m_VarE,
+                    (len * sumE2 - sumE * sumE) / ((double)len * len));
+    }
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: writer
+********************************************************************************
+* Summary:
+* Stands in for the control ISR: publishes windows of one sample each, with a
+* different constant sample in every window, at a steady pace.
+*
+* Parameters:
+*  void* arg Not used
+*
+* Return:
+*  void* NULL
+*
+*******************************************************************************/
+static void* writer(void* arg)
+{
+    uint32_t k = 0U;
+    volatile uint32_t spin;
+
+    (void)arg;
+    while (!writerStop)
+    {
+        uint32_t v = (k * 2647U) % 4096U;
+
+        (void)XMC_STATS_Update(&sharedStats, v, TEST_REF - (int32_t)v);
+        k++;
+        for (spin = 0U; spin < TEST_WRITER_SPIN; spin++)
+        {
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: test_concurrent
+********************************************************************************
+* Summary:
+* Reads the statistics while the writer thread publishes. Every window holds a
+* single sample, so a consistent copy has no spread and its mean and error
+* mean add up to the reference.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool true if no read was torn
+*
+*******************************************************************************/
+static bool test_concurrent(void)
+{
+    XMC_STATS_RESULT_t res;
+    pthread_t thread;
+    struct timespec t0;
+    struct timespec t1;
+    uint32_t lastSeq = 0U;
+    unsigned long reads = 0UL;
+    unsigned long changes = 0UL;
+    unsigned long torn = 0UL;
+
+    memset(&res, 0, sizeof(res));
+
+    XMC_STATS_Init(&sharedStats, 0U);
+    writerStop = false;
+    if (pthread_create(&thread, NULL, writer, NULL) != 0)
+    {
+        printf("concurrent: no thread\n");
+        return false;
+    }
+
+    while (sharedStats.m_Seq == 0U)
+    {
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    do
+    {
+        XMC_STATS_Read(&sharedStats, &res);
+        reads++;
+        changes += (res.m_Seq != lastSeq) ? 1UL : 0UL;
+        lastSeq = res.m_Seq;
+        if ((res.m_PeakPeak != 0U) || (res.m_RippleRms != 0.0f) || (res.m_VarE != 0.0f) ||
+            (res.m_MeanV + res.m_MeanE != (float)TEST_REF))
+        {
+            torn++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+    } while ((double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9 < TEST_TIME);
+
+    writerStop = true;
+    (void)pthread_join(thread, NULL);
+
+    printf("concurrent: %lu reads, %lu new windows seen, %lu torn\n",
+           reads, changes, torn);
+    return (torn == 0UL) && (changes > 0UL);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs every signal at every window length, then the concurrency test.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int 0 if all checks pass, 1 otherwise
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t i;
+    uint32_t log2N;
+    bool ok = true;
+
+    for (i = 0U; i < sizeof(testCases) / sizeof(testCases[0]); i++)
+    {
+        bool caseOk = true;
+
+        for (log2N = 0U; log2N <= XMC_STATS_MAX_LOG2_WINDOW; log2N++)
+        {
+            caseOk &= test_window(&testCases[i], log2N);
+        }
+        printf("%-8s windows 2^0..2^%u: %s\n", testCases[i].m_Name,
+               (unsigned)XMC_STATS_MAX_LOG2_WINDOW, caseOk ? "ok" : "FAILED");
+        ok &= caseOk;
+    }
+
+    ok &= test_concurrent();
+    printf("%s\n", ok ? "PASSED" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,922 @@
+/******************************************************************************
+* File Name:   xmc_trace.c
+*
+* Description: Host tool for the control loop traces of xmc_trace.h.
+*
+*              gen    records the loop of an XMC1302 or XMC4200 target on an
+*                     averaged model of the buck converter, with load steps,
+*                     ADC noise, a parameter update and an injected fault, at
+*                     any length. It is a stand-in for a trace of the board.
+*              info   decodes a trace and prints its content and the decoding
+*                     speed.
+*              dump   prints the records from a byte position on.
+*              replay feeds the ADC samples of a trace through the four filter
+*                     kernels of xmc_compensator.h at full host speed, follows
+*                     the fault, burst mode and tuning events, and compares the
+*                     outputs with the recorded duty and with the kernel of
+*                     the recording target.
+*
+*              Built on Linux with:
+*
+*              gcc -O2 -fwrapv -Wall -I../source/common -o xmc_trace xmc_trace.c -lm
+*
+*              The partial sums of B x E in the fixed kernel can leave the
+*              int32 range even when the final sum fits. Signed overflow is
+*              undefined in C, and -fwrapv makes it wrap as the ARM adds do,
+*              so the host computes the same sum as the target.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+#define _DEFAULT_SOURCE
+#define _FILE_OFFSET_BITS 64
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define __STATIC_INLINE static inline
+#include "xmc_3p3z_filter_float.h"
+#include "xmc_3p3z_filter_fixed.h"
+#include "xmc_3p3z_filter_q15.h"
+#include "xmc_3p3z_filter_q31.h"
+#include "xmc_compensator.h"
+#include "xmc_protection.h"
+#include "xmc_trace_file.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_VIN               (12.0)      /* Input voltage in V */
+#define SIM_VOUT              (3.3)       /* Output voltage in V, for the load resistance */
+#define SIM_L                 (10e-6)     /* Inductance in H */
+#define SIM_C                 (470e-6)    /* Output capacitance in F */
+#define SIM_ESR               (0.01)      /* Capacitor ESR in Ohm */
+#define SIM_DCR               (0.02)      /* Inductor DCR in Ohm */
+#define SIM_ILOAD_LOW         (1.0)       /* Load current at SIM_VOUT in A */
+#define SIM_ILOAD_HIGH        (8.0)
+#define SIM_STEP_TIME         (0.01)      /* Load steps every 10 ms */
+#define SIM_SUBSTEPS          (20)        /* Integration steps per sample */
+#define SIM_NOISE             (2)         /* ADC noise, uniform in +/- counts */
+#define GEN_TUNE_K            (0.8f)      /* K of the update at 1/2 of the trace */
+#define GEN_FAULT_TIME        (0.002)     /* Fault at 3/4 of the trace, for 2 ms */
+#define GEN_SYNC_INTERVAL     (256U)
+#define BACKEND_COUNT         (4)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Compensator design and converter of one target */
+typedef struct TRACE_DESIGN
+{
+    uint8_t             m_Kit;
+    uint8_t             m_Backend;    /* Backend of the code example */
+    double              m_Fs;         /* Control loop frequency in Hz */
+    double              m_Period;     /* Switching period in duty ticks */
+    double              m_AdcGain;    /* ADC counts per V */
+    float               m_Param[XMC_CMD_PARAM_COUNT];
+} TRACE_DESIGN_t;
+
+/* Difference of a kernel output against a reference */
+typedef struct REPLAY_DIFF
+{
+    uint64_t            m_Count;
+    uint64_t            m_Mismatch;
+    uint32_t            m_Max;
+    double              m_Sum2;
+    uint64_t            m_First;      /* Period of the first mismatch */
+} REPLAY_DIFF_t;
+
+/* Events of the period of the sample being replayed */
+typedef struct REPLAY_EVENTS
+{
+    bool                m_Fault;
+    int32_t             m_FaultCause;
+    bool                m_Restart;
+    int32_t             m_RestartDuty;
+    bool                m_BurstEnter;
+    bool                m_BurstExit;
+    int32_t             m_ResumeDuty;
+    bool                m_Tune;
+    bool                m_HaveParam;
+    float               m_Param[XMC_CMD_PARAM_COUNT];
+} REPLAY_EVENTS_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const TRACE_DESIGN_t designs[] =
+{
+    {
+        1U, XMC_COMP_FIXED, 100e3, 640.0, 1000.0,
+        { +0.649757898241f, -0.582384858571f, -0.649256971688f, +0.582885785125f,
+          +1.335491183190f, -0.211704021559f, -0.123787161631f, +0.657007535988f,
+          3300.0f, 0.0f, 576.0f }
+    },
+    {
+        4U, XMC_COMP_FLOAT, 200e3, 102400.0, 3215.0 / 3.3,
+        { +1.072329384164f, -1.009391619615f, -1.071806296352f, +1.009914707427f,
+          +1.611302392630f, -0.426276608711f, -0.185025783919f, +105.121205758148f,
+          3215.0f, 0.0f, 92160.0f }
+    }
+};
+
+static const char* const backendNames[BACKEND_COUNT] = { "float", "Q19/Q14", "Q15", "Q31-64" };
+
+static const char* const eventNames[] =
+{
+    "?", "fault", "restart", "burst-enter", "burst-exit", "tune", "drop"
+};
+
+/* Kernels, indexed by XMC_COMP_xxx, all fed from the same sample */
+static volatile uint32_t feedback;
+static XMC_3P3Z_DATA_FLOAT_t kFloat;
+static XMC_3P3Z_DATA_FIXED_t kFixed;
+static XMC_3P3Z_DATA_Q15_t kQ15;
+static XMC_3P3Z_DATA_Q31_t kQ31;
+
+static XMC_TRACE_WRITER_t writer;
+
+/*******************************************************************************
+* Kernels
+*******************************************************************************/
+static void kernel_make(int backend, void* p, const float* c)
+{
+    uint16_t ref = (uint16_t)c[XMC_CMD_PARAM_REF];
+    uint32_t min = (uint32_t)c[XMC_CMD_PARAM_OUT_MIN];
+    uint32_t max = (uint32_t)c[XMC_CMD_PARAM_OUT_MAX];
+
+    switch (backend)
+    {
+        case XMC_COMP_FLOAT:
+            XMC_3P3Z_InitFloat(p, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], ref,
+                               c[XMC_CMD_PARAM_OUT_MIN], c[XMC_CMD_PARAM_OUT_MAX], &feedback);
+            break;
+        case XMC_COMP_FIXED:
+            XMC_3P3Z_InitFixed(p, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], ref,
+                               min, max, &feedback);
+            break;
+        case XMC_COMP_Q15:
+            XMC_3P3Z_InitQ15(p, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], ref,
+                             min, max, &feedback);
+            break;
+        default:
+            XMC_3P3Z_InitQ31(p, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], ref,
+                             min, max, &feedback);
+            break;
+    }
+}
+
+/* The kernel of the recording target gets its anti-windup, the others clamp */
+static void kernels_init(const XMC_TRACE_HEADER_t* h)
+{
+    kernel_make(XMC_COMP_FLOAT, &kFloat, h->m_Param);
+    kernel_make(XMC_COMP_FIXED, &kFixed, h->m_Param);
+    kernel_make(XMC_COMP_Q15, &kQ15, h->m_Param);
+    kernel_make(XMC_COMP_Q31, &kQ31, h->m_Param);
+
+    if (h->m_Backend == XMC_COMP_FLOAT)
+    {
+        XMC_3P3Z_InitAntiWindupFloat(&kFloat, h->m_AwMode, h->m_AwGain);
+    }
+    else if (h->m_Backend == XMC_COMP_FIXED)
+    {
+        XMC_3P3Z_InitAntiWindupFixed(&kFixed, h->m_AwMode, h->m_AwShift);
+    }
+}
+
+/* New parameters with the history kept, as tune_take on the target */
+static void kernels_update(const float* c)
+{
+    XMC_3P3Z_DATA_FLOAT_t f;
+    XMC_3P3Z_DATA_FIXED_t x;
+    XMC_3P3Z_DATA_Q15_t q15;
+    XMC_3P3Z_DATA_Q31_t q31;
+
+    kernel_make(XMC_COMP_FLOAT, &f, c);
+    XMC_3P3Z_UpdateFloat(&kFloat, &f);
+    kernel_make(XMC_COMP_FIXED, &x, c);
+    XMC_3P3Z_UpdateFixed(&kFixed, &x);
+
+    kernel_make(XMC_COMP_Q15, &q15, c);
+    memcpy(q15.m_E, kQ15.m_E, sizeof(q15.m_E));
+    memcpy(q15.m_U, kQ15.m_U, sizeof(q15.m_U));
+    kQ15 = q15;
+    kernel_make(XMC_COMP_Q31, &q31, c);
+    memcpy(q31.m_E, kQ31.m_E, sizeof(q31.m_E));
+    memcpy(q31.m_U, kQ31.m_U, sizeof(q31.m_U));
+    kQ31 = q31;
+}
+
+static void kernels_preset(int32_t duty)
+{
+    XMC_3P3Z_PresetFloat(&kFloat, (float)duty);
+    XMC_3P3Z_PresetFixed(&kFixed, duty);
+    XMC_3P3Z_PresetQ15(&kQ15, duty);
+    XMC_3P3Z_PresetQ31(&kQ31, duty);
+}
+
+static void kernels_run(uint32_t adc, uint32_t* pOut)
+{
+    feedback = adc;
+    XMC_3P3Z_FilterFloat(&kFloat);
+    XMC_3P3Z_FilterFixed(&kFixed);
+    XMC_3P3Z_FilterQ15(&kQ15);
+    XMC_3P3Z_FilterQ31(&kQ31);
+    pOut[XMC_COMP_FLOAT] = kFloat.m_Out;
+    pOut[XMC_COMP_FIXED] = kFixed.m_pOut;
+    pOut[XMC_COMP_Q15]   = kQ15.m_pOut;
+    pOut[XMC_COMP_Q31]   = kQ31.m_pOut;
+}
+
+/* Kernel of the target only, for the recording */
+static uint32_t kernel_native_run(int backend, uint32_t adc)
+{
+    feedback = adc;
+    if (backend == XMC_COMP_FLOAT)
+    {
+        XMC_3P3Z_FilterFloat(&kFloat);
+        return kFloat.m_Out;
+    }
+    XMC_3P3Z_FilterFixed(&kFixed);
+    return kFixed.m_pOut;
+}
+
+static void diff_add(REPLAY_DIFF_t* d, uint32_t out, uint32_t ref, uint64_t time)
+{
+    uint32_t err = (out > ref) ? (out - ref) : (ref - out);
+
+    d->m_Count++;
+    if (err == 0U)
+    {
+        return;
+    }
+    if (d->m_Mismatch++ == 0U)
+    {
+        d->m_First = time;
+    }
+    if (err > d->m_Max)
+    {
+        d->m_Max = err;
+    }
+    d->m_Sum2 += (double)err * (double)err;
+}
+
+static void diff_print(const REPLAY_DIFF_t* d)
+{
+    if (d->m_Count == 0U)
+    {
+        printf("  %10s %7s %9s %10s", "-", "-", "-", "-");
+    }
+    else if (d->m_Mismatch == 0U)
+    {
+        printf("  %10s %7u %9.2f %10s", "0", 0U, 0.0, "-");
+    }
+    else
+    {
+        printf("  %10llu %7u %9.2f %10llu", (unsigned long long)d->m_Mismatch, (unsigned)d->m_Max,
+               sqrt(d->m_Sum2 / (double)d->m_Count), (unsigned long long)d->m_First);
+    }
+}
+
+static double seconds_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*******************************************************************************
+* Function Name: trace_gen
+********************************************************************************
+* Summary:
+* Records the loop of a target on the averaged buck model: the kernel of the
+* code example, a load step every 10 ms, an update of K at half of the trace
+* and an overvoltage fault with a restart at three quarters.
+*
+* Parameters:
+*  const char*           path Trace file
+*  double                duration Trace length in s
+*  const TRACE_DESIGN_t* d Target
+*  uint32_t              decimation Control periods per recorded sample
+*
+* Return:
+*  int Exit code
+*
+*******************************************************************************/
+static int trace_gen(const char* path, double duration, const TRACE_DESIGN_t* d, uint32_t decimation)
+{
+    XMC_TRACE_HEADER_t header;
+    float tuned[XMC_CMD_PARAM_COUNT];
+    uint64_t samples = (uint64_t)(duration * d->m_Fs);
+    uint64_t stepSamples = (uint64_t)(SIM_STEP_TIME * d->m_Fs);
+    uint64_t faultStart = (samples * 3U) / 4U;
+    uint64_t faultEnd = faultStart + (uint64_t)(GEN_FAULT_TIME * d->m_Fs);
+    uint64_t n;
+    uint32_t noise = 1U;
+    uint32_t duty;
+    uint32_t adc;
+    double dt = 1.0 / (d->m_Fs * SIM_SUBSTEPS);
+    double iL = 0.0;
+    double vC = 0.0;
+    double vOut = 0.0;
+    double rl;
+    double frac;
+    double vl;
+    double t0;
+    int32_t a;
+    int k;
+
+    memset(&header, 0, sizeof(header));
+    header.m_Kit        = d->m_Kit;
+    header.m_Backend    = d->m_Backend;
+    header.m_AwMode     = XMC_3P3Z_AW_CLAMP;
+    header.m_PeriodNs   = (uint32_t)(1e9 / d->m_Fs + 0.5);
+    header.m_Decimation = decimation;
+    memcpy(header.m_Param, d->m_Param, sizeof(header.m_Param));
+    memcpy(tuned, d->m_Param, sizeof(tuned));
+    tuned[XMC_CMD_PARAM_K] *= GEN_TUNE_K;
+
+    kernels_init(&header);
+    if (!XMC_TRACE_WriterOpen(&writer, path, &header, GEN_SYNC_INTERVAL))
+    {
+        perror(path);
+        return 1;
+    }
+
+    t0 = seconds_now();
+    for (n = 0U; n < samples; n++)
+    {
+        /* ADC sample with noise */
+        noise = noise * 1103515245U + 12345U;
+        a = (int32_t)lround(vOut * d->m_AdcGain) + (int32_t)((noise >> 16) % (2 * SIM_NOISE + 1)) - SIM_NOISE;
+        adc = (a < 0) ? 0U : ((a > 4095) ? 4095U : (uint32_t)a);
+
+        if (n == (samples / 2U))
+        {
+            kernels_update(tuned);
+        }
+        if (n == faultEnd)
+        {
+            kernels_preset(0);
+        }
+
+        if ((n >= faultStart) && (n < faultEnd))
+        {
+            duty = 0U;
+        }
+        else
+        {
+            duty = kernel_native_run(d->m_Backend, adc);
+        }
+
+        XMC_TRACE_WriterSample(&writer, adc, duty);
+        if (n == (samples / 2U))
+        {
+            XMC_TRACE_WriterEvent(&writer, XMC_TRACE_EV_TUNE, 1);
+            XMC_TRACE_WriterParam(&writer, tuned);
+        }
+        if (n == faultStart)
+        {
+            XMC_TRACE_WriterEvent(&writer, XMC_TRACE_EV_FAULT, XMC_PROT_FAULT_OV);
+        }
+        if (n == faultEnd)
+        {
+            XMC_TRACE_WriterEvent(&writer, XMC_TRACE_EV_RESTART, 0);
+        }
+
+        /* Averaged buck converter over one period, as in xmc_comp_bench.c */
+        rl   = SIM_VOUT / ((((n / stepSamples) & 1U) != 0U) ? SIM_ILOAD_HIGH : SIM_ILOAD_LOW);
+        frac = (double)duty / d->m_Period;
+        for (k = 0; k < SIM_SUBSTEPS; k++)
+        {
+            vOut = (vC + SIM_ESR * iL) / (1.0 + SIM_ESR / rl);
+            vl   = frac * SIM_VIN - vOut - SIM_DCR * iL;
+            iL  += vl / SIM_L * dt;
+            if (iL < 0.0)
+            {
+                iL = 0.0;
+            }
+            vC  += (iL - vOut / rl) / SIM_C * dt;
+        }
+    }
+
+    if (!XMC_TRACE_WriterClose(&writer))
+    {
+        perror(path);
+        return 1;
+    }
+    t0 = seconds_now() - t0;
+
+    printf("%s: XMC%u, %llu periods of %u ns, decimation %u\n", path, (unsigned)d->m_Kit,
+           (unsigned long long)samples, (unsigned)header.m_PeriodNs, (unsigned)decimation);
+    printf("%llu bytes, %.2f bytes per sample, %.1f Msamples/s\n",
+           (unsigned long long)writer.m_Bytes,
+           (double)(writer.m_Bytes - XMC_TRACE_HEADER_SIZE) / (double)writer.m_Trace.m_Samples,
+           (double)samples / t0 * 1e-6);
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: header_print
+********************************************************************************
+* Summary:
+* Prints the header of a trace.
+*
+* Parameters:
+*  const XMC_TRACE_FILE_t* f Trace file
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void header_print(const XMC_TRACE_FILE_t* f)
+{
+    const XMC_TRACE_HEADER_t* h = &f->m_Header;
+    int i;
+
+    printf("target    XMC%u, backend %s, period %u ns, decimation %u\n", (unsigned)h->m_Kit,
+           (h->m_Backend < BACKEND_COUNT) ? backendNames[h->m_Backend] : "?",
+           (unsigned)h->m_PeriodNs, (unsigned)h->m_Decimation);
+    printf("features %s%s%s%s%s\n",
+           (h->m_Flags & XMC_TRACE_FLAG_CURRENT_MODE) ? " current-mode" : "",
+           (h->m_Flags & XMC_TRACE_FLAG_PREDICTOR) ? " predictor" : "",
+           (h->m_Flags & XMC_TRACE_FLAG_FEEDFORWARD) ? " feedforward" : "",
+           (h->m_Flags & XMC_TRACE_FLAG_BURST) ? " burst" : "",
+           (h->m_Flags & XMC_TRACE_FLAG_PROTECTION) ? " protection" : "");
+    printf("params   ");
+    for (i = 0; i < (int)XMC_CMD_PARAM_COUNT; i++)
+    {
+        printf(" %.9g", h->m_Param[i]);
+    }
+    printf("\n");
+}
+
+/*******************************************************************************
+* Function Name: trace_info
+********************************************************************************
+* Summary:
+* Decodes a whole trace and prints its content and the decoding speed.
+*
+* Parameters:
+*  const char* path Trace file
+*
+* Return:
+*  int Exit code
+*
+*******************************************************************************/
+static int trace_info(const char* path)
+{
+    XMC_TRACE_FILE_t f;
+    XMC_TRACE_RECORD_t rec;
+    XMC_TRACE_REC_t kind;
+    uint64_t samples = 0U;
+    uint64_t syncs = 0U;
+    uint64_t gaps = 0U;
+    uint64_t params = 0U;
+    uint64_t events[8] = { 0U };
+    uint64_t first = 0U;
+    uint64_t last = 0U;
+    double t0;
+    int i;
+
+    if (!XMC_TRACE_FileOpen(&f, path))
+    {
+        fprintf(stderr, "%s: not a trace\n", path);
+        return 1;
+    }
+    header_print(&f);
+
+    t0 = seconds_now();
+    while ((kind = XMC_TRACE_Decode(&f.m_Decoder, &rec)) != XMC_TRACE_REC_END)
+    {
+        if (kind == XMC_TRACE_REC_SAMPLE)
+        {
+            if (samples == 0U)
+            {
+                first = rec.m_Time;
+            }
+            else if (rec.m_Sync && (rec.m_Time != (last + f.m_Header.m_Decimation)))
+            {
+                gaps++;
+            }
+            syncs += rec.m_Sync ? 1U : 0U;
+            last   = rec.m_Time;
+            samples++;
+        }
+        else if (kind == XMC_TRACE_REC_EVENT)
+        {
+            events[(rec.m_Event < 7U) ? rec.m_Event : 0U]++;
+        }
+        else
+        {
+            params++;
+        }
+    }
+    t0 = seconds_now() - t0;
+
+    printf("size      %llu bytes, %.2f bytes per sample\n", (unsigned long long)f.m_Size,
+           (samples != 0U) ? (double)(f.m_Size - XMC_TRACE_HEADER_SIZE) / (double)samples : 0.0);
+    printf("samples   %llu, periods %llu to %llu (%.3f s), %llu syncs, %llu gaps\n",
+           (unsigned long long)samples, (unsigned long long)first, (unsigned long long)last,
+           (double)(last - first) * f.m_Header.m_PeriodNs * 1e-9,
+           (unsigned long long)syncs, (unsigned long long)gaps);
+    printf("events   ");
+    for (i = 1; i < 7; i++)
+    {
+        printf(" %s %llu", eventNames[i], (unsigned long long)events[i]);
+    }
+    printf(", parameter sets %llu\n", (unsigned long long)params);
+    printf("skipped   %llu bytes, %u invalid records\n",
+           (unsigned long long)f.m_Decoder.m_Skipped, (unsigned)f.m_Decoder.m_Errors);
+    printf("decoded   in %.3f s, %.0f MB/s, %.1f Msamples/s\n", t0,
+           (double)f.m_Size / t0 * 1e-6, (double)samples / t0 * 1e-6);
+
+    XMC_TRACE_FileClose(&f);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: trace_dump
+********************************************************************************
+* Summary:
+* Prints records as text, from the first sync at or after a byte position of
+* the stream.
+*
+* Parameters:
+*  const char* path Trace file
+*  size_t      pos Byte position in the stream
+*  uint64_t    count Records to print
+*
+* Return:
+*  int Exit code
+*
+*******************************************************************************/
+static int trace_dump(const char* path, size_t pos, uint64_t count)
+{
+    XMC_TRACE_FILE_t f;
+    XMC_TRACE_RECORD_t rec;
+    XMC_TRACE_REC_t kind;
+    int i;
+
+    if (!XMC_TRACE_FileOpen(&f, path))
+    {
+        fprintf(stderr, "%s: not a trace\n", path);
+        return 1;
+    }
+
+    XMC_TRACE_DecoderSeek(&f.m_Decoder, pos);
+    while ((count-- != 0U) && ((kind = XMC_TRACE_Decode(&f.m_Decoder, &rec)) != XMC_TRACE_REC_END))
+    {
+        if (kind == XMC_TRACE_REC_SAMPLE)
+        {
+            printf("%12llu %s adc %4u duty %u\n", (unsigned long long)rec.m_Time,
+                   rec.m_Sync ? "sync  " : "sample", (unsigned)rec.m_Adc, (unsigned)rec.m_Duty);
+        }
+        else if (kind == XMC_TRACE_REC_EVENT)
+        {
+            printf("%12llu event  %s %d\n", (unsigned long long)rec.m_Time,
+                   eventNames[(rec.m_Event < 7U) ? rec.m_Event : 0U], (int)rec.m_Value);
+        }
+        else
+        {
+            printf("%12llu params", (unsigned long long)rec.m_Time);
+            for (i = 0; i < (int)XMC_CMD_PARAM_COUNT; i++)
+            {
+                printf(" %.9g", rec.m_Param[i]);
+            }
+            printf("\n");
+        }
+    }
+
+    XMC_TRACE_FileClose(&f);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: trace_replay
+********************************************************************************
+* Summary:
+* Replays a trace through the four kernels. The replay is exact, and compared
+* with the recorded duty, from period 0 up to the first lost data; after a gap
+* the kernels are preset with the recorded duty and compared with the kernel
+* of the recording target only. Traces with features between the compensator
+* and the PWM are compared between kernels only.
+*
+* Parameters:
+*  const char* path Trace file
+*
+* Return:
+*  int Exit code, 1 if the recording kernel does not match the recorded duty
+*
+*******************************************************************************/
+static int trace_replay(const char* path)
+{
+    XMC_TRACE_FILE_t f;
+    XMC_TRACE_RECORD_t rec;
+    XMC_TRACE_RECORD_t cur;
+    XMC_TRACE_REC_t kind;
+    REPLAY_EVENTS_t ev;
+    REPLAY_DIFF_t vsRec[BACKEND_COUNT];
+    REPLAY_DIFF_t vsNative[BACKEND_COUNT];
+    uint32_t out[BACKEND_COUNT];
+    uint64_t samples = 0U;
+    uint64_t segments = 0U;
+    uint64_t lastTime = 0U;
+    bool have = false;
+    bool done = false;
+    bool exact = false;
+    bool faulted = false;
+    bool frozen = false;
+    bool paramNow = false;
+    bool comparable;
+    bool run;
+    int native;
+    int b;
+    double t0;
+
+    if (!XMC_TRACE_FileOpen(&f, path))
+    {
+        fprintf(stderr, "%s: not a trace\n", path);
+        return 1;
+    }
+    header_print(&f);
+    native = f.m_Header.m_Backend;
+    if ((f.m_Header.m_Decimation != 1U) || (native >= BACKEND_COUNT))
+    {
+        fprintf(stderr, "only traces of every period (decimation 1) of a known backend can be replayed\n");
+        XMC_TRACE_FileClose(&f);
+        return 1;
+    }
+    comparable = ((f.m_Header.m_Flags & XMC_TRACE_FLAG_NOT_REPLAYABLE) == 0U);
+
+    kernels_init(&f.m_Header);
+    memset(vsRec, 0, sizeof(vsRec));
+    memset(vsNative, 0, sizeof(vsNative));
+    memset(&ev, 0, sizeof(ev));
+    memset(&cur, 0, sizeof(cur));
+
+    t0 = seconds_now();
+    while (!done)
+    {
+        kind = XMC_TRACE_Decode(&f.m_Decoder, &rec);
+
+        /* Events of the period of the current sample are collected first */
+        if ((kind == XMC_TRACE_REC_EVENT) && have && (rec.m_Time == cur.m_Time))
+        {
+            switch (rec.m_Event)
+            {
+                case XMC_TRACE_EV_FAULT:
+                    ev.m_Fault      = true;
+                    ev.m_FaultCause = rec.m_Value;
+                    break;
+                case XMC_TRACE_EV_RESTART:
+                    ev.m_Restart     = true;
+                    ev.m_RestartDuty = rec.m_Value;
+                    break;
+                case XMC_TRACE_EV_BURST_ENTER:
+                    ev.m_BurstEnter = true;
+                    break;
+                case XMC_TRACE_EV_BURST_EXIT:
+                    ev.m_BurstExit  = true;
+                    ev.m_ResumeDuty = rec.m_Value;
+                    break;
+                case XMC_TRACE_EV_TUNE:
+                    ev.m_Tune = true;
+                    break;
+                default:
+                    break;
+            }
+            continue;
+        }
+        if (kind == XMC_TRACE_REC_EVENT)
+        {
+            /* In a gap: only the state is followed */
+            faulted  = (rec.m_Event == XMC_TRACE_EV_FAULT) ? true :
+                       ((rec.m_Event == XMC_TRACE_EV_RESTART) ? false : faulted);
+            frozen   = (rec.m_Event == XMC_TRACE_EV_BURST_ENTER) ? true :
+                       ((rec.m_Event == XMC_TRACE_EV_BURST_EXIT) ? false : frozen);
+            paramNow = paramNow || (rec.m_Event == XMC_TRACE_EV_TUNE);
+            continue;
+        }
+        if (kind == XMC_TRACE_REC_PARAM)
+        {
+            if (ev.m_Tune && !ev.m_HaveParam)
+            {
+                memcpy(ev.m_Param, rec.m_Param, sizeof(ev.m_Param));
+                ev.m_HaveParam = true;
+            }
+            else if (paramNow)
+            {
+                kernels_update(rec.m_Param);
+                paramNow = false;
+            }
+            continue;
+        }
+
+        /* A new sample or the end: the current sample is replayed */
+        if (have)
+        {
+            if (cur.m_Sync && ((samples == 0U) || (cur.m_Time != (lastTime + 1U))))
+            {
+                /* Exact from the first period only, the kernels are in the init state */
+                exact = (samples == 0U) && (cur.m_Time == 0U);
+                segments++;
+            }
+
+            if (ev.m_Tune && ev.m_HaveParam)
+            {
+                kernels_update(ev.m_Param);
+            }
+            if (ev.m_Restart)
+            {
+                kernels_preset(ev.m_RestartDuty);
+                faulted = false;
+            }
+            if (ev.m_BurstExit)
+            {
+                kernels_preset(ev.m_ResumeDuty);
+                frozen = false;
+            }
+
+            run = !faulted && !frozen &&
+                  (!ev.m_Fault || (ev.m_FaultCause == (int32_t)XMC_PROT_FAULT_DUTY));
+            if (run)
+            {
+                kernels_run(cur.m_Adc, out);
+                if ((segments != 0U) && !exact && (cur.m_Time != (lastTime + 1U)))
+                {
+                    /* First sample after a gap, the state is unknown */
+                    kernels_preset((int32_t)cur.m_Duty);
+                }
+                else
+                {
+                    for (b = 0; b < BACKEND_COUNT; b++)
+                    {
+                        diff_add(&vsNative[b], out[b], out[native], cur.m_Time);
+                        if (exact && comparable && !ev.m_Fault)
+                        {
+                            diff_add(&vsRec[b], out[b], cur.m_Duty, cur.m_Time);
+                        }
+                    }
+                }
+            }
+            faulted = faulted || ev.m_Fault;
+            frozen  = frozen || ev.m_BurstEnter;
+
+            lastTime = cur.m_Time;
+            samples++;
+            memset(&ev, 0, sizeof(ev));
+        }
+
+        if (kind == XMC_TRACE_REC_END)
+        {
+            done = true;
+        }
+        cur  = rec;
+        have = true;
+    }
+    t0 = seconds_now() - t0;
+
+    printf("replayed  %llu samples in %llu segments, %.3f s, %.1f Msamples/s through %d kernels\n",
+           (unsigned long long)samples, (unsigned long long)segments, t0,
+           (double)samples / t0 * 1e-6, BACKEND_COUNT);
+    if (!comparable)
+    {
+        printf("the recorded duty is not the compensator output, kernels compared only\n");
+    }
+    printf("\n%-10s  %-39s  %s\n", "", "vs recorded duty (exact segment)",
+           "vs recording kernel");
+    printf("%-10s  %10s %7s %9s %10s  %10s %7s %9s %10s\n", "backend",
+           "mismatch", "max", "rms", "first", "mismatch", "max", "rms", "first");
+    for (b = 0; b < BACKEND_COUNT; b++)
+    {
+        printf("%-8s%s", backendNames[b], (b == native) ? " *" : "  ");
+        diff_print(&vsRec[b]);
+        diff_print(&vsNative[b]);
+        printf("\n");
+    }
+    printf("compared  %llu samples with the recorded duty, %llu between kernels\n",
+           (unsigned long long)vsRec[native].m_Count, (unsigned long long)vsNative[native].m_Count);
+
+    XMC_TRACE_FileClose(&f);
+    return (vsRec[native].m_Mismatch != 0U) ? 1 : 0;
+}
+
+/*******************************************************************************
+* Function Name: usage
+********************************************************************************
+* Summary:
+* Prints the command line help.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int Exit code
+*
+*******************************************************************************/
+static int usage(void)
+{
+    fprintf(stderr,
+            "usage: xmc_trace gen <file> <seconds> [xmc1|xmc4] [decimation]\n"
+            "       xmc_trace info <file>\n"
+            "       xmc_trace dump <file> [byte offset] [records]\n"
+            "       xmc_trace replay <file>\n");
+    return 2;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the command given on the command line.
+*
+* Parameters:
+*  int    argc Argument count
+*  char** argv Arguments
+*
+* Return:
+*  int Exit code
+*
+*******************************************************************************/
+int main(int argc, char** argv)
+{
+    const TRACE_DESIGN_t* d = &designs[0];
+    uint32_t decimation = 1U;
+
+    if (argc < 3)
+    {
+        return usage();
+    }
+
+    if ((strcmp(argv[1], "gen") == 0) && (argc >= 4))
+    {
+        if ((argc >= 5) && (strcmp(argv[4], "xmc4") == 0))
+        {
+            d = &designs[1];
+        }
+        if (argc >= 6)
+        {
+            decimation = (uint32_t)strtoul(argv[5], NULL, 0);
+        }
+        if (decimation == 0U)
+        {
+            return usage();
+        }
+        return trace_gen(argv[2], atof(argv[3]), d, decimation);
+    }
+    if (strcmp(argv[1], "info") == 0)
+    {
+        return trace_info(argv[2]);
+    }
+    if (strcmp(argv[1], "dump") == 0)
+    {
+        return trace_dump(argv[2], (argc >= 4) ? (size_t)strtoull(argv[3], NULL, 0) : 0U,
+                          (argc >= 5) ? strtoull(argv[4], NULL, 0) : 50U);
+    }
+    if (strcmp(argv[1], "replay") == 0)
+    {
+        return trace_replay(argv[2]);
+    }
+
+    return usage();
+}
@@ -0,0 +1,324 @@
+/******************************************************************************
+* File Name:   xmc_trace_file.h
+*
+* Description: Host side trace files of xmc_trace.h. The reader maps the
+*              whole file, so a multi-GB trace is decoded in place with the
+*              page cache doing the I/O, and a position can be seeked to
+*              directly. The writer records with the same encoder as the
+*              target, through a ring buffer flushed to a stdio stream.
+*              Used by xmc_trace.c and xmc_cmd_client.c; the includer defines
+*              _FILE_OFFSET_BITS 64 and __STATIC_INLINE.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XMC_TRACE_FILE_H
+#define XMC_TRACE_FILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "xmc_trace.h"
+
+/******************************************************************************
+ * MACROS
+ *****************************************************************************/
+#define XMC_TRACE_WRITER_RING       (65536U)
+
+/******************************************************************************
+ * DATA STRUCTURES
+ *****************************************************************************/
+
+/**
+ * Structure defining a mapped trace file and its decoder
+ */
+typedef struct XMC_TRACE_FILE
+{
+  int                 m_Fd;
+  const uint8_t*      m_pMap;
+  size_t              m_Size;
+  XMC_TRACE_HEADER_t  m_Header;
+  XMC_TRACE_DECODER_t m_Decoder;  /**< Over the stream after the header */
+} XMC_TRACE_FILE_t;
+
+/**
+ * Structure defining a trace file being written
+ */
+typedef struct XMC_TRACE_WRITER
+{
+  FILE*               m_File;
+  XMC_TRACE_t         m_Trace;
+  uint8_t             m_Ring[XMC_TRACE_WRITER_RING];
+  uint8_t             m_Chunk[XMC_TRACE_WRITER_RING / 2U];
+  uint64_t            m_Bytes;      /**< Bytes written, header included */
+  bool                m_Error;
+} XMC_TRACE_WRITER_t;
+
+/******************************************************************************
+ * API Prototypes
+ *****************************************************************************/
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_FileOpen
+********************************************************************************
+* Summary:
+* This API maps a trace file, reads the header and sets the decoder to the
+* start of the stream.
+*
+* Parameters:
+* XMC_TRACE_FILE_t* [out] ptr Pointer to the file structure
+* const char*       [in]  path File name
+*
+* Return:
+*  bool false if the file cannot be mapped or is not a trace
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_FileOpen(XMC_TRACE_FILE_t* ptr, const char* path)
+{
+  struct stat st;
+  void* pMap;
+
+  memset(ptr, 0, sizeof(*ptr));
+  ptr->m_Fd = open(path, O_RDONLY);
+  if (ptr->m_Fd < 0)
+  {
+    return false;
+  }
+  if ((fstat(ptr->m_Fd, &st) != 0) || (st.st_size < (off_t)XMC_TRACE_HEADER_SIZE))
+  {
+    close(ptr->m_Fd);
+    return false;
+  }
+
+  pMap = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, ptr->m_Fd, 0);
+  if (pMap == MAP_FAILED)
+  {
+    close(ptr->m_Fd);
+    return false;
+  }
+  (void)madvise(pMap, (size_t)st.st_size, MADV_SEQUENTIAL);
+  ptr->m_pMap = pMap;
+  ptr->m_Size = (size_t)st.st_size;
+
+  if (!XMC_TRACE_GetHeader(ptr->m_pMap, &ptr->m_Header))
+  {
+    (void)munmap(pMap, ptr->m_Size);
+    close(ptr->m_Fd);
+    return false;
+  }
+  XMC_TRACE_DecoderInit(&ptr->m_Decoder,
+                        ptr->m_pMap + XMC_TRACE_HEADER_SIZE,
+                        ptr->m_Size - XMC_TRACE_HEADER_SIZE,
+                        ptr->m_Header.m_Decimation);
+
+  return true;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_FileClose
+********************************************************************************
+* Summary:
+* This API unmaps and closes a trace file.
+*
+* Parameters:
+* XMC_TRACE_FILE_t* [in/out] ptr Pointer to the file structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_FileClose(XMC_TRACE_FILE_t* ptr)
+{
+  (void)munmap((void*)ptr->m_pMap, ptr->m_Size);
+  close(ptr->m_Fd);
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_WriterOpen
+********************************************************************************
+* Summary:
+* This API creates a trace file and writes the header.
+*
+* Parameters:
+* XMC_TRACE_WRITER_t*       [out] ptr Pointer to the writer structure
+* const char*               [in]  path File name
+* const XMC_TRACE_HEADER_t* [in]  pHeader Loop description
+* uint32_t                  [in]  syncInterval Samples between syncs
+*
+* Return:
+*  bool false if the file cannot be created
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_WriterOpen(XMC_TRACE_WRITER_t* ptr,
+                                          const char* path,
+                                          const XMC_TRACE_HEADER_t* pHeader,
+                                          uint32_t syncInterval)
+{
+  uint8_t header[XMC_TRACE_HEADER_SIZE];
+
+  ptr->m_File  = fopen(path, "wb");
+  ptr->m_Bytes = XMC_TRACE_HEADER_SIZE;
+  ptr->m_Error = (ptr->m_File == NULL);
+  if (ptr->m_Error)
+  {
+    return false;
+  }
+
+  XMC_TRACE_Init(&ptr->m_Trace, ptr->m_Ring, XMC_TRACE_WRITER_RING, pHeader, syncInterval);
+  XMC_TRACE_PutHeader(header, pHeader);
+  ptr->m_Error = (fwrite(header, 1U, sizeof(header), ptr->m_File) != sizeof(header));
+
+  return !ptr->m_Error;
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_WriterFlush
+********************************************************************************
+* Summary:
+* This function moves the recorded bytes from the ring buffer to the file. It
+* is called when the ring is half full, so no record is ever lost.
+*
+* Parameters:
+* XMC_TRACE_WRITER_t* [in/out] ptr Pointer to the writer structure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_WriterFlush(XMC_TRACE_WRITER_t* ptr)
+{
+  uint32_t len;
+
+  while ((len = XMC_TRACE_Read(&ptr->m_Trace, ptr->m_Chunk, sizeof(ptr->m_Chunk))) != 0U)
+  {
+    if (fwrite(ptr->m_Chunk, 1U, len, ptr->m_File) != len)
+    {
+      ptr->m_Error = true;
+    }
+    ptr->m_Bytes += len;
+  }
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_WriterSample
+********************************************************************************
+* Summary:
+* This function records one control period, as XMC_TRACE_Sample.
+*
+* Parameters:
+* XMC_TRACE_WRITER_t* [in/out] ptr Pointer to the writer structure
+* uint32_t            [in]  adc ADC sample of the period
+* uint32_t            [in]  duty Duty written in the period
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_WriterSample(XMC_TRACE_WRITER_t* ptr, uint32_t adc, uint32_t duty)
+{
+  XMC_TRACE_Sample(&ptr->m_Trace, adc, duty);
+  if ((ptr->m_Trace.m_Head - ptr->m_Trace.m_Tail) >= (XMC_TRACE_WRITER_RING / 2U))
+  {
+    XMC_TRACE_WriterFlush(ptr);
+  }
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_WriterEvent
+********************************************************************************
+* Summary:
+* This function records an event of the current control period, as
+* XMC_TRACE_Event.
+*
+* Parameters:
+* XMC_TRACE_WRITER_t* [in/out] ptr Pointer to the writer structure
+* XMC_TRACE_EVENT_t   [in]  id Event
+* int32_t             [in]  value Value of the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_WriterEvent(XMC_TRACE_WRITER_t* ptr, XMC_TRACE_EVENT_t id, int32_t value)
+{
+  XMC_TRACE_Event(&ptr->m_Trace, id, value);
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_WriterParam
+********************************************************************************
+* Summary:
+* This function records a parameter set, as XMC_TRACE_Param.
+*
+* Parameters:
+* XMC_TRACE_WRITER_t* [in/out] ptr Pointer to the writer structure
+* const float*        [in]  pParam XMC_CMD_PARAM_COUNT parameters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void XMC_TRACE_WriterParam(XMC_TRACE_WRITER_t* ptr, const float* pParam)
+{
+  XMC_TRACE_Param(&ptr->m_Trace, pParam);
+}
+
+/*******************************************************************************
+* Function Name: XMC_TRACE_WriterClose
+********************************************************************************
+* Summary:
+* This API writes the rest of the ring buffer and closes the file.
+*
+* Parameters:
+* XMC_TRACE_WRITER_t* [in/out] ptr Pointer to the writer structure
+*
+* Return:
+*  bool false if a write failed
+*
+*******************************************************************************/
+__STATIC_INLINE bool XMC_TRACE_WriterClose(XMC_TRACE_WRITER_t* ptr)
+{
+  XMC_TRACE_WriterFlush(ptr);
+  if (fclose(ptr->m_File) != 0)
+  {
+    ptr->m_Error = true;
+  }
+
+  return !ptr->m_Error;
+}
+
+#endif /* #ifndef XMC_TRACE_FILE_H */